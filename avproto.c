@@ -1,5 +1,5 @@
 #define	__MODULE__	"AVPROTO"
-#define	__IDENT__	"X.94-07"
+#define	__IDENT__	"X.94-08"
 
 
 /*
@@ -75,6 +75,9 @@
 **
 **	29-JUL-2019	RRL	X.94-07 : Redeclared avproto_dump();
 **
+**	19-OCT-2026	RRL	X.94-08 : Fixed PDU's length adjusting for the TAG$K_UUID with short or omitted 'valsz' in the avproto_put();
+**				UUID is dumped in the text form by the __util$uuid2str().
+**
 **
 **
 **--
@@ -187,10 +190,10 @@ AVPROTO_PDU	*pdu = (AVPROTO_PDU *) pdup;
 			}
 
 		case	TAG$K_UUID:	/* 16 octets  */
-			memset(ptlv->b_val, 0, 16);
+			memset(ptlv->b_val, 0, UTIL$K_UUIDSZ);
 
-			memcpy(ptlv->b_val, val, len = $MIN(valsz, 16));
-			ptlv->w_len = htobe16( 16 );
+			memcpy(ptlv->b_val, val, valsz ? $MIN(valsz, UTIL$K_UUIDSZ) : UTIL$K_UUIDSZ);
+			ptlv->w_len = htobe16( len = UTIL$K_UUIDSZ );
 
 			break;
 
@@ -303,8 +306,8 @@ AVPROTO_PDU	*pdu = (AVPROTO_PDU *) pdup;
 			break;
 
 		case	TAG$K_UUID:	/* 16 octets  */
-			len = 16;
-			w_len = $MIN(w_len, 16);
+			len = UTIL$K_UUIDSZ;
+			w_len = $MIN(w_len, UTIL$K_UUIDSZ);
 			__util$movc5 (&w_len, ptlv->b_val,  0, (unsigned short *)  &len, val);
 
 			break;
@@ -431,7 +434,10 @@ unsigned short w_len, w_tag, v_type, v_tag;
 		w_tag = avproto_decode_tag (ptlv->w_tag, &v_type, &v_tag);
 
 		__util$bin2hex (ptlv, hexbuf1, sizeof(AVPROTO_TLV));
-		__util$bin2hex (ptlv->b_val, hexbuf2, $MIN(w_len, sizeof(hexbuf2)/2) );
+
+		if ( (v_type == TAG$K_UUID) && (w_len == UTIL$K_UUIDSZ) )
+			__util$uuid2str (ptlv->b_val, hexbuf2, sizeof(hexbuf2));
+		else	__util$bin2hex (ptlv->b_val, hexbuf2, $MIN(w_len, (sizeof(hexbuf2) - 1)/2) );
 		$LOG(STS$K_INFO, "[%04.4d] TLV [tag=%04x(id=%04x, type=%04x), len=%02d] 0x%s:0x%s",
 		     count, w_tag, v_tag, v_type, w_len, hexbuf1, hexbuf2);
 
@@ -947,9 +953,9 @@ char	buf[512];
 
 	/* Convert test data to the binary form */
 #if 1
-	status =  uuid_parse( "1d75bd4a-0dbf-4d4d-9d5e-e24b29fdf1f7" , cuu);
-	status =  uuid_parse( "c245486d-de9c-4abc-bdb1-e07f917e5ad8" , dk[0].disk_id);
-	status =  uuid_parse( "368b1e4c-eff9-48d5-a085-0da2013f40ad" , dk[1].disk_id);
+	status =  __util$uuid_parse( "1d75bd4a-0dbf-4d4d-9d5e-e24b29fdf1f7", UTIL$K_UUIDSTRLEN, cuu);
+	status =  __util$uuid_parse( "c245486d-de9c-4abc-bdb1-e07f917e5ad8", UTIL$K_UUIDSTRLEN, dk[0].disk_id);
+	status =  __util$uuid_parse( "368b1e4c-eff9-48d5-a085-0da2013f40ad", UTIL$K_UUIDSTRLEN, dk[1].disk_id);
 
 	inet_pton(AF_INET, "172.28.5.30", &rsock.sin_addr);
 #endif
@@ -1,5 +1,5 @@
 #define	__MODULE__	"CLI_ROUTINES"
-#define	__IDENT__	"X.00-01"
+#define	__IDENT__	"X.00-05"
 
 #ifdef	__GNUC__
 	#ident			__IDENT__
@@ -49,6 +49,15 @@
 **
 **	28-JUL-2021	RRL	Project reanimation.
 **
+**	19-OCT-2026	RRL	Values of the parameters and qualifiers are kept as views of the argv[] strings,
+**				so they are not copied and not truncated at 255 characters; added cli$get_view().
+**
+**	19-OCT-2026	RRL	CLI-context and items are allocated from the single arena instead of calloc() per item.
+**
+**	19-OCT-2026	RRL	CLI$K_UUID values are checked by the __util$uuid_parse() instead of sscanf().
+**
+**	19-OCT-2026	RRL	Verbs, qualifiers and keywords are matched by the __util$*_blind() instead of strncasecmp().
+**
 **--
 */
 
@@ -68,6 +77,8 @@
 #include	"utility_routines.h"
 #include	"cli_routines.h"
 
+#define	CLI$K_ARENA_BLKSZ	512			/* A size of block for the CLI-context and items	*/
+
 #define $SHOW_PARM(name, value, format)	$IFTRACE(q_trace, ": " #name " = " format, (value))
 #define $SHOW_PTR(var)			$SHOW_PARM(var, var, "%p")
 #define $SHOW_STR(var)			$SHOW_PARM(var, (var ? var : "UNDEF(NULL)"), "'%s'")
@@ -172,8 +183,9 @@ char	buf[NAME_MAX], *cp;
 
 		case	CLI$K_UUID:
 			{
-			if ( 6 != (status = sscanf ($ASCPTR(val), "%08x-%04x-%04x-%04x-%012x",
-						   &status, &status, &status, &status, &status)) )
+			UTIL_UUID uuid;
+
+			if ( !(1 & __util$uuid_parse($ASCPTR(val), $ASCLEN(val), uuid)) )
 				return	(clictx->opts & CLI$M_OPSIGNAL)
 					? $LOG(STS$K_ERROR, "Illformat UUID value '%.*s'", $ASC(val))
 					: STS$K_ERROR;
@@ -203,16 +215,18 @@ static	int	cli$add_item2ctx	(
 CLI_ITEM	*avp, *avp2;
 
 	/* Allocate memory for new CLI's param/qual value entry */
-	if ( !(avp = calloc(1, sizeof(CLI_ITEM))) )
+	if ( !(avp = __util$arena_alloc(clictx->arena, sizeof(CLI_ITEM))) )
 		{
 		return	(clictx->opts & CLI$M_OPSIGNAL)
 			? $LOG(STS$K_ERROR, "Insufficient memory, errno=%d", errno)
 			: STS$K_ERROR;
 		}
 
-	/* Store a given item: parameter or qualifier into the context */
+	memset(avp, 0, sizeof(CLI_ITEM));
+
+	/* Store a given item: parameter or qualifier into the context, the value is not copied */
 	if ( val )
-		__util$str2asc (val, &avp->val);
+		avp->val = __util$sv_str(val);
 
 	if ( !type )
 		{
@@ -309,13 +323,13 @@ int	splen = 0;
 
 	/* Run over command's verbs list ... */
 	for ( splen = 2, avp = clictx->vlist; avp; avp = avp->next, splen += 2)
-		$LOG(STS$K_INFO, "%.*s %.*s  ('%.*s')", splen, spaces, $ASC(&avp->verb->name), $ASC(&avp->val));
+		$LOG(STS$K_INFO, "%.*s %.*s  ('%.*s')", splen, spaces, $ASC(&avp->verb->name), $SV(&avp->val));
 
 	for ( avp = clictx->avlist; avp; avp = avp->next)
 		{
 		if ( avp->type )
-			$LOG(STS$K_INFO, "   P%d[0:%d]='%.*s'", avp->pqdesc->pn, $ASCLEN(&avp->val), $ASC(&avp->val));
-		else	$LOG(STS$K_INFO, "   /%.*s[0:%d]='%.*s'", $ASC(&avp->pqdesc->name), $ASCLEN(&avp->val), $ASC(&avp->val));
+			$LOG(STS$K_INFO, "   P%d[0:%d]='%.*s'", avp->pqdesc->pn, (int) $SVLEN(&avp->val), $SV(&avp->val));
+		else	$LOG(STS$K_INFO, "   /%.*s[0:%d]='%.*s'", $ASC(&avp->pqdesc->name), (int) $SVLEN(&avp->val), $SV(&avp->val));
 		}
 }
 
@@ -359,7 +373,7 @@ int	qlog = opts & CLI$M_OPTRACE;
 
 		$IFTRACE(qlog, "Match [0:%d]='%.*s' against '%.*s'", len, len, sts, $ASC(&krun->name) );
 
-		if ( !strncasecmp(sts, $ASCPTR(&krun->name), $MIN(len, $ASCLEN(&krun->name))) )
+		if ( __util$prefix_blind($ASCPTR(&krun->name), $ASCLEN(&krun->name), sts, len) )
 			{
 			if ( ksel )
 				{
@@ -434,7 +448,7 @@ char		*aptr, *vptr;
 
 //			$IFTRACE(qlog, "Match [0:%d]='%.*s' against '%.*s'", len, len, aptr, $ASC(&qrun->name) );
 
-			if ( !strncasecmp(aptr, $ASCPTR(&qrun->name), len) )
+			if ( __util$prefix_blind($ASCPTR(&qrun->name), $ASCLEN(&qrun->name), aptr, len) )
 				{
 				if ( qsel )
 					{
@@ -567,7 +581,7 @@ char		*pverb;
 		 * DEL will match: DELETE & DELIVERY
 		 *
 		 */
-		if ( !strncasecmp(pverb, $ASCPTR(&vrun->name), $MIN(len, $ASCLEN(&vrun->name))) )
+		if ( !__util$memcmp_blind(pverb, $ASCPTR(&vrun->name), $MIN(len, $ASCLEN(&vrun->name))) )
 			{
 			$IFTRACE(qlog, "Matched on length=%d '%.*s' := '%.*s' !", $MIN(len, $ASCLEN(&vrun->name)), len, pverb, $ASC(&vrun->name));
 
@@ -638,6 +652,7 @@ int	cli$parse	(
 {
 int	status, qlog = opts & CLI$M_OPTRACE;
 CLI_CTX	*ctx;
+UTIL_ARENA	l_arena = UTIL_ARENA_INIT;
 
 	$IFTRACE(qlog, "argc=%d, opts=%#x", argc, opts);
 
@@ -647,11 +662,21 @@ CLI_CTX	*ctx;
 	if ( argc < 1 )
 		return	(opts & CLI$M_OPSIGNAL) ? $LOG(STS$K_FATAL, "Too many arguments") : STS$K_FATAL;
 
-	/* Create CLI-context area */
-	if ( !(*clictx = calloc(1, sizeof(CLI_CTX))) )
+	/*
+	 * Create CLI-context area, the arena's descriptor is placed into the first block
+	 * just after the context, so whole context is released by the __util$arena_free()
+	 */
+	l_arena.blksz = CLI$K_ARENA_BLKSZ;
+
+	if ( !(ctx = __util$arena_alloc(&l_arena, sizeof(CLI_CTX) + sizeof(UTIL_ARENA))) )
 		return	(opts & CLI$M_OPSIGNAL) ? $LOG(STS$K_FATAL, "Cannot allocate memory, errno=%d", errno) : STS$K_FATAL;
-	ctx = *clictx;
+
+	memset(ctx, 0, sizeof(CLI_CTX));
 	ctx->opts = opts;
+	ctx->arena = (UTIL_ARENA *) (ctx + 1);
+	*ctx->arena = l_arena;					/* From now the descriptor in the context is used */
+
+	*clictx = ctx;
 
 
 	status = _cli$parse_verb(*clictx, verbs, argc, argv);
@@ -695,7 +720,7 @@ CLI_ITEM *item;
 			/* Do we need to return a qualifier value to caller ?*/
 			if ( val )
 				{
-				*val = item->val;
+				__util$sv2asc(&item->val, val);
 
 				if ( !($ASCLEN(val)) )
 					return	(clictx->opts & CLI$M_OPSIGNAL) ? $LOG(STS$K_WARN, "Zero length value") : STS$K_WARN;
@@ -710,6 +735,59 @@ CLI_ITEM *item;
 						       $ASC(&pq->name)) : STS$K_ERROR;
 }
 
+/*
+ *
+ *  DESCRIPTION: retreive a view of the value of the parameter or qualifier from the CLI-context
+ *	has been created and filled by cli$parse(), the value is not copied and not truncated,
+ *	it's valid while the argv[] is valid.
+ *
+ *  INPUT:
+ *	ctx:	A CLI-context has been created by cli$parse()
+ *	pq:	A pointer to parameter/qualifier definition
+ *
+ *  OUTPUT:
+ *	val:	A view of the value
+ *
+ *  RETURN:
+ *	STS$K_WARN	- value is zero length
+ *	SS$_NORMAL, condition status
+ *
+ */
+int	cli$get_view	(
+	CLI_CTX		*clictx,
+	CLI_PQDESC	*pq,
+		STRVIEW	*val
+			)
+{
+CLI_ITEM *item;
+
+	/* Sanity check */
+	if ( !clictx )
+		return	$LOG(STS$K_FATAL, "CLI-context is empty");
+
+	if ( !pq )
+		return	$LOG(STS$K_FATAL, "Illegal parameter/qualifier definition");
+
+	for ( item = clictx->avlist; item; item = item->next)
+		{
+		if ( pq  == item->pqdesc )
+			{
+			if ( val )
+				{
+				*val = item->val;
+
+				if ( !$SVLEN(val) )
+					return	(clictx->opts & CLI$M_OPSIGNAL) ? $LOG(STS$K_WARN, "Zero length value") : STS$K_WARN;
+				}
+
+			return	STS$K_SUCCESS;
+			}
+		}
+
+	return	(clictx->opts & CLI$M_OPSIGNAL) ? $LOG(STS$K_ERROR, "No parameter/qualifier ('%.*s') is present in command line",
+						       $ASC(&pq->name)) : STS$K_ERROR;
+}
+
 
 /*
  *
@@ -727,26 +805,14 @@ int	cli$cleanup	(
 		)
 {
 
-CLI_ITEM	*avp, *avp2;
+UTIL_ARENA	l_arena;
 
-	/* Run over verb's items list and free has been alocated memory ...*/
-	for (avp = clictx->vlist; avp; )
-		{
-		avp2 = avp;
-		avp = avp->next;
-		free(avp2);
-		}
-
-	/* Run over vlaue's items list and free has been alocated memory ...*/
-	for (avp = clictx->avlist; avp; )
-		{
-		avp2 = avp;
-		avp = avp->next;
-		free(avp2);
-		}
-
-	/* Release CLI-context area */
-	free(clictx);
+	/*
+	 * Release CLI-context area with the items, the arena's descriptor is in the context,
+	 * so we use a copy of it
+	 */
+	l_arena = *clictx->arena;
+	__util$arena_free(&l_arena);
 
 	return	STS$K_SUCCESS;
 }
@@ -31,6 +31,11 @@ extern "C" {
 **
 **  MODIFICATION HISTORY:
 **
+**	19-OCT-2026	RRL	A value of the CLI_ITEM is a view of the argv[] string instead of the ASC copy;
+**				added cli$get_view().
+**
+**	19-OCT-2026	RRL	CLI-context and items are allocated from the arena, see __util$arena_*().
+**
 **--
 */
 
@@ -76,6 +81,13 @@ typedef	struct __asc__	{
 } ASC;
 #endif
 
+#ifndef	__STRVIEW_TYPE__
+typedef	struct __util_strview__	{
+	const char	*ptr;
+	size_t		len;
+} STRVIEW;
+#endif
+
 
 
 typedef	struct __cli_keyword__	{
@@ -123,7 +135,7 @@ typedef	struct	__cli_item__{
 		CLI_PQDESC	*pqdesc;
 	};
 
-	ASC		val;	/* Value string			*/
+	STRVIEW		val;	/* Value string, refers to argv	*/
 
 } CLI_ITEM;
 
@@ -142,6 +154,8 @@ typedef struct __cli_ctx__
 
 	CLI_ITEM	*vlist,	/* A list of verbs' sequence for a command */
 			*avlist;/* A list of parameters' values and qualifiers */
+
+	struct __util_arena__ *arena;	/* The context and items are allocated from */
 } CLI_CTX;
 
 
@@ -154,6 +168,7 @@ int	cli$parse	(CLI_VERB *verbs, int opts, int	argc, char ** argv, void **clictx)
 int	cli$dispatch	(CLI_CTX *clictx);
 int	cli$cleanup	(CLI_CTX *clictx);
 int	cli$get_value	(CLI_CTX *clictx, CLI_PQDESC *pq, ASC *val);
+int	cli$get_view	(CLI_CTX *clictx, CLI_PQDESC *pq, STRVIEW *val);
 
 #ifdef __cplusplus
     }
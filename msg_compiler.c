@@ -0,0 +1,502 @@
+#define	__MODULE__	"MSGCOMP"
+#define	__IDENT__	"X.01-01"
+#define	__FAC__		"MSGCOMP"
+
+
+/*
+**++
+**
+**  FACILITY:  Message Compiler - produce a binary message catalog file
+**
+**  ABSTRACT: A tool to compile message definitions from the .MSG file into the binary,
+**	pre-sorted and pre-indexed message catalog file is supposed to be loaded by the __util$inimsgf().
+**
+**  DESCRIPTION: This true story is based on the OpenVMS MESSAGE Utility. The .MSG file
+**	syntax is follows:
+**
+**	! Comment up to end of line
+**	.FACILITY	<name>, <number> [/PREFIX=<prefix>]
+**	.SEVERITY	SUCCESS | INFORMATIONAL | WARNING | ERROR | FATAL
+**	.BASE		<message number>
+**	<ident>		<text> [/SUCCESS | /INFORMATIONAL | /WARNING | /ERROR | /FATAL]
+**	.END
+**
+**	<text> is a C-format string is enclosed in the '<>' or '""', the message record text is
+**	formed as "%<facility>-<severity>-<ident>, <text>". Message numbers are assigned
+**	sequentially starting from the .BASE value.
+**
+**  USAGE:
+**	$ msgcomp -input=<file.msg> -output=<file.msgf> [-header=<file.h>]
+**
+**	The optional C header file contains definitions of the condition codes:
+**	#define	<prefix><ident>	<sts>
+**
+**  AUTHORS: Ruslan R. Laishev (RRL)
+**
+**  CREATION DATE:  19-OCT-2026
+**
+**  MODIFICATION HISTORY:
+**
+**--
+*/
+
+
+#include	<stdio.h>
+#include	<stdlib.h>
+#include	<string.h>
+#include	<strings.h>
+#include	<ctype.h>
+#include	<errno.h>
+
+#include	"utility_routines.h"
+
+
+#define	MSGC$K_MAXNAME	31			/* A maximum length of the facility name or message identifier	*/
+#define	MSGC$K_MAXMSGNO	0x1fff			/* 13 bits of the message number				*/
+
+
+typedef	struct __msgc_fac__	{
+	char		name[MSGC$K_MAXNAME + 1],	/* Facility name				*/
+			prefix[MSGC$K_MAXNAME + 1];	/* Prefix of the symbols in the C header	*/
+	unsigned	facno;				/* Facility number				*/
+} MSGC_FAC;
+
+typedef	struct __msgc_msg__	{
+	unsigned	facidx;				/* An index of the facility in the s_facs[]	*/
+	char		ident[MSGC$K_MAXNAME + 1];	/* Message identifier				*/
+	EMSG_RECORD	rec;				/* Message record itself			*/
+} MSGC_MSG;
+
+static	MSGC_FAC	*s_facs;			/* A list of the facilities			*/
+static	unsigned	s_facnr;
+
+static	MSGC_MSG	*s_msgs;			/* A list of the messages			*/
+static	unsigned	s_msgnr;
+
+static	const char	*s_fspec;			/* Input file for diagnostic			*/
+static	int		s_lineno, s_errors;
+
+
+static	const struct	{
+	const char	*kwd;
+	int		sev;
+} s_sevtbl [] = {
+	{"SUCCESS",		STS$K_SUCCESS},
+	{"INFORMATIONAL",	STS$K_INFO},
+	{"WARNING",		STS$K_WARN},
+	{"ERROR",		STS$K_ERROR},
+	{"FATAL",		STS$K_FATAL},
+	{"SEVERE",		STS$K_FATAL},
+	{NULL,			0}
+};
+
+static const char s_sevchar [STS$K_MAX] = { 'W', 'S', 'E', 'I', 'F', '?', '?', '?'};
+
+
+/* Put diagnostic with the file name and line number, count errors */
+#define	$MSGC_ERR(fmt, ...)	(s_errors++, $LOG(STS$K_ERROR, "%s:%d : " fmt, s_fspec, s_lineno, ## __VA_ARGS__))
+
+
+/* Skip spaces and tabs, return an address of the first significant character */
+static char	*s_skipws	(char *a_cp)
+{
+	while ( *a_cp == ' ' || *a_cp == '\t' )
+		a_cp++;
+
+	return	a_cp;
+}
+
+/* Get a word: letters, digits, '$', '_', '.', return a length of the word */
+static int	s_getword	(
+		char	**a_cp,
+		char	*a_word,
+		int	a_wordsz
+			)
+{
+char	*l_cp = s_skipws(*a_cp);
+int	l_len = 0;
+
+	for ( ; isalnum((unsigned char) *l_cp) || *l_cp == '$' || *l_cp == '_' || *l_cp == '.'; l_cp++ )
+		if ( l_len < a_wordsz - 1 )
+			a_word[l_len++] = *l_cp;
+
+	a_word[l_len] = '\0';
+	*a_cp = l_cp;
+
+	return	l_len;
+}
+
+/* Match a severity keyword, allow abbreviations */
+static int	s_getsev	(
+		const char	*a_kwd,
+		int		*a_sev
+			)
+{
+int	i, l_len = (int) strlen(a_kwd);
+
+	for ( i = 0; l_len && s_sevtbl[i].kwd; i++ )
+		if ( !strncasecmp(a_kwd, s_sevtbl[i].kwd, l_len) )
+			{
+			*a_sev = s_sevtbl[i].sev;
+			return	STS$K_SUCCESS;
+			}
+
+	return	STS$K_ERROR;
+}
+
+/* Strip a comment, '!' inside of the quoted text is not a comment */
+static void	s_uncomment	(char *a_buf)
+{
+char	l_quote = 0;
+
+	for ( ; *a_buf; a_buf++ )
+		{
+		if ( l_quote )
+			{
+			if ( *a_buf == l_quote )
+				l_quote = 0;
+			}
+		else if ( *a_buf == '<' )
+			l_quote = '>';
+		else if ( *a_buf == '"' )
+			l_quote = '"';
+		else if ( *a_buf == '!' || *a_buf == '\r' || *a_buf == '\n' )
+			{
+			*a_buf = '\0';
+			break;
+			}
+		}
+}
+
+
+/* Process .FACILITY <name>, <number> [/PREFIX=<prefix>] */
+static int	s_do_facility	(char *a_cp)
+{
+MSGC_FAC	*l_fac;
+char	l_word[64];
+unsigned	i;
+
+	if ( !(s_facs = realloc(s_facs, (s_facnr + 1) * sizeof(MSGC_FAC))) )
+		return	$LOG(STS$K_FATAL, "Insufficient memory, errno = %d", errno);
+
+	l_fac = &s_facs[s_facnr];
+	memset(l_fac, 0, sizeof(MSGC_FAC));
+
+	if ( !s_getword(&a_cp, l_fac->name, sizeof(l_fac->name)) )
+		return	$MSGC_ERR("missing facility name");
+
+	a_cp = s_skipws(a_cp);
+	if ( *a_cp == ',' )
+		a_cp++;
+
+	if ( !s_getword(&a_cp, l_word, sizeof(l_word)) )
+		return	$MSGC_ERR("missing facility number");
+
+	l_fac->facno = (unsigned) strtoul(l_word, NULL, 0);
+
+	if ( !l_fac->facno || (l_fac->facno > 0xffff) )
+		return	$MSGC_ERR("facility number %s is out of range 1-65535", l_word);
+
+	snprintf(l_fac->prefix, sizeof(l_fac->prefix), "%s$_", l_fac->name);
+
+	a_cp = s_skipws(a_cp);
+	if ( !strncasecmp(a_cp, "/PREFIX=", 8) )
+		{
+		a_cp += 8;
+		s_getword(&a_cp, l_fac->prefix, sizeof(l_fac->prefix));
+		}
+
+	for ( i = 0; i < s_facnr; i++ )
+		if ( (s_facs[i].facno == l_fac->facno) || !strcasecmp(s_facs[i].name, l_fac->name) )
+			return	$MSGC_ERR("facility %s, %u is already defined", l_fac->name, l_fac->facno);
+
+	s_facnr++;
+
+	return	STS$K_SUCCESS;
+}
+
+/* Process <ident> <text> [/<severity>] */
+static int	s_do_message	(
+		char		*a_cp,
+		unsigned	a_msgno,
+		int		a_sev
+			)
+{
+MSGC_MSG	*l_msg;
+MSGC_FAC	*l_fac = &s_facs[s_facnr - 1];
+char	l_word[64], *l_text, l_quote;
+int	l_len;
+
+	if ( !(s_msgs = realloc(s_msgs, (s_msgnr + 1) * sizeof(MSGC_MSG))) )
+		return	$LOG(STS$K_FATAL, "Insufficient memory, errno = %d", errno);
+
+	l_msg = &s_msgs[s_msgnr];
+	memset(l_msg, 0, sizeof(MSGC_MSG));
+
+	if ( !s_getword(&a_cp, l_msg->ident, sizeof(l_msg->ident)) )
+		return	$MSGC_ERR("missing message identifier");
+
+	a_cp = s_skipws(a_cp);
+
+	if ( *a_cp != '<' && *a_cp != '"' )
+		return	$MSGC_ERR("message text must be enclosed in the '<>' or '\"\"'");
+
+	l_quote = (*a_cp == '<') ? '>' : '"';
+	l_text = ++a_cp;
+
+	if ( !(a_cp = strchr(a_cp, l_quote)) )
+		return	$MSGC_ERR("unterminated message text");
+
+	*(a_cp++) = '\0';
+
+	/* Optional severity qualifier */
+	a_cp = s_skipws(a_cp);
+	if ( *a_cp == '/' )
+		{
+		a_cp++;
+		s_getword(&a_cp, l_word, sizeof(l_word));
+
+		if ( !(1 & s_getsev(l_word, &a_sev)) )
+			return	$MSGC_ERR("unrecognized severity '%s'", l_word);
+		}
+
+	if ( a_msgno > MSGC$K_MAXMSGNO )
+		return	$MSGC_ERR("message number %u is out of range", a_msgno);
+
+	l_len = snprintf(l_msg->rec.text, sizeof(l_msg->rec.text), "%%%%%s-%c-%s, %s", l_fac->name, s_sevchar[a_sev], l_msg->ident, l_text);
+
+	if ( l_len >= (int) sizeof(l_msg->rec.text) )
+		return	$MSGC_ERR("message text is too long");
+
+	l_msg->facidx = s_facnr - 1;
+	l_msg->rec.textl = (unsigned char) l_len;
+	l_msg->rec.sts = (int) ((l_fac->facno << 16) | (a_msgno << 3) | a_sev);
+
+	s_msgnr++;
+
+	return	STS$K_SUCCESS;
+}
+
+/* Parse the .MSG file */
+static int	s_parse	(const char *a_fspec)
+{
+FILE	*l_fp;
+char	l_buf[512], l_word[64], *l_cp;
+unsigned	l_msgno = 1;
+int	l_sev = STS$K_ERROR;
+
+	if ( !(l_fp = fopen(s_fspec = a_fspec, "r")) )
+		return	$LOG(STS$K_ERROR, "Error open file '%s', errno = %d", a_fspec, errno);
+
+	for ( s_lineno = 1; fgets(l_buf, sizeof(l_buf), l_fp); s_lineno++ )
+		{
+		s_uncomment(l_buf);
+
+		if ( !*(l_cp = s_skipws(l_buf)) )
+			continue;
+
+		if ( *l_cp != '.' )
+			{
+			if ( !s_facnr )
+				$MSGC_ERR("message definition before .FACILITY");
+			else if ( 1 & s_do_message(l_cp, l_msgno, l_sev) )
+				l_msgno++;
+
+			continue;
+			}
+
+		s_getword(&l_cp, l_word, sizeof(l_word));
+
+		if ( !strcasecmp(l_word, ".FACILITY") )
+			{
+			if ( 1 & s_do_facility(l_cp) )
+				l_msgno = 1, l_sev = STS$K_ERROR;
+			}
+		else if ( !strcasecmp(l_word, ".SEVERITY") )
+			{
+			s_getword(&l_cp, l_word, sizeof(l_word));
+
+			if ( !(1 & s_getsev(l_word, &l_sev)) )
+				$MSGC_ERR("unrecognized severity '%s'", l_word);
+			}
+		else if ( !strcasecmp(l_word, ".BASE") )
+			{
+			s_getword(&l_cp, l_word, sizeof(l_word));
+			l_msgno = (unsigned) strtoul(l_word, NULL, 0);
+			}
+		else if ( !strcasecmp(l_word, ".END") )
+			break;
+		else if ( strcasecmp(l_word, ".TITLE") && strcasecmp(l_word, ".IDENT") )
+			$MSGC_ERR("unrecognized directive '%s'", l_word);
+		}
+
+	fclose(l_fp);
+
+	return	s_errors ? STS$K_ERROR : STS$K_SUCCESS;
+}
+
+
+/* Order messages by facility and <sts> as the __util$getmsg() expects */
+static int	s_msgcmp	(const void *a, const void *b)
+{
+const MSGC_MSG *m1 = a, *m2 = b;
+
+	if ( m1->facidx != m2->facidx )
+		return	(m1->facidx < m2->facidx) ? -1 : 1;
+
+	return	(m1->rec.sts < m2->rec.sts) ? -1 : (m1->rec.sts > m2->rec.sts);
+}
+
+#define	$ALIGN(x)	(((x) + EMSG$K_FILE_ALIGN - 1) & ~(EMSG$K_FILE_ALIGN - 1))
+
+/* Form the binary message catalog and write it to file */
+static int	s_write_catalog	(const char *a_fspec)
+{
+EMSG_FILE_HDR	*l_hdr;
+EMSG_FILE_FAC	*l_fac;
+EMSG_RECORD	*l_rec;
+unsigned	i, j, l_first, l_size, l_hdrsz, l_msgno, *l_idx;
+FILE	*l_fp;
+
+	qsort(s_msgs, s_msgnr, sizeof(MSGC_MSG), s_msgcmp);
+
+	for ( i = 1; i < s_msgnr; i++ )
+		if ( s_msgs[i].rec.sts == s_msgs[i - 1].rec.sts )
+			return	$LOG(STS$K_ERROR, "%s and %s have the same condition code %#x", s_msgs[i - 1].ident, s_msgs[i].ident, s_msgs[i].rec.sts);
+
+	/* Compute layout of the file: header, facilities, then records and index of every facility */
+	l_size = $ALIGN(sizeof(EMSG_FILE_HDR) + s_facnr * sizeof(EMSG_FILE_FAC));
+
+	if ( !(l_hdr = calloc(1, l_hdrsz = l_size)) )
+		return	$LOG(STS$K_FATAL, "Insufficient memory, errno = %d", errno);
+
+	for ( i = j = 0; i < s_facnr; i++ )
+		{
+		l_fac = &l_hdr->fac[i];
+
+		strncpy(l_fac->name, s_facs[i].name, sizeof(l_fac->name) - 1);
+		l_fac->facno = s_facs[i].facno;
+		l_fac->msgmin = MSGC$K_MAXMSGNO;
+
+		for ( l_first = j; (j < s_msgnr) && (s_msgs[j].facidx == i); j++ )
+			{
+			l_msgno = $MSG((unsigned) s_msgs[j].rec.sts) & MSGC$K_MAXMSGNO;
+			l_fac->msgmin = $MIN(l_fac->msgmin, l_msgno);
+			l_fac->idxnr = $MAX(l_fac->idxnr, l_msgno + 1);
+			}
+
+		if ( !(l_fac->msgnr = j - l_first) )
+			l_fac->msgmin = 0;
+
+		l_fac->idxnr = l_fac->msgnr ? l_fac->idxnr - l_fac->msgmin : 0;
+
+		l_fac->recoff = l_size;
+		l_size = $ALIGN(l_size + l_fac->msgnr * sizeof(EMSG_RECORD));
+
+		l_fac->idxoff = l_size;
+		l_size = $ALIGN(l_size + l_fac->idxnr * sizeof(unsigned));
+		}
+
+	if ( !(l_hdr = realloc(l_hdr, l_size)) )
+		return	$LOG(STS$K_FATAL, "Insufficient memory, errno = %d", errno);
+
+	memset((char *) l_hdr + l_hdrsz, 0, l_size - l_hdrsz);
+
+	memcpy(l_hdr->magic, EMSG$T_FILE_MAGIC, sizeof(l_hdr->magic));
+	l_hdr->bom = EMSG$K_FILE_BOM;
+	l_hdr->recsz = sizeof(EMSG_RECORD);
+	l_hdr->facnr = s_facnr;
+	l_hdr->size = l_size;
+
+	/* Fill records and dense index of every facility */
+	for ( i = j = 0; i < s_facnr; i++ )
+		{
+		l_fac = &l_hdr->fac[i];
+		l_rec = (EMSG_RECORD *) ((char *) l_hdr + l_fac->recoff);
+		l_idx = (unsigned *) ((char *) l_hdr + l_fac->idxoff);
+
+		for ( l_first = j; (j < s_msgnr) && (s_msgs[j].facidx == i); j++ )
+			{
+			l_rec[j - l_first] = s_msgs[j].rec;
+
+			l_msgno = ($MSG((unsigned) s_msgs[j].rec.sts) & MSGC$K_MAXMSGNO) - l_fac->msgmin;
+
+			if ( !l_idx[l_msgno] )
+				l_idx[l_msgno] = j - l_first + 1;
+			}
+		}
+
+	if ( !(l_fp = fopen(a_fspec, "wb")) )
+		{
+		free(l_hdr);
+		return	$LOG(STS$K_ERROR, "Error create file '%s', errno = %d", a_fspec, errno);
+		}
+
+	i = (unsigned) fwrite(l_hdr, l_size, 1, l_fp);
+	i &= !fclose(l_fp);
+	free(l_hdr);
+
+	if ( !i )
+		return	$LOG(STS$K_ERROR, "Error write file '%s', errno = %d", a_fspec, errno);
+
+	return	$LOG(STS$K_SUCCESS, "%s : %u facilities, %u messages, %u octets", a_fspec, s_facnr, s_msgnr, l_size);
+}
+
+/* Write C header with the condition codes definitions */
+static int	s_write_header	(const char *a_fspec)
+{
+FILE	*l_fp;
+unsigned	i;
+
+	if ( !(l_fp = fopen(a_fspec, "w")) )
+		return	$LOG(STS$K_ERROR, "Error create file '%s', errno = %d", a_fspec, errno);
+
+	fprintf(l_fp, "/* This file has been generated by the message compiler from the %s, don't edit it! */\n\n", s_fspec);
+
+	for ( i = 0; i < s_facnr; i++ )
+		fprintf(l_fp, "#define\t%sFACILITY\t%u\n", s_facs[i].prefix, s_facs[i].facno);
+
+	for ( i = 0; i < s_msgnr; i++ )
+		fprintf(l_fp, "%s#define\t%s%s\t0x%08x\n", (i && (s_msgs[i].facidx == s_msgs[i - 1].facidx)) ? "" : "\n",
+			s_facs[s_msgs[i].facidx].prefix, s_msgs[i].ident, (unsigned) s_msgs[i].rec.sts);
+
+	if ( fclose(l_fp) )
+		return	$LOG(STS$K_ERROR, "Error write file '%s', errno = %d", a_fspec, errno);
+
+	return	STS$K_SUCCESS;
+}
+
+
+int	main	(int argc, char *argv[])
+{
+ASC	l_input = {0}, l_output = {0}, l_header = {0};
+int	l_status;
+
+const OPTS l_optstbl [] =
+	{
+		{{$ASCINI("input")},	&l_input, ASC$K_SZ,		OPTS$K_STR},
+		{{$ASCINI("output")},	&l_output, ASC$K_SZ,		OPTS$K_STR},
+		{{$ASCINI("header")},	&l_header, ASC$K_SZ,		OPTS$K_STR},
+
+		OPTS_NULL
+	};
+
+	__util$getparams(argc, argv, l_optstbl);
+
+	if ( !$ASCLEN(&l_input) || !$ASCLEN(&l_output) )
+		{
+		$LOG(STS$K_ERROR, "Usage: %s -input=<file.msg> -output=<file.msgf> [-header=<file.h>]", argv[0]);
+		return	EXIT_FAILURE;
+		}
+
+	if ( !(1 & (l_status = s_parse($ASCPTR(&l_input)))) )
+		return	$LOG(STS$K_ERROR, "%s : %d errors, no output", $ASCPTR(&l_input), s_errors), EXIT_FAILURE;
+
+	if ( !(1 & (l_status = s_write_catalog($ASCPTR(&l_output)))) )
+		return	EXIT_FAILURE;
+
+	if ( $ASCLEN(&l_header) && !(1 & (l_status = s_write_header($ASCPTR(&l_header)))) )
+		return	EXIT_FAILURE;
+
+	return	EXIT_SUCCESS;
+}
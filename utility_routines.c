@@ -1,6 +1,6 @@
 #define	__MODULE__	"UTIL$"
-#define	__IDENT__	"V.01-05"
-#define	__REV__		"1.05.0"
+#define	__IDENT__	"V.01-29"
+#define	__REV__		"1.29.0"
 
 
 /*
@@ -91,6 +91,71 @@
 **	24-APR-2026	RRL	V.01-05 : Added support for parsing CLI option started with "--",
 **				--trace --logfile ...
 **
+**	19-OCT-2026	RRL	V.01-06 : Added a flight recorder - per-thread rings of the last log/trace records,
+**				dumped by the fatal signals handler or on demand.
+**
+**	19-OCT-2026	RRL	V.01-07 : Added run-time toggled trace points registry: __util$tpnt_*() routines.
+**
+**	19-OCT-2026	RRL	V.01-08 : Added __util$dumphexl() to dump buffers longer than 64K by batched write(),
+**				the lines are formatted by the __util$faohexl() with SSE2 nibble conversion.
+**
+**	19-OCT-2026	RRL	V.01-09 : Added JSON output mode of the log records: __util$logmode().
+**
+**	19-OCT-2026	RRL	V.01-10 : Added per call site rate limiting: __util$logrl(), __util$logrl_flush().
+**
+**	19-OCT-2026	RRL	V.01-11 : Added the message catalog index to speed up __util$getmsg(),
+**				__util$inimsg() is made thread-safe.
+**
+**	19-OCT-2026	RRL	V.01-12 : Added __util$inimsgf() to load binary message catalog file by mmap().
+**
+**	19-OCT-2026	RRL	V.01-13 : Added compiled FAO programs: __util$fao_compile(), __util$fao_exec(),
+**				__util$faoc() with cache of the programs by control string address.
+**
+**	19-OCT-2026	RRL	V.01-14 : Table-driven integer formatting kernels are used by the FAO numeric directives
+**				and the log records prefixes instead of the snprintf();
+**				added /BENCH option into the debug main().
+**
+**	19-OCT-2026	RRL	V.01-15 : Added __util$faov() - FAO output into the I/O vector with the string arguments
+**				are referenced in place, __util$logfao() - log record is written by the writev().
+**
+**	19-OCT-2026	RRL	V.01-16 : Completed __util$faol(): !%D, !%T with per-second cache of the time text, !UL, !XL ...,
+**				bulk appends and memset() padding, fixed crash on the padding at end of buffer;
+**				the check and benchmark of the __util$faol() in the debug main().
+**
+**	19-OCT-2026	RRL	V.01-17 : SSE2/AVX2 versions of the __util$strstr() are selected by the CPU features at first call;
+**				fixed reading beyond end of the s1 by the scalar version.
+**
+**	19-OCT-2026	RRL	V.01-18 : Added __util$mpm_*() - multi-pattern search by the Aho-Corasick DFA.
+**
+**	19-OCT-2026	RRL	V.01-19 : Non-recursive __util$pattern_match(); added __util$wild_*() - compiled wildcard patterns.
+**
+**	19-OCT-2026	RRL	V.01-20 : Added __util$wildset_*() - matching against a set of the wildcard patterns.
+**
+**	19-OCT-2026	RRL	V.01-21 : __util$bin2hex(), __util$hex2bin() are moved from the header, SSSE3/AVX2 versions
+**				with size_t lengths; added __util$hex2bin_ex() - strict check with position of the error.
+**
+**	19-OCT-2026	RRL	V.01-22 : __util$iszero(), __util$bzero() are moved from the header, SSE2/AVX2 versions
+**				with aligned blocks and non-temporal stores; fixed zeroing of the tail by the __util$bzero().
+**
+**	19-OCT-2026	RRL	V.01-23 : __util$strxor() is moved from the header, XOR-ing by the runs of the expanded key
+**				with SSE2/AVX2; added __util$strxor_mt() - XOR-ing of the large buffer by the several threads.
+**
+**	19-OCT-2026	RRL	V.01-24 : Added __util$kwdidx_*() - compiled keywords table for the exact and abbreviated lookup.
+**
+**	19-OCT-2026	RRL	V.01-25 : Added __util$arena_*() - bump-pointer arena for the compact strings and small objects.
+**
+**	19-OCT-2026	RRL	V.01-26 : Added __util$uuid_*() - version 4/7 UUID generation, parsing, compare and hash;
+**				__util$uuid2str() is moved from the header, it's table-driven now.
+**
+**	19-OCT-2026	RRL	V.01-27 : Added __util$b64*() - Base64/Base64url encoding and decoding with SSSE3/AVX2,
+**				the chunked data is processed by UTIL_B64CTX.
+**
+**	19-OCT-2026	RRL	V.01-28 : Added __util$memcmp_blind(), __util$fold_blind(), __util$hash_blind() - ASCII-only
+**				case-insensitive routines with SSE2/AVX2, they are used instead of strncasecmp() for options.
+**
+**	19-OCT-2026	RRL	V.01-29 : Added __util$sv_normalize() - single pass SSE2/AVX2 line normalizer:
+**				uncomment + trim + collapse, it's used to read configuration and rules files.
+**
 */
 
 
@@ -118,6 +183,19 @@
 #include	<sys/types.h>
 #include	<sys/stat.h>
 #include	<fcntl.h>
+#include	<signal.h>
+
+#ifndef	WIN32
+#include	<sys/mman.h>
+#endif
+
+#ifdef	__SSE2__
+#include	<emmintrin.h>
+#endif
+
+#if	defined(__GNUC__) && defined(__x86_64__)
+#include	<immintrin.h>				/* AVX2 versions are compiled with the target("avx2") attribute */
+#endif
 
 
 #ifdef  ANDROID
@@ -132,6 +210,7 @@
 //#include	<execinfo.h>
 #include	<arpa/inet.h>
 #include	<syslog.h>
+#include	<sys/uio.h>
 
 #define	UTIL$T_PID_FMT	"%6d "
 	#define	TIMSPECDEVIDER	(1024*1024)	/* Used to convert timespec's nanosec tro miliseconds */
@@ -188,6 +267,7 @@ struct sockaddr_in slogsock;						/* SYSLOG Host socket					*/
 
 
 static EMSG_RECORD_DESC	*emsg_record_desc_root;				/* A root to the message records descriptior		*/
+static volatile int	s_tpnt_reload;					/* A request to reload the trace points control file	*/
 
 /*
  *   DESCRIPTION: Message record compare routine
@@ -209,9 +289,134 @@ const EMSG_RECORD *m1 = a, *m2 = b;
 }
 
 
+/*
+ * Message catalog index: a facility hash table with open addressing, every entry refers to
+ * the message records descriptor and keeps a dense table "message number -> record index + 1".
+ * Entries are added under spinlock and published by the release store, so readers don't need locks.
+ */
+#define	UTIL$K_EMSG_HASHSZ	256				/* A size of the facility hash table, power of 2	*/
+#define	UTIL$M_EMSG_MSGNO	0x1fff				/* 13 bits of the message number			*/
+
+typedef struct __emsg_index__ {
+	unsigned		facno;				/* A facility number					*/
+	EMSG_RECORD_DESC	*msgdsc;			/* An address of the message records descriptor	*/
+	unsigned		msgmin,				/* A minimal message number in the descriptor		*/
+				msgnr;				/* A number of entries in the idx[]			*/
+	const unsigned		*idx;				/* An index of the record + 1, 0 - no record		*/
+} EMSG_INDEX;
+
+static EMSG_INDEX	*s_emsg_hash[UTIL$K_EMSG_HASHSZ];		/* Facility hash table					*/
+static int		s_emsg_lock;					/* Serialize registration of the descriptors		*/
+
+inline static unsigned	s_emsg_hashfac	(unsigned a_facno)
+{
+	return	((a_facno * 0x9E3779B1U) >> 24) & (UTIL$K_EMSG_HASHSZ - 1);
+}
+
+/* Build dense index of the message records descriptor, the records must be sorted */
+static EMSG_INDEX	*s_emsg_mkindex	(
+		EMSG_RECORD_DESC *a_msgdsc
+			)
+{
+EMSG_INDEX	*l_ix;
+unsigned	i, l_msgno, l_min = UTIL$M_EMSG_MSGNO, l_max = 0, *l_idx;
+
+	for ( i = 0; i < a_msgdsc->msgnr; i++ )
+		{
+		if ( $FAC((unsigned) a_msgdsc->msgrec[i].sts) != a_msgdsc->facno )
+			continue;
+
+		l_msgno = $MSG((unsigned) a_msgdsc->msgrec[i].sts) & UTIL$M_EMSG_MSGNO;
+		l_min = $MIN(l_min, l_msgno);
+		l_max = $MAX(l_max, l_msgno);
+		}
+
+	if ( l_min > l_max )
+		l_min = l_max = 0;
+
+	if ( !(l_ix = calloc(1, sizeof(EMSG_INDEX) + (l_max - l_min + 1) * sizeof(l_ix->idx[0]))) )
+		return	NULL;
+
+	l_ix->facno = a_msgdsc->facno;
+	l_ix->msgdsc = a_msgdsc;
+	l_ix->msgmin = l_min;
+	l_ix->msgnr = l_max - l_min + 1;
+	l_ix->idx = l_idx = (unsigned *) (l_ix + 1);
+
+	/* A first record with the given message number wins, other severities are found by bsearch() */
+	for ( i = 0; i < a_msgdsc->msgnr; i++ )
+		{
+		if ( $FAC((unsigned) a_msgdsc->msgrec[i].sts) != a_msgdsc->facno )
+			continue;
+
+		l_msgno = ($MSG((unsigned) a_msgdsc->msgrec[i].sts) & UTIL$M_EMSG_MSGNO) - l_min;
+
+		if ( !l_idx[l_msgno] )
+			l_idx[l_msgno] = i + 1;
+		}
+
+	return	l_ix;
+}
+
+/*
+ *   DESCRIPTION: Link message records descriptor in to the global list and put its index
+ *	into the facility hash table.
+ *
+ *   INPUTS:
+ *	msgdsc:	Message Records Descriptor, records must be sorted
+ *	ix:	An index of the message records, can be NULL
+ *
+ *   OUTPUTS:
+ *	placed:	1 - the index has been put into the hash table
+ *
+ *   RETURNS:
+ *	STS$K_WARN	- the facility is already registered
+ *	condition code
+ */
+static unsigned	s_emsg_register	(
+		EMSG_RECORD_DESC *a_msgdsc,
+		EMSG_INDEX	*a_ix,
+		int		*a_placed
+			)
+{
+EMSG_RECORD_DESC *l_md;
+unsigned	h, i;
+
+	*a_placed = 0;
+
+	$LOCK_LONG(&s_emsg_lock);
+
+	/* At first level we try to find the message records descriptor by using facility number */
+	for  (l_md = emsg_record_desc_root; l_md; l_md = l_md->link)
+		if ( l_md->facno == a_msgdsc->facno)
+			break;
+
+	if ( l_md )
+		{
+		$UNLOCK_LONG(&s_emsg_lock);
+		return	STS$K_WARN;
+		}
+
+	a_msgdsc->link = emsg_record_desc_root;
+	__atomic_store_n(&emsg_record_desc_root, a_msgdsc, __ATOMIC_RELEASE);
+
+	/* Put the index into the first free slot, the table full condition is not an error - linked list still works */
+	for ( h = s_emsg_hashfac(a_msgdsc->facno), i = 0; a_ix && (i < UTIL$K_EMSG_HASHSZ); i++, h = (h + 1) & (UTIL$K_EMSG_HASHSZ - 1) )
+		if ( !s_emsg_hash[h] )
+			{
+			__atomic_store_n(&s_emsg_hash[h], a_ix, __ATOMIC_RELEASE);
+			*a_placed = 1;
+			break;
+			}
+
+	$UNLOCK_LONG(&s_emsg_lock);
+
+	return	STS$K_SUCCESS;
+}
+
 /*
  *   DESCRIPTION: Sorting message records according <sts> field as a key,
- *	link message records descriptor in to the global list.
+ *	link message records descriptor in to the global list and put it into the catalog index.
  *	This routine is should be called once at task initialization time before any
  *	consecutive $GETMSG/$PUTMSG calls!
  *
@@ -233,23 +438,130 @@ const EMSG_RECORD *m1 = a, *m2 = b;
  */
 unsigned	__util$inimsg	(EMSG_RECORD_DESC *msgdsc)
 {
-EMSG_RECORD_DESC *md;
+EMSG_INDEX	*ix;
+unsigned	status;
+int	placed;
 
 	if ( !msgdsc )
 		return	STS$K_WARN;
 
-	/* At first level we try to find the message records descriptor by using facility number */
-	for  (md = emsg_record_desc_root; md; md = md->link)
-		if ( md->facno == msgdsc->facno)
-			return	STS$K_WARN;
+	qsort(msgdsc->msgrec, msgdsc->msgnr, sizeof(EMSG_RECORD), __msgcmp);
 
+	ix = s_emsg_mkindex(msgdsc);
 
-	qsort(msgdsc->msgrec, msgdsc->msgnr, sizeof(EMSG_RECORD), __msgcmp);
+	status = s_emsg_register(msgdsc, ix, &placed);
 
-	msgdsc->link = emsg_record_desc_root;
-	emsg_record_desc_root = msgdsc;
+	if ( !placed )
+		free(ix);
 
-	return	STS$K_SUCCESS;
+	return	status;
+}
+
+/*
+ *   DESCRIPTION: Map the binary message catalog file has been produced by the message compiler,
+ *	register all facilities from the file. The records and indexes are used "as is"
+ *	from the read-only shared pages, the file is never unmapped if any facility has been registered.
+ *
+ *   INPUTS:
+ *	fspec:	A message catalog file specification
+ *
+ *   OUTPUTS:
+ *	NONE
+ *
+ *   RETURNS:
+ *	STS$K_WARN	- some facilities are already registered
+ *	condition code
+ */
+unsigned	__util$inimsgf	(const char *fspec)
+{
+#ifndef	WIN32
+int	fd, placed;
+struct stat st;
+const EMSG_FILE_HDR *hdr;
+const EMSG_FILE_FAC *fac;
+EMSG_RECORD_DESC *msgdsc;
+EMSG_INDEX	*ix;
+const unsigned	*idx;
+unsigned	i, j, regnr = 0, status = STS$K_SUCCESS;
+
+	if ( 0 > (fd = open(fspec, O_RDONLY)) )
+		return	$LOG(STS$K_ERROR, "Error open file '%s', errno = %d", fspec, errno);
+
+	if ( fstat(fd, &st) || (st.st_size < (off_t) sizeof(EMSG_FILE_HDR)) )
+		{
+		close(fd);
+		return	$LOG(STS$K_ERROR, "%s : file is too short or cannot be accessed, errno = %d", fspec, errno);
+		}
+
+	hdr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if ( hdr == MAP_FAILED )
+		return	$LOG(STS$K_ERROR, "%s : mmap() -> errno = %d", fspec, errno);
+
+	/* Sanity check of the file header and facilities descriptors */
+	if ( memcmp(hdr->magic, EMSG$T_FILE_MAGIC, sizeof(hdr->magic)) || (hdr->bom != EMSG$K_FILE_BOM)
+		|| (hdr->recsz != sizeof(EMSG_RECORD)) || (hdr->size != (unsigned) st.st_size)
+		|| ((sizeof(EMSG_FILE_HDR) + hdr->facnr * sizeof(EMSG_FILE_FAC)) > hdr->size) )
+		{
+		munmap((void *) hdr, st.st_size);
+		return	$LOG(STS$K_ERROR, "%s : is not a message catalog file or is built for other platform", fspec);
+		}
+
+	for ( i = 0, fac = hdr->fac; i < hdr->facnr; i++, fac++ )
+		if ( ((fac->recoff + (unsigned long long) fac->msgnr * sizeof(EMSG_RECORD)) > hdr->size)
+			|| ((fac->idxoff + (unsigned long long) fac->idxnr * sizeof(unsigned)) > hdr->size) )
+			{
+			munmap((void *) hdr, st.st_size);
+			return	$LOG(STS$K_ERROR, "%s : facility %.*s is out of file", fspec, (int) sizeof(fac->name), fac->name);
+			}
+
+	/* Index entries must refer to the records of the facility */
+	for ( i = 0, fac = hdr->fac; i < hdr->facnr; i++, fac++ )
+		for ( idx = (const unsigned *) ((char *) hdr + fac->idxoff), j = 0; j < fac->idxnr; j++ )
+			if ( idx[j] > fac->msgnr )
+				{
+				munmap((void *) hdr, st.st_size);
+				return	$LOG(STS$K_ERROR, "%s : facility %.*s has corrupted index", fspec, (int) sizeof(fac->name), fac->name);
+				}
+
+	/* Register facilities, only small descriptors are allocated */
+	for ( i = 0, fac = hdr->fac; i < hdr->facnr; i++, fac++ )
+		{
+		if ( !(msgdsc = calloc(1, sizeof(EMSG_RECORD_DESC) + sizeof(EMSG_INDEX))) )
+			{
+			status = $LOG(STS$K_FATAL, "Insufficient memory, errno = %d", errno);
+			break;
+			}
+
+		msgdsc->facno = fac->facno;
+		msgdsc->msgnr = fac->msgnr;
+		msgdsc->msgrec = (EMSG_RECORD *) ((char *) hdr + fac->recoff);
+
+		ix = (EMSG_INDEX *) (msgdsc + 1);
+		ix->facno = fac->facno;
+		ix->msgdsc = msgdsc;
+		ix->msgmin = fac->msgmin;
+		ix->msgnr = fac->idxnr;
+		ix->idx = (const unsigned *) ((char *) hdr + fac->idxoff);
+
+		if ( !(1 & s_emsg_register(msgdsc, ix, &placed)) )
+			{
+			free(msgdsc);
+			status = $LOG(STS$K_WARN, "%s : facility %.*s (%u) is already registered", fspec,
+				(int) sizeof(fac->name), fac->name, fac->facno);
+			}
+		else	regnr++;
+		}
+
+	/* Nothing refers to the file */
+	if ( !regnr )
+		munmap((void *) hdr, st.st_size);
+
+	return	status;
+#else
+	return	STS$K_ERROR;
+#endif
 }
 
 
@@ -271,16 +583,40 @@ EMSG_RECORD_DESC *md;
  */
 unsigned	__util$getmsg	(unsigned sts, EMSG_RECORD **outmsg )
 {
-unsigned	facno;
-EMSG_RECORD_DESC *msgdsc;
+unsigned	facno, h, i, msgno, rec;
+EMSG_RECORD_DESC *msgdsc = NULL;
 EMSG_RECORD *msgrec;
+EMSG_INDEX	*ix;
 
-	/* At first level we try to find the message records descriptor by using facility number */
+	/* Lookup the catalog index: facility hash table and then dense table of the message numbers */
 	facno = $FAC(sts);
-	for  (msgdsc = emsg_record_desc_root; msgdsc; msgdsc = msgdsc->link)
-		if ( msgdsc->facno == facno)
+
+	for ( h = s_emsg_hashfac(facno), i = 0; i < UTIL$K_EMSG_HASHSZ; i++, h = (h + 1) & (UTIL$K_EMSG_HASHSZ - 1) )
+		{
+		if ( !(ix = __atomic_load_n(&s_emsg_hash[h], __ATOMIC_ACQUIRE)) )
 			break;
 
+		if ( ix->facno != facno )
+			continue;
+
+		msgno = ($MSG(sts) & UTIL$M_EMSG_MSGNO) - ix->msgmin;
+
+		if ( (msgno < ix->msgnr) && (rec = ix->idx[msgno]) && ((unsigned) ix->msgdsc->msgrec[rec - 1].sts == sts) )
+			{
+			*outmsg = &ix->msgdsc->msgrec[rec - 1];
+			return	STS$K_SUCCESS;
+			}
+
+		msgdsc = ix->msgdsc;
+		break;
+		}
+
+	/* At first level we try to find the message records descriptor by using facility number */
+	if ( !msgdsc )
+		for  (msgdsc = __atomic_load_n(&emsg_record_desc_root, __ATOMIC_ACQUIRE); msgdsc; msgdsc = msgdsc->link)
+			if ( msgdsc->facno == facno)
+				break;
+
 	if ( !msgdsc )
 		return	STS$K_ERROR;		/* RNF - Record-Not-Found */
 
@@ -315,101 +651,442 @@ EMSG_RECORD *msgrec;
 const char severity[STS$K_MAX]= { 'W', 'S', 'E', 'I', 'F', '?', '?', '?'};
 const char defmsgfao[] = {"NONAME-%c-NOMSG, Message number: %08X [fac: %#x/%d, sev: %#x/%d, msgno: %#x/%d]"};
 
-unsigned	__util$putmsg
-			(
-		unsigned	sts,
-			...
-			)
+static volatile int	s_logmode = UTIL$K_LOGMODE_TEXT;			/* Output format of the log records, see UTIL$K_LOGMODE_*	*/
 
-{
-va_list arglist;
-const char lfmt [] = "%02u-%02u-%04u %02u:%02u:%02u.%03u " UTIL$T_PID_FMT;
-char	out[UTIL$SZ_OUTBUF + 8];
-int	olen, sev;
-struct tm _tm;
-struct timespec now;
-EMSG_RECORD *msgrec;
 
-	/*
-	** Out to buffer "DD-MM-YYYY HH:MM:SS.msec <PID/TID> " prefix
-	*/
-	s___time(&now);
+/*
+ *   DESCRIPTION: Set output format of the records are produced by $LOG/$TRACE/$PUTMSG.
+ *
+ *   INPUTS:
+ *	mode:	UTIL$K_LOGMODE_TEXT or UTIL$K_LOGMODE_JSON
+ *
+ *   RETURNS:
+ *	previous mode
+ */
+int	__util$logmode	(
+		int	a_mode
+		)
+{
+	return	__atomic_exchange_n(&s_logmode, a_mode, __ATOMIC_RELAXED);
+}
 
-#ifdef	WIN32
-	localtime_s(&_tm, (time_t *)&now);
-#else
-	localtime_r((time_t *)&now, &_tm);
+/*
+ *   DESCRIPTION: Copy a string into the output buffer with JSON escaping, the string is
+ *	scanned by 16 octets for the characters are need to be escaped:  '"', '\' and < 0x20.
+ *
+ *   INPUTS:
+ *	dst:	A current position in the output buffer
+ *	end:	End of the output buffer
+ *	src:	A string to be escaped
+ *	srclen:	A length of the string
+ *
+ *   RETURNS:
+ *	A new position in the output buffer
+ */
+static char	*s_json_esc	(
+		char	*a_dst,
+		char	*a_end,
+	const char	*a_src,
+		size_t	a_srclen
+		)
+{
+const char	*l_eos = a_src + a_srclen;
+unsigned char	l_ch;
+#ifdef	__SSE2__
+__m128i	l_v, l_ctl = _mm_set1_epi8(0x1f), l_quote = _mm_set1_epi8('"'), l_bslash = _mm_set1_epi8('\\');
+unsigned	l_mask;
 #endif
 
-	olen = snprintf (out, UTIL$SZ_OUTBUF, lfmt,			/* Format a prefix part of the message: time + PID ... */
-		_tm.tm_mday, _tm.tm_mon + 1, 1900 + _tm.tm_year,
-		_tm.tm_hour, _tm.tm_min, _tm.tm_sec, (unsigned) now.tv_nsec/TIMSPECDEVIDER,
-		(unsigned) __gettid());
-
-	if ( 1 & __util$getmsg(sts, &msgrec) )				/* Retreive the message record */
+	while ( a_src < l_eos )
 		{
-		va_start (arglist, sts);				/* Format text message */
-		olen += vsnprintf(out + olen, UTIL$SZ_OUTBUF - olen, msgrec->text, arglist);
-		va_end (arglist);
-		}
-	else	{							/* Format text message with the default FAO */
-		sev = $SEV(sts);
-		olen += snprintf(out + olen, UTIL$SZ_OUTBUF - olen, defmsgfao, severity[sev], sts,
-			$FAC(sts), $FAC(sts), sev, sev, $MSG(sts), $MSG(sts));
-		}
+#ifdef	__SSE2__
+		if ( ((l_eos - a_src) >= 16) && ((a_end - a_dst) >= 16) )
+			{
+			l_v = _mm_loadu_si128((const __m128i *) a_src);
 
+			l_mask = _mm_movemask_epi8(_mm_or_si128(
+				_mm_cmpeq_epi8(_mm_max_epu8(l_v, l_ctl), l_ctl),
+				_mm_or_si128(_mm_cmpeq_epi8(l_v, l_quote), _mm_cmpeq_epi8(l_v, l_bslash))));
 
-	/* Add <LF> at end of record*/
-	out[olen++] = '\n';
+			/* Store 16 octets at once, advance up to first character to be escaped */
+			_mm_storeu_si128((__m128i *) a_dst, l_v);
 
-	/* Write to file and flush buffer depending on severity level */
-	write (g_logoutput, out, olen);
+			if ( !l_mask )
+				{
+				a_dst += 16;
+				a_src += 16;
+				continue;
+				}
 
-	/* ARL - for android logcat */
-	#ifdef ANDROID_LOGCAT
-		__android_log_print(ANDROID_LOG_VERBOSE, " --- ", "%.*s", olen, out);
-	#endif
+			a_dst += __builtin_ctz(l_mask);
+			a_src += __builtin_ctz(l_mask);
+			}
+#endif
+		l_ch = *(a_src++);
 
-	return	sts;
-}
+		if ( (l_ch >= 0x20) && (l_ch != '"') && (l_ch != '\\') )
+			{
+			if ( a_dst >= a_end )
+				break;
 
-unsigned	__util$putmsgd
-			(
-		unsigned	sts,
-		const char *	__mod,
-		const char *	__fi,
-		unsigned	__li,
-			...
-			)
+			*(a_dst++) = l_ch;
+			continue;
+			}
 
-{
-va_list arglist;
-const char	lfmt [] = {"%02u-%02u-%04u %02u:%02u:%02u.%03u " UTIL$T_PID_FMT "[%s:%u] "},
-	mfmt [] = {"%02u-%02u-%04u %02u:%02u:%02u.%03u "  UTIL$T_PID_FMT "[%s\\%s:%u] "};
-char	out[UTIL$SZ_OUTBUF + 8];
-size_t olen, sev;
-struct tm _tm;
-struct timespec now;
-EMSG_RECORD *msgrec;
+		if ( (a_end - a_dst) < 6 )
+			break;
 
-	/*
-	** Out to buffer "DD-MM-YYYY HH:MM:SS.msec <PID/TID> " prefix
-	*/
-	s___time(&now);
+		*(a_dst++) = '\\';
 
-#ifdef	WIN32
-	localtime_s(&_tm, (time_t *)&now);
-#else
-	localtime_r((time_t *)&now, &_tm);
-#endif
+		switch ( l_ch )
+			{
+			case	'"':
+			case	'\\':	*(a_dst++) = l_ch; break;
+			case	'\n':	*(a_dst++) = 'n'; break;
+			case	'\r':	*(a_dst++) = 'r'; break;
+			case	'\t':	*(a_dst++) = 't'; break;
+			case	'\b':	*(a_dst++) = 'b'; break;
+			case	'\f':	*(a_dst++) = 'f'; break;
+			default:
+				memcpy(a_dst, "u00", 3);
+				a_dst[3] = "0123456789abcdef"[l_ch >> 4];
+				a_dst[4] = "0123456789abcdef"[l_ch & 0x0f];
+				a_dst += 5;
+			}
+		}
 
-	olen = __mod
-		? snprintf (out, UTIL$SZ_OUTBUF, mfmt, _tm.tm_mday, _tm.tm_mon + 1, 1900 + _tm.tm_year,
-			_tm.tm_hour, _tm.tm_min, _tm.tm_sec, (unsigned) now.tv_nsec/TIMSPECDEVIDER,
-			(unsigned) __gettid(), __mod, __fi, __li)
-		: snprintf (out, UTIL$SZ_OUTBUF, lfmt, _tm.tm_mday, _tm.tm_mon + 1, 1900 + _tm.tm_year,
-			_tm.tm_hour, _tm.tm_min, _tm.tm_sec, (unsigned) now.tv_nsec/TIMSPECDEVIDER,
-			(unsigned) __gettid(), __fi, __li);
+	return	a_dst;
+}
+
+/* Append ',"<key>":"<escaped value>"' */
+static char	*s_json_str	(
+		char	*a_dst,
+		char	*a_end,
+	const char	*a_key,
+	const char	*a_val,
+		size_t	a_len
+		)
+{
+	if ( (a_end - a_dst) < (int) (strlen(a_key) + 6) )
+		return	a_dst;
+
+	a_dst += sprintf(a_dst, ",\"%s\":\"", a_key);
+	a_dst = s_json_esc(a_dst, a_end - 1, a_val, a_len);
+	*(a_dst++) = '"';
+
+	return	a_dst;
+}
+
+/*
+ *   DESCRIPTION: Convert a message text in the output buffer to the single line JSON object:
+ *	{"ts":<epoch ns>,"tid":<tid>,"facility":"<fac>","severity":"<S>","module":"<mod>",
+ *		"function":"<func>","line":<line>,"msg":"<text>"}
+ *	an absent fields are omitted.
+ *
+ *   INPUTS:
+ *	out:	A buffer contains message text
+ *	outsz:	A size of the buffer
+ *	msglen:	A length of the message text
+ *	now:	A time stamp of the record
+ *	fac:	A facility name, ASCIZ, can be NULL
+ *	sev:	A severity level, -1 - no severity
+ *	sts:	A condition code, 0 - no condition code
+ *	mod:	A module name, ASCIZ, can be NULL
+ *	func:	A function name, ASCIZ, can be NULL
+ *	line:	A line number, 0 - no line
+ *
+ *   OUTPUTS:
+ *	out:	JSON object
+ *
+ *   RETURNS:
+ *	A length of the JSON object
+ */
+static unsigned	s_util_jsonrec	(
+		char	*a_out,
+		unsigned a_outsz,
+		unsigned a_msglen,
+	const struct timespec *a_now,
+	const char	*a_fac,
+		int	a_sev,
+		unsigned a_sts,
+	const char	*a_mod,
+	const char	*a_func,
+		unsigned a_line
+		)
+{
+char	l_msg[UTIL$SZ_OUTBUF], *l_cp = a_out, *l_end = a_out + a_outsz - 1;
+
+	a_msglen = $MIN(a_msglen, sizeof(l_msg));
+	memcpy(l_msg, a_out, a_msglen);
+
+	l_cp += snprintf(l_cp, a_outsz, "{\"ts\":%llu,\"tid\":%u",
+		(unsigned long long) a_now->tv_sec * 1000000000ULL + a_now->tv_nsec, (unsigned) __gettid());
+
+	if ( a_fac )
+		l_cp = s_json_str(l_cp, l_end, "facility", a_fac, strlen(a_fac));
+
+	if ( a_sev >= 0 )
+		l_cp = s_json_str(l_cp, l_end, "severity", &severity[a_sev & 7], 1);
+
+	if ( a_sts )
+		l_cp += snprintf(l_cp, l_end - l_cp, ",\"sts\":%u", a_sts);
+
+	if ( a_mod )
+		l_cp = s_json_str(l_cp, l_end, "module", a_mod, strlen(a_mod));
+
+	if ( a_func )
+		l_cp = s_json_str(l_cp, l_end, "function", a_func, strlen(a_func));
+
+	if ( a_line )
+		l_cp += snprintf(l_cp, l_end - l_cp, ",\"line\":%u", a_line);
+
+	l_cp = (l_cp < l_end) ? l_cp : l_end - 1;
+	l_cp = s_json_str(l_cp, l_end - 1, "msg", l_msg, a_msglen);
+
+	*(l_cp++) = '}';
+
+	return	l_cp - a_out;
+}
+
+
+/*
+ * Two-digit lookup tables for the integer formatting kernels, see __util$u64_2_decrev(), __util$u64_2_hex()
+ */
+const char __util$dec2lut[200] = {
+	"0001020304050607080910111213141516171819"
+	"2021222324252627282930313233343536373839"
+	"4041424344454647484950515253545556575859"
+	"6061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899"
+	};
+
+const char __util$hex2lut_uc[512] = {
+	"000102030405060708090A0B0C0D0E0F"
+	"101112131415161718191A1B1C1D1E1F"
+	"202122232425262728292A2B2C2D2E2F"
+	"303132333435363738393A3B3C3D3E3F"
+	"404142434445464748494A4B4C4D4E4F"
+	"505152535455565758595A5B5C5D5E5F"
+	"606162636465666768696A6B6C6D6E6F"
+	"707172737475767778797A7B7C7D7E7F"
+	"808182838485868788898A8B8C8D8E8F"
+	"909192939495969798999A9B9C9D9E9F"
+	"A0A1A2A3A4A5A6A7A8A9AAABACADAEAF"
+	"B0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+	"C0C1C2C3C4C5C6C7C8C9CACBCCCDCECF"
+	"D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+	"E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEF"
+	"F0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF"
+	};
+
+const char __util$hex2lut_lc[512] = {
+	"000102030405060708090a0b0c0d0e0f"
+	"101112131415161718191a1b1c1d1e1f"
+	"202122232425262728292a2b2c2d2e2f"
+	"303132333435363738393a3b3c3d3e3f"
+	"404142434445464748494a4b4c4d4e4f"
+	"505152535455565758595a5b5c5d5e5f"
+	"606162636465666768696a6b6c6d6e6f"
+	"707172737475767778797a7b7c7d7e7f"
+	"808182838485868788898a8b8c8d8e8f"
+	"909192939495969798999a9b9c9d9e9f"
+	"a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+	"b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+	"c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+	"d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+	"e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+	"f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"
+	};
+
+
+/* Put decimal with left padding up to the given width by the fill character, like "%0*u" or "%*u" */
+inline static char	*s_put_udec	(
+		char	*a_out,
+	unsigned long long a_val,
+		int	a_width,
+		char	a_fill
+			)
+{
+char	l_buf[24];
+int	l_len = __util$u64_2_decrev(a_val, l_buf + sizeof(l_buf));
+
+	for ( ; a_width > l_len; a_width-- )
+		*(a_out++) = a_fill;
+
+	memcpy(a_out, l_buf + sizeof(l_buf) - l_len, l_len);
+
+	return	a_out + l_len;
+}
+
+/* Put string up to the end of buffer, NULL is put as "(null)" like by the snprintf() */
+inline static char	*s_put_str	(
+		char	*a_out,
+	const char	*a_end,
+	const char	*a_str
+			)
+{
+size_t	l_len;
+
+	if ( !a_str )
+		a_str = "(null)";
+
+	l_len = strnlen(a_str, (a_end > a_out) ? a_end - a_out : 0);
+	memcpy(a_out, a_str, l_len);
+
+	return	a_out + l_len;
+}
+
+/*
+ * Put "DD-MM-YYYY HH:MM:SS.msec <tid> " prefix of the log record, is the same as
+ * the "%02u-%02u-%04u %02u:%02u:%02u.%03u " UTIL$T_PID_FMT format, return an address of the next character.
+ */
+static char	*s_util_tsprefix	(
+		char	*a_out,
+	const struct tm	*a_tm,
+	const struct timespec *a_now
+			)
+{
+	a_out = s_put_udec(a_out, a_tm->tm_mday, 2, '0');
+	*(a_out++) = '-';
+	a_out = s_put_udec(a_out, a_tm->tm_mon + 1, 2, '0');
+	*(a_out++) = '-';
+	a_out = s_put_udec(a_out, 1900 + a_tm->tm_year, 4, '0');
+	*(a_out++) = ' ';
+	a_out = s_put_udec(a_out, a_tm->tm_hour, 2, '0');
+	*(a_out++) = ':';
+	a_out = s_put_udec(a_out, a_tm->tm_min, 2, '0');
+	*(a_out++) = ':';
+	a_out = s_put_udec(a_out, a_tm->tm_sec, 2, '0');
+	*(a_out++) = '.';
+	a_out = s_put_udec(a_out, (unsigned) a_now->tv_nsec/TIMSPECDEVIDER, 3, '0');
+	*(a_out++) = ' ';
+	a_out = s_put_udec(a_out, (unsigned) __gettid(), 6, ' ');
+	*(a_out++) = ' ';
+
+	return	a_out;
+}
+
+/*
+ * Put "[<mod>\<func>:<line>] " or "[<func>:<line>] " part of the log record prefix,
+ * return an address of the next character.
+ */
+static char	*s_util_siteprefix	(
+		char	*a_out,
+	const char	*a_end,
+	const char	*a_mod,
+	const char	*a_func,
+		unsigned a_line
+			)
+{
+	*(a_out++) = '[';
+
+	if ( a_mod )
+		{
+		a_out = s_put_str(a_out, a_end, a_mod);
+		*(a_out++) = '\\';
+		}
+
+	a_out = s_put_str(a_out, a_end, a_func);
+	*(a_out++) = ':';
+	a_out = s_put_udec(a_out, a_line, 0, ' ');
+	*(a_out++) = ']';
+	*(a_out++) = ' ';
+
+	return	a_out;
+}
+
+
+
+unsigned	__util$putmsg
+			(
+		unsigned	sts,
+			...
+			)
+
+{
+va_list arglist;
+char	out[UTIL$SZ_OUTBUF + 8];
+int	olen, sev;
+struct tm _tm;
+struct timespec now;
+EMSG_RECORD *msgrec;
+
+	/*
+	** Out to buffer "DD-MM-YYYY HH:MM:SS.msec <PID/TID> " prefix
+	*/
+	s___time(&now);
+
+#ifdef	WIN32
+	localtime_s(&_tm, (time_t *)&now);
+#else
+	localtime_r((time_t *)&now, &_tm);
+#endif
+
+	olen = (s_logmode == UTIL$K_LOGMODE_JSON) ? 0 : s_util_tsprefix(out, &_tm, &now) - out;	/* Format a prefix part of the message: time + PID ... */
+
+	if ( 1 & __util$getmsg(sts, &msgrec) )				/* Retreive the message record */
+		{
+		va_start (arglist, sts);				/* Format text message */
+		olen += vsnprintf(out + olen, UTIL$SZ_OUTBUF - olen, msgrec->text, arglist);
+		va_end (arglist);
+		}
+	else	{							/* Format text message with the default FAO */
+		sev = $SEV(sts);
+		olen += snprintf(out + olen, UTIL$SZ_OUTBUF - olen, defmsgfao, severity[sev], sts,
+			$FAC(sts), $FAC(sts), sev, sev, $MSG(sts), $MSG(sts));
+		}
+
+
+	if ( s_logmode == UTIL$K_LOGMODE_JSON )				/* Convert the record to the JSON object */
+		olen = s_util_jsonrec(out, UTIL$SZ_OUTBUF, $MIN(olen, UTIL$SZ_OUTBUF), &now, NULL, $SEV(sts), sts, NULL, NULL, 0);
+
+	/* Add <LF> at end of record*/
+	out[olen++] = '\n';
+
+	/* Keep a copy of the record in the flight recorder's ring */
+	__util$frec_put(out, olen);
+
+	/* Write to file and flush buffer depending on severity level */
+	write (g_logoutput, out, olen);
+
+	/* ARL - for android logcat */
+	#ifdef ANDROID_LOGCAT
+		__android_log_print(ANDROID_LOG_VERBOSE, " --- ", "%.*s", olen, out);
+	#endif
+
+	return	sts;
+}
+
+unsigned	__util$putmsgd
+			(
+		unsigned	sts,
+		const char *	__mod,
+		const char *	__fi,
+		unsigned	__li,
+			...
+			)
+
+{
+va_list arglist;
+char	out[UTIL$SZ_OUTBUF + 8];
+size_t olen, sev;
+struct tm _tm;
+struct timespec now;
+EMSG_RECORD *msgrec;
+
+	/*
+	** Out to buffer "DD-MM-YYYY HH:MM:SS.msec <PID/TID> " prefix
+	*/
+	s___time(&now);
+
+#ifdef	WIN32
+	localtime_s(&_tm, (time_t *)&now);
+#else
+	localtime_r((time_t *)&now, &_tm);
+#endif
+
+	olen = (s_logmode == UTIL$K_LOGMODE_JSON) ? 0
+		: s_util_siteprefix(s_util_tsprefix(out, &_tm, &now), out + UTIL$SZ_OUTBUF / 2, __mod, __fi, __li) - out;
 
 	olen = $MIN(UTIL$SZ_OUTBUF, olen);
 
@@ -428,9 +1105,15 @@ EMSG_RECORD *msgrec;
 
 	olen = $MIN(UTIL$SZ_OUTBUF, olen);
 
+	if ( s_logmode == UTIL$K_LOGMODE_JSON )				/* Convert the record to the JSON object */
+		olen = s_util_jsonrec(out, UTIL$SZ_OUTBUF, olen, &now, NULL, $SEV(sts), sts, __mod, __fi, __li);
+
 	/* Add <LF> at end of record*/
 	out[olen++] = '\n';
 
+	/* Keep a copy of the record in the flight recorder's ring */
+	__util$frec_put(out, olen);
+
 	/* Write to file and flush buffer depending on severity level */
 	write (g_logoutput, out, olen);
 
@@ -447,7 +1130,7 @@ EMSG_RECORD *msgrec;
 
 
 
-unsigned	__util$logd
+static unsigned	s_util_vlogd
 			(
 		const char *	fac,
 		unsigned	sev,
@@ -455,16 +1138,17 @@ unsigned	__util$logd
 		const char *	__mod,
 		const char *	__func,
 		unsigned	__line,
-			...
+		va_list		arglist
 			)
 
 {
-va_list arglist;
-const char	__fmt [] = {"%02u-%02u-%04u %02u:%02u:%02u.%03u "  UTIL$T_PID_FMT "[%s\\%s:%u] %%%s-%c:  "};
-char	out[UTIL$SZ_OUTBUF + 8];
+char	out[UTIL$SZ_OUTBUF + 8], *cp;
 unsigned olen, _sev = $SEV(sev);
 #ifdef	__SYSLOG__
 unsigned opcom = sev & STS$M_SYSLOG;
+va_list arglist2;
+
+	va_copy(arglist2, arglist);
 #endif
 struct tm _tm = {0};
 struct timespec now = {0};
@@ -472,6 +1156,9 @@ struct timespec now = {0};
 
 	sev &= ~STS$M_SYSLOG;
 
+	if ( unlikely(s_tpnt_reload) )					/* Reload trace points control file on request */
+		__util$tpnt_poll();
+
 	/*
 	** Out to buffer "DD-MM-YYYY HH:MM:SS.msec [<function>\<line>]-E-:" prefix
 	*/
@@ -483,19 +1170,31 @@ struct timespec now = {0};
 	localtime_r((time_t *)&now, &_tm);
 #endif
 
-	olen = snprintf (out, UTIL$SZ_OUTBUF, __fmt, _tm.tm_mday, _tm.tm_mon + 1, 1900 + _tm.tm_year,
-			_tm.tm_hour, _tm.tm_min, _tm.tm_sec, (unsigned) now.tv_nsec/TIMSPECDEVIDER,
-			(unsigned) __gettid(), __mod, __func, __line, fac, severity[_sev]);
+	if ( s_logmode != UTIL$K_LOGMODE_JSON )
+		{
+		cp = s_util_siteprefix(s_util_tsprefix(out, &_tm, &now), out + UTIL$SZ_OUTBUF / 2, __mod ? __mod : "(null)", __func, __line);
+		*(cp++) = '%';
+		cp = s_put_str(cp, out + UTIL$SZ_OUTBUF / 2, fac);
+		*(cp++) = '-';
+		*(cp++) = severity[_sev];
+		memcpy(cp, ":  ", 3);
+		olen = (cp + 3) - out;
+		}
+	else	olen = 0;
 
-	va_start (arglist, __line);
 	olen += vsnprintf(out + olen, UTIL$SZ_OUTBUF - olen, fmt, arglist);
-	va_end (arglist);
 
 	olen = $MIN(olen, UTIL$SZ_OUTBUF - 1);
 
+	if ( s_logmode == UTIL$K_LOGMODE_JSON )				/* Convert the record to the JSON object */
+		olen = s_util_jsonrec(out, UTIL$SZ_OUTBUF, olen, &now, fac, _sev, 0, __mod, __func, __line);
+
 	/* Add <LF> at end of record*/
 	out[olen++] = '\n';
 
+	/* Keep a copy of the record in the flight recorder's ring */
+	__util$frec_put(out, olen);
+
 	/* Write to file and flush buffer depending on severity level */
 	write (g_logoutput, out, olen );
 
@@ -507,75 +1206,213 @@ struct timespec now = {0};
 
 #ifdef	__SYSLOG__
 #ifndef	WIN32
-	va_start (arglist, __li);
-	olen = vsnprintf(out, UTIL$SZ_OUTBUF, fmt, arglist);
-	va_end (arglist);
+	olen = vsnprintf(out, UTIL$SZ_OUTBUF, fmt, arglist2);
 
 	__util$syslog (LOG_USER, LOG_DEBUG, fac, out, olen);
 
 //	syslog( LOG_PID | ((sev & 1) ? LOG_INFO : LOG_ERR), "%.*s", olen, out);
 #endif
+	va_end (arglist2);
 #endif	/* __SYSLOG__ */
 
 	return	sev;
 }
 
+unsigned	__util$logd
+			(
+		const char *	fac,
+		unsigned	sev,
+		const char *	fmt,
+		const char *	__mod,
+		const char *	__func,
+		unsigned	__line,
+			...
+			)
+
+{
+va_list arglist;
 
+	va_start (arglist, __line);
+	sev = s_util_vlogd(fac, sev, fmt, __mod, __func, __line, arglist);
+	va_end (arglist);
 
+	return	sev;
+}
 
+/*
+ * Per call site rate limiting of the $LOGRL: every call site owns a static UTIL_LOGRL descriptor,
+ * the limit is checked by GCRA (an equivalent of the token bucket) on the single 64-bits
+ * "theoretical arrival time" word, so no locks are need. Suppressed messages are counted
+ * and reported as "Last message repeated N times" by the next passed message from the site or
+ * by the __util$logrl_flush().
+ */
+static UTIL_LOGRL	*s_logrl_root;				/* A list of the registered call sites		*/
 
+/* Put "repeated N times" record if some messages have been suppressed at the call site */
+static void	s_logrl_summary	(
+		UTIL_LOGRL	*a_site
+			)
+{
+unsigned	l_count;
 
+	if ( (l_count = __atomic_exchange_n(&a_site->suppressed, 0, __ATOMIC_RELAXED)) )
+		__util$logd(a_site->fac, STS$K_INFO, "Last message repeated %u times", a_site->mod, a_site->func, a_site->line, l_count);
+}
 
 /*
+ *++
+ *  Description: a rate limited version of the __util$logd(), is supposed to be called from
+ *	the $LOGRL macro.
  *
- *  Description: a simplified analog of the C RTL syslog() routine is supposed to used to
- *	format and send a message directly to IP (has been defined by $deflog();
- *
- *  Usage:
- *	__util$deflog(NULL, "172.28.4.112");
- *	...
- *	char msg [] = "GAMEOVER, all your base are belong to us";
- *	__util$syslog(LOG_KERN, LOG_DEBUG, "NOXBIT", msg, sizeof(msg));
- *
- *  Input:
- *	fac:	SYSLOG Facility code, see LOG_* constants
- *	pri:	SYSLOG Severity code, see LOG_* constants
- *	tag:	A tag string - a part of the MSG part :-)
- *	msg:	message buffer to be send
- *	msglen:	message length
- *
- *
- *  Return:
- *	STS$K_SUCCESS
+ * Input:
+ *	site:	A call site's descriptor
+ *	fac:	A facility name
+ *	sev:	A severity level
+ *	fmt:	A format string
+ *	__mod:	A module name
+ *	__func:	A function name
+ *	__line:	Line number in the source file
+ *	...	Format string arguments
+ * Output:
+ *	NONE
+ * Return:
+ *	sev
  *
+ *--
  */
-
-unsigned	__util$syslog
-		(
-		int		fac,
-		int		sev,
-		const char *	tag,
-		const char *	msg,
-		int		msglen
-		)
+unsigned	__util$logrl
+			(
+		UTIL_LOGRL *	site,
+		const char *	fac,
+		unsigned	sev,
+		const char *	fmt,
+		const char *	__mod,
+		const char *	__func,
+		unsigned	__line,
+			...
+			)
 {
-static int	sd = -1;
-char	buf[128];
+va_list arglist;
+struct timespec now;
+unsigned long long l_now, l_tat, l_newtat, l_ival, l_tolerance;
 
-#ifdef	_WIN32
+	/* Link new call site into the list for __util$logrl_flush() */
+	if ( unlikely(site->state != 2) && $CMP_STORE_LONG(&site->state, 0, 1) )
+		{
+		site->fac = fac;
+		site->mod = __mod;
+		site->func = __func;
+		site->line = __line;
 
-WSAMSG msg_desc = { 0 };
-WSABUF   bufv[] = {{0, buf, }, {msglen, msg}};
+		do	site->link = s_logrl_root;
+		while ( !__sync_bool_compare_and_swap(&s_logrl_root, site->link, site) );
 
-#else
-struct	iovec bufv[] = {{buf, 0}, {(void *) msg, msglen}};
-struct	msghdr  msg_desc = {0};
-#endif
+		__atomic_store_n(&site->state, 2, __ATOMIC_RELEASE);
+		}
 
+	s___time(&now);
+	l_now = now.tv_sec * 1000000000ULL + now.tv_nsec;
 
-	if ( sd == -1 )
-		{
-		/*
+	l_ival = 1000000000ULL / (site->rate ? site->rate : 1);
+	l_tolerance = l_ival * (site->burst ? site->burst : 1);
+
+	/* GCRA: pass if the bucket is not empty, take a token by advancing TAT on the one emission interval */
+	do	{
+		l_tat = __atomic_load_n(&site->tat, __ATOMIC_RELAXED);
+		l_newtat = ((l_tat > l_now) ? l_tat : l_now) + l_ival;
+
+		if ( (l_newtat - l_now) > l_tolerance )
+			{
+			__atomic_fetch_add(&site->suppressed, 1, __ATOMIC_RELAXED);
+			return	sev & ~STS$M_SYSLOG;
+			}
+
+		} while ( !__atomic_compare_exchange_n(&site->tat, &l_tat, l_newtat, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED) );
+
+	s_logrl_summary(site);
+
+	va_start (arglist, __line);
+	sev = s_util_vlogd(fac, sev, fmt, __mod, __func, __line, arglist);
+	va_end (arglist);
+
+	return	sev;
+}
+
+/*
+ *   DESCRIPTION: Put "repeated N times" records for all call sites have suppressed messages,
+ *	is supposed to be called periodically, eg. from a timer or housekeeping thread.
+ *
+ *   RETURNS:
+ *	STS$K_SUCCESS
+ */
+int	__util$logrl_flush	(void)
+{
+UTIL_LOGRL	*l_site;
+
+	for ( l_site = __atomic_load_n(&s_logrl_root, __ATOMIC_ACQUIRE); l_site; l_site = l_site->link )
+		if ( __atomic_load_n(&l_site->state, __ATOMIC_ACQUIRE) == 2 )
+			s_logrl_summary(l_site);
+
+	return	STS$K_SUCCESS;
+}
+
+
+
+
+
+
+
+
+/*
+ *
+ *  Description: a simplified analog of the C RTL syslog() routine is supposed to used to
+ *	format and send a message directly to IP (has been defined by $deflog();
+ *
+ *  Usage:
+ *	__util$deflog(NULL, "172.28.4.112");
+ *	...
+ *	char msg [] = "GAMEOVER, all your base are belong to us";
+ *	__util$syslog(LOG_KERN, LOG_DEBUG, "NOXBIT", msg, sizeof(msg));
+ *
+ *  Input:
+ *	fac:	SYSLOG Facility code, see LOG_* constants
+ *	pri:	SYSLOG Severity code, see LOG_* constants
+ *	tag:	A tag string - a part of the MSG part :-)
+ *	msg:	message buffer to be send
+ *	msglen:	message length
+ *
+ *
+ *  Return:
+ *	STS$K_SUCCESS
+ *
+ */
+
+unsigned	__util$syslog
+		(
+		int		fac,
+		int		sev,
+		const char *	tag,
+		const char *	msg,
+		int		msglen
+		)
+{
+static int	sd = -1;
+char	buf[128];
+
+#ifdef	_WIN32
+
+WSAMSG msg_desc = { 0 };
+WSABUF   bufv[] = {{0, buf, }, {msglen, msg}};
+
+#else
+struct	iovec bufv[] = {{buf, 0}, {(void *) msg, msglen}};
+struct	msghdr  msg_desc = {0};
+#endif
+
+
+	if ( sd == -1 )
+		{
+		/*
 		inet_aton("172.28.4.112", &slogsock.sin_addr);
 		slogsock.sin_port = htons(514);
 		slogsock.sin_family = AF_INET;
@@ -747,10 +1584,7 @@ OPTS	*optp, *optp2;
 	*/
 	for ( i = 1; fgets(buf, sizeof(buf), finp); i++ )
 		{
-		if ( !__util$uncomment(buf, (int) strlen(buf), '!') )
-			continue;
-
-		if ( !__util$trim(buf, (int) strlen(buf)) )
+		if ( !__util$sv_normalize(buf, strlen(buf), '!', 0, buf, sizeof(buf)).len )
 			continue;
 
 		if ( (*(argp = buf) != '-') && (*(argp = buf) != '/') )
@@ -778,11 +1612,7 @@ OPTS	*optp, *optp2;
 		*/
 		for (optp2 = NULL, optp = opts; $ASCLEN(&optp->name); optp++)
 			{
-#if _WIN32
-			if ( !(_strnicmp (argp, $ASCPTR(&optp->name), $MIN(argslen, $ASCLEN(&optp->name)))) )
-#else
-			if ( !(strncasecmp (argp, $ASCPTR(&optp->name), $MIN(argslen, $ASCLEN(&optp->name)))) )
-#endif
+			if ( !__util$memcmp_blind(argp, $ASCPTR(&optp->name), $MIN(argslen, $ASCLEN(&optp->name))) )
 				{
 				if ( argslen == $ASCLEN(&optp->name) )	/* Full matching */
 					{
@@ -948,11 +1778,7 @@ OPTS	*optp;
 			if ( argslen != $ASCLEN(&optp->name) )
 				continue;
 
-#if _WIN32
-			if ( !(_strnicmp (argp, $ASCPTR(&optp->name), $MIN(argslen, $ASCLEN(&optp->name)))) )
-#else
-			if ( !(strncasecmp (argp, $ASCPTR(&optp->name), $MIN(argslen, $ASCLEN(&optp->name)))) )
-#endif
+			if ( !__util$memcmp_blind(argp, $ASCPTR(&optp->name), $MIN(argslen, $ASCLEN(&optp->name))) )
 				break;
 			}
 
@@ -1032,9 +1858,162 @@ OPTS	*optp;
 }
 
 
+#define		UTILS$SZ_HEXWIDTH	80			/* A width of the dump line */
+
+/*
+ *++
+ *  Description: format a block of the lines of the hex dump, is supposed to be used
+ *	for streaming dump of the large buffers. Only whole lines are formatted, the last
+ *	line can be partial if the rest of the source buffer is less than 16 octets.
+ *
+ * Input:
+ *	src:	A pointer to source buffer  do be dumped
+ *	srclen:	A Length of the source buffer
+ *	offset:	An offset of the source buffer's first octet to be shown in the dump
+ *	out:	A buffer to accept formatted lines
+ *	outsz:	A size of the output buffer
+ *
+ * Output:
+ *	outlen:	A length of the formatted lines in the output buffer
+ *
+ * Return:
+ *	A number of the octets has been consumed from the source buffer
+ *
+ *--
+ */
+size_t	__util$faohexl	(
+	const void *	a_src,
+		size_t	a_srclen,
+		size_t	a_offset,
+		char *	a_out,
+		size_t	a_outsz,
+		size_t *a_outlen
+			)
+{
+const unsigned char *l_src = (const unsigned char *) a_src;
+size_t	l_consumed = 0, l_off;
+unsigned l_width, l_plen, l_digits, l_cnt, j;
+unsigned char	l_hex[32], l_asc[16], l_high, l_low;
+char	*l_out = a_out;
+#ifdef	__SSE2__
+__m128i	l_v, l_hi, l_lo, l_mask, l_nine = _mm_set1_epi8(9), l_0f = _mm_set1_epi8(0x0f),
+	l_zero = _mm_set1_epi8('0'), l_adj = _mm_set1_epi8('a' - 10 - '0'),
+	l_lwb = _mm_set1_epi8(0x1f), l_upb = _mm_set1_epi8(0x7f), l_dot = _mm_set1_epi8('.');
+#endif
+
+	for ( *a_outlen = 0; l_consumed < a_srclen; l_consumed += l_cnt, l_src += l_cnt )
+		{
+		/* Compute a number of hex digits of the offset field: "%04x" */
+		for ( l_off = a_offset + l_consumed, l_digits = 4; (l_digits < 2 * sizeof(size_t)) && (l_off >> (4 * l_digits)); l_digits++);
+
+		/* "\t+" <offset> ":  " <16 * "xx "> " " <16 * "c"> <spaces> <LF> */
+		l_plen = 2 + l_digits + 3;
+		l_width = $MAX(UTILS$SZ_HEXWIDTH, l_plen + 16 * 3 + 2 + 16 + 1);
+
+		if ( (size_t) (l_out - a_out) + l_width > a_outsz )
+			break;
+
+		l_cnt = (a_srclen - l_consumed < 16) ? (unsigned) (a_srclen - l_consumed) : 16;
+
+		memset(l_out, ' ', l_width);
+
+		l_out[0] = '\t';
+		l_out[1] = '+';
+		for ( j = 0; j < l_digits; j++ )
+			l_out[2 + j] = "0123456789abcdef"[(l_off >> (4 * (l_digits - 1 - j))) & 0x0f];
+		l_out[2 + l_digits] = ':';
+
+		if ( l_cnt == 16 )
+			{
+#ifdef	__SSE2__
+			/* Convert 16 octets to the 32 hex digits and 16 printable characters at once */
+			l_v = _mm_loadu_si128((const __m128i *) l_src);
+
+			l_hi = _mm_and_si128(_mm_srli_epi16(l_v, 4), l_0f);
+			l_lo = _mm_and_si128(l_v, l_0f);
+
+			l_hi = _mm_add_epi8(_mm_add_epi8(l_hi, l_zero), _mm_and_si128(_mm_cmpgt_epi8(l_hi, l_nine), l_adj));
+			l_lo = _mm_add_epi8(_mm_add_epi8(l_lo, l_zero), _mm_and_si128(_mm_cmpgt_epi8(l_lo, l_nine), l_adj));
+
+			_mm_storeu_si128((__m128i *) l_hex, _mm_unpacklo_epi8(l_hi, l_lo));
+			_mm_storeu_si128((__m128i *) (l_hex + 16), _mm_unpackhi_epi8(l_hi, l_lo));
+
+			/* 0x20 - 0x7e are printable, octets with high bit set are negative in the signed compare */
+			l_mask = _mm_and_si128(_mm_cmpgt_epi8(l_v, l_lwb), _mm_cmplt_epi8(l_v, l_upb));
+			_mm_storeu_si128((__m128i *) l_asc, _mm_or_si128(_mm_and_si128(l_mask, l_v), _mm_andnot_si128(l_mask, l_dot)));
+#else
+			for ( j = 0; j < 16; j++ )
+				{
+				l_high = l_src[j] >> 4;
+				l_low = l_src[j] & 0x0f;
+
+				l_hex[j * 2] = l_high + ((l_high < 10) ? '0' : 'a' - 10);
+				l_hex[j * 2 + 1] = l_low + ((l_low < 10) ? '0' : 'a' - 10);
+				l_asc[j] = ((l_src[j] > 0x1f) && (l_src[j] < 0x7f)) ? l_src[j] : '.';
+				}
+#endif
+			for ( j = 0; j < 16; j++ )
+				memcpy(l_out + l_plen + j * 3, l_hex + j * 2, 2);
+
+			memcpy(l_out + l_plen + 16 * 3 + 2, l_asc, 16);
+			}
+		else	{
+			for ( j = 0; j < l_cnt; j++ )
+				{
+				l_high = l_src[j] >> 4;
+				l_low = l_src[j] & 0x0f;
+
+				l_out[l_plen + j * 3] = l_high + ((l_high < 10) ? '0' : 'a' - 10);
+				l_out[l_plen + j * 3 + 1] = l_low + ((l_low < 10) ? '0' : 'a' - 10);
+
+				l_out[l_plen + 16 * 3 + 2 + j] = ((l_src[j] > 0x1f) && (l_src[j] < 0x7f)) ? l_src[j] : '.';
+				}
+			}
+
+		/* Add <LF> at end of record*/
+		l_out[l_width - 1] = '\n';
+		l_out += l_width;
+		}
+
+	*a_outlen = l_out - a_out;
+
+	return	l_consumed;
+}
+
+
+/* Write a whole buffer to the log device, resume on partial write */
+static void	s_util_logwrite	(
+	const char *	a_buf,
+		size_t	a_len
+			)
+{
+ssize_t	l_rc;
+
+	if ( p_cb_log_f )
+		{
+		p_cb_log_f(a_buf, (unsigned) a_len);
+		return;
+		}
+
+	for ( ; a_len; a_buf += l_rc, a_len -= l_rc )
+		if ( 0 >= (l_rc = write (g_logoutput, a_buf, a_len)) )
+			{
+			if ( (l_rc < 0) && (errno == EINTR) )
+				{
+				l_rc = 0;
+				continue;
+				}
+
+			break;
+			}
+}
+
+
 /*
  *++
  *  Description: dump byte array to sys$output in hex, is supposed to be called indirectly by $DUMPHEX macro.
+ *	The dump lines are formatted into the big buffer and written by a single write()
+ *	(or a series of write() for the very large source buffer).
  *
  * Input:
  *	__fi:	A file name or module name string
@@ -1049,19 +2028,16 @@ OPTS	*optp;
  *
  *--
  */
-
-void	__util$dumphex	(
+void	__util$dumphexl	(
 		const char *	a__fi,
 		unsigned	a__li,
 		const void *	a_src,
-		unsigned short	a_srclen
+		size_t		a_srclen
 			)
 {
-const char	l_fmt [] = {"%02u-%02u-%04u %02u:%02u:%02u.%03u "  UTIL$T_PID_FMT "[%s:%u] Dump of %u octets follows:"};
-#define		UTILS$SZ_HEXWIDTH	80
-char	l_out[256];
-unsigned char *l_src = (unsigned char *) a_src, l_low, l_high;
-unsigned l_olen = 0, i, j;
+const char	l_fmt [] = {"%02u-%02u-%04u %02u:%02u:%02u.%03u "  UTIL$T_PID_FMT "[%s:%u] Dump of %zu octets follows:"};
+char	l_buf[UTIL$K_DUMPHEX_BUFSZ], *l_out = l_buf;
+size_t	l_outsz = sizeof(l_buf), l_olen, l_done, l_cnt;
 struct tm l_tm;
 struct timespec l_now;
 
@@ -1076,7 +2052,7 @@ struct timespec l_now;
 	localtime_r((time_t *)&l_now, &l_tm);
 #endif
 
-	l_olen = snprintf (l_out, sizeof(l_out) - 1, l_fmt,
+	l_olen = snprintf (l_buf, 255, l_fmt,
 		l_tm.tm_mday, l_tm.tm_mon + 1, 1900 + l_tm.tm_year,
 		l_tm.tm_hour, l_tm.tm_min, l_tm.tm_sec, (unsigned) l_now.tv_nsec/TIMSPECDEVIDER,
 		(unsigned) __gettid(),
@@ -1084,71 +2060,61 @@ struct timespec l_now;
 
 
 	/* Add <LF> at end of record*/
-	l_olen = $MIN(sizeof(l_out) - 1, l_olen);
-	l_out[l_olen++] = '\n';
-
-	if ( p_cb_log_f )
-		p_cb_log_f(l_out, l_olen);
-	else	write (g_logoutput, l_out, l_olen );
+	l_olen = $MIN(255, l_olen);
+	l_buf[l_olen++] = '\n';
 
-	memset(l_out, ' ', UTILS$SZ_HEXWIDTH);
+	/* Keep a copy of the record in the flight recorder's ring */
+	__util$frec_put(l_buf, (unsigned) l_olen);
 
 	/*
-	** Format variable part of string line
+	** A big dump is formatted into the heap buffer to be written at once, fallback to
+	** the stack buffer if the memory cannot be allocated.
 	*/
-	for (i = 0; i < ((a_srclen / 16));  i++)
-		{
-		l_olen = snprintf(l_out, UTILS$SZ_HEXWIDTH, "\t+%04x:  ", i * 16);
-		l_olen = $MIN(UTILS$SZ_HEXWIDTH - 1, l_olen);
+	l_cnt = l_olen + (a_srclen / 16 + 1) * (UTILS$SZ_HEXWIDTH + 8);
 
-		memset(l_out + l_olen, ' ', UTILS$SZ_HEXWIDTH - l_olen);
+	if ( l_cnt > sizeof(l_buf) )
+		{
+		l_cnt = (l_cnt < UTIL$K_DUMPHEX_MAXBATCH) ? l_cnt : UTIL$K_DUMPHEX_MAXBATCH;
 
-		for (j = 0; j < 16; j++, l_src++)
+		if ( (l_out = malloc(l_cnt)) )
 			{
-			l_high = (*l_src) >> 4;
-			l_low = (*l_src) & 0x0f;
-
-			l_out[l_olen + j * 3] = l_high + ((l_high < 10) ? '0' : 'a' - 10);
-			l_out[l_olen + j * 3 + 1] = l_low + ((l_low < 10) ? '0' : 'a' - 10);
-
-			l_out[l_olen + 16*3 + 2 + j] = isprint(*l_src) ? *l_src : '.';
+			memcpy(l_out, l_buf, l_olen);
+			l_outsz = l_cnt;
 			}
-
-		/* Add <LF> at end of record*/
-		l_out[UTILS$SZ_HEXWIDTH - 1] = '\n';
-
-		/* Write to file and flush buffer depending on severity level */
-		if ( p_cb_log_f )
-			p_cb_log_f(l_out, UTILS$SZ_HEXWIDTH);
-		else	write (g_logoutput, l_out, UTILS$SZ_HEXWIDTH );
+		else	l_out = l_buf;
 		}
 
-	if ( a_srclen % 16 )
+	for ( l_done = 0; ; l_olen = 0)
 		{
-		l_olen = snprintf(l_out, UTILS$SZ_HEXWIDTH, "\t+%04x:  ", i * 16);
-		l_olen = $MIN(UTILS$SZ_HEXWIDTH - 1, l_olen);
+		l_done += __util$faohexl((const unsigned char *) a_src + l_done, a_srclen - l_done, l_done,
+			l_out + l_olen, l_outsz - l_olen, &l_cnt);
 
-		memset(l_out + l_olen, ' ', UTILS$SZ_HEXWIDTH - l_olen);
+		s_util_logwrite(l_out, l_olen + l_cnt);
 
-		for (j = 0; j < a_srclen % 16; j++, l_src++)
-			{
-			l_high = (*l_src) >> 4;
-			l_low = (*l_src) & 0x0f;
-
-			l_out[l_olen + j * 3] = l_high + ((l_high < 10) ? '0' : 'a' - 10);
-			l_out[l_olen + j * 3 + 1] = l_low + ((l_low < 10) ? '0' : 'a' - 10);
+		if ( l_done >= a_srclen )
+			break;
+		}
 
-			l_out[l_olen + 16*3 + 2 + j] = isprint(*l_src) ? *l_src : '.';
-			}
+	if ( l_out != l_buf )
+		free(l_out);
+}
 
-		/* Add <LF> at end of record*/
-		l_out[UTILS$SZ_HEXWIDTH - 1] = '\n';
 
-		/* Write to file and flush buffer depending on severity level */
-		if ( p_cb_log_f )
-			p_cb_log_f(l_out, UTILS$SZ_HEXWIDTH);
-		else	write (g_logoutput, l_out, UTILS$SZ_HEXWIDTH );
-		}
+/*
+ *++
+ *  Description: dump byte array to sys$output in hex, the 16-bits length version
+ *	is kept for compatibility, see __util$dumphexl().
+ *
+ *--
+ */
+void	__util$dumphex	(
+		const char *	a__fi,
+		unsigned	a__li,
+		const void *	a_src,
+		unsigned short	a_srclen
+			)
+{
+	__util$dumphexl(a__fi, a__li, a_src, a_srclen);
 }
 
 
@@ -1226,27 +2192,23 @@ unsigned j;
  */
 static const	char spaces[64] = {"                                                                "};
 
-void	__util$trace	(
-			int	cond,
+static void	s_util_vtrace	(
 		const char *	fmt,
 		const char *	__mod,
 		const char *	__fi,
 		unsigned	__li,
-			...
+		va_list		arglist
 			)
 {
-va_list arglist;
-
-const char	lfmt [] = {"%02u-%02u-%04u %02u:%02u:%02u.%03u "  UTIL$T_PID_FMT "[%s:%u] "},
-	mfmt [] = {"%02u-%02u-%04u %02u:%02u:%02u.%03u "  UTIL$T_PID_FMT "[%s\\%s:%u] "};
 char	out[1024];
 int	olen, len;
 struct tm _tm;
 struct timespec now;
+#ifdef	__SYSLOG__
+va_list arglist2;
 
-	if ( !cond )
-		return;
-
+	va_copy(arglist2, arglist);
+#endif
 
 	/*
 	** Out to buffer "DD-MM-YYYY HH:MM:SS.msec [<function>\<line>]" prefix
@@ -1259,15 +2221,10 @@ struct timespec now;
 	localtime_r((time_t *)&now, &_tm);
 #endif
 
-	olen = __mod
-		? snprintf (out, sizeof(out), mfmt, _tm.tm_mday, _tm.tm_mon + 1, 1900 + _tm.tm_year,
-		_tm.tm_hour, _tm.tm_min, _tm.tm_sec, (unsigned) now.tv_nsec/TIMSPECDEVIDER,
-			(unsigned) __gettid(), __mod, __fi, __li)
-		: snprintf (out, sizeof(out), lfmt, _tm.tm_mday, _tm.tm_mon + 1, 1900 + _tm.tm_year,
-			_tm.tm_hour, _tm.tm_min, _tm.tm_sec, (unsigned) now.tv_nsec/TIMSPECDEVIDER,
-			(unsigned) __gettid(), __fi, __li);
+	olen = (s_logmode == UTIL$K_LOGMODE_JSON) ? 0
+		: s_util_siteprefix(s_util_tsprefix(out, &_tm, &now), out + sizeof(out) / 2, __mod, __fi, __li) - out;
 
-	if ( 0 < (len = (72 - olen)) )
+	if ( olen && (0 < (len = (72 - olen))) )
 		{
 		memcpy(out + olen, spaces, len);
 		olen += len;
@@ -1276,15 +2233,19 @@ struct timespec now;
 	/*
 	** Format variable part of string line
 	*/
-	va_start (arglist, __li);
 	olen += vsnprintf(out + olen, sizeof(out) - olen, fmt, arglist);
-	va_end (arglist);
 
 	olen = $MIN(olen, sizeof(out) - 1);
 
+	if ( s_logmode == UTIL$K_LOGMODE_JSON )				/* Convert the record to the JSON object */
+		olen = s_util_jsonrec(out, sizeof(out) - 1, olen, &now, NULL, -1, 0, __mod, __fi, __li);
+
 	/* Add <LF> at end of record*/
 	out[olen++] = '\n';
 
+	/* Keep a copy of the record in the flight recorder's ring */
+	__util$frec_put(out, olen);
+
 	/* Write to file and flush buffer */
 	if ( p_cb_log_f )
 		p_cb_log_f(out, olen);
@@ -1299,71 +2260,412 @@ struct timespec now;
 
 #ifdef	__SYSLOG__
 #ifndef	WIN32
-	va_start (arglist, __li);
-	olen = vsnprintf(out, sizeof(out), fmt, arglist);
-	va_end (arglist);
+	olen = vsnprintf(out, sizeof(out), fmt, arglist2);
 
 	__util$syslog (LOG_USER, LOG_DEBUG, __mod, out, olen);
 
 //	syslog( LOG_PID | ((sev & 1) ? LOG_INFO : LOG_ERR), "%.*s", olen, out);
 #endif
+	va_end (arglist2);
 #endif	/* __SYSLOG__ */
 
 }
 
-
-unsigned	__util$log
-			(
-		const char *	fac,
-		unsigned	sev,
+void	__util$trace	(
+			int	cond,
 		const char *	fmt,
+		const char *	__mod,
+		const char *	__fi,
+		unsigned	__li,
 			...
 			)
-
 {
 va_list arglist;
-const char lfmt [] = "%02u-%02u-%04u %02u:%02u:%02u.%03u " UTIL$T_PID_FMT "%%%s-%C: ";
-char	out[UTIL$SZ_OUTBUF + 8];
-unsigned olen, _sev = $SEV(sev), opcom = sev & STS$M_SYSLOG;
-struct tm _tm;
-struct timespec now;
 
-	/*
-	** Some sanity check
-	*/
-	if ( !($ISINRANGE(sev, STS$K_WARN, STS$K_ERROR)) )
-		sev = STS$K_UNDEF;
+	if ( !cond )
+		return;
 
-	/*
-	** Out to buffer "DD-MM-YYYY HH:MM:SS.msec [<function>\<line>]<FAC>-E:" prefix
-	*/
-	s___time(&now);
+	va_start (arglist, __li);
+	s_util_vtrace(fmt, __mod, __fi, __li, arglist);
+	va_end (arglist);
+}
 
-#ifdef	WIN32
-	localtime_s(&_tm, (time_t *)&now);
-#else
-	localtime_r((time_t *)&now, &_tm);
-#endif
 
-	olen = snprintf (out, UTIL$SZ_OUTBUF, lfmt,
-		_tm.tm_mday, _tm.tm_mon + 1, 1900 + _tm.tm_year,
-		_tm.tm_hour, _tm.tm_min, _tm.tm_sec, (unsigned) now.tv_nsec/TIMSPECDEVIDER,
-		(unsigned) __gettid(), fac, severity[_sev]);
+/*
+ * Run-time toggled trace points registry.
+ * A trace point is linked into the registry at first passing, its state is computed
+ * against the list of the rules: "<pattern> = ON/OFF", the last matched rule wins.
+ */
+#define	UTIL$K_TPNT_MAXRULES	64			/* A maximum number of the rules		*/
+#define	UTIL$K_TPNT_NAMESZ	256			/* A size of the trace point name buffer	*/
 
-	va_start (arglist, fmt);
-	olen += vsnprintf(out + olen, UTIL$SZ_OUTBUF - olen, fmt, arglist);
-	va_end (arglist);
+typedef struct	__util_tpnt_rule__ {
+	char	pattern[128];				/* Wildcard pattern, ASCIZ			*/
+	int	state;					/* UTIL$K_TPNT_ON or UTIL$K_TPNT_OFF		*/
+} UTIL_TPNT_RULE;
 
-	olen = $MIN(olen, sizeof(out) - 1);
+static UTIL_TPNT_RULE	s_tpnt_rules [UTIL$K_TPNT_MAXRULES];
 
-	/* Add <LF> at end of record*/
-	out[olen++] = '\n';
+static int	s_tpnt_nrules;				/* A number of rules in the table		*/
+static UTIL_TPNT *s_tpnt_root;				/* Head of the trace points list		*/
+static int	s_tpnt_lock;				/* Serialize an access to the registry		*/
+static char	s_tpnt_fspec[256];			/* A control file to be reloaded by signal	*/
 
-	/* Write to file and flush buffer depending on severity level */
-	write (g_logoutput, out, olen );
 
-	/* ARL - for android logcat */
-	#ifdef ANDROID_LOGCAT
+/* Form a name of the trace point: "<module>\<function>:<line>" */
+static int	s_tpnt_name	(
+	const UTIL_TPNT	*a_tpnt,
+		char	*a_buf,
+		int	a_bufsz
+		)
+{
+int	l_len;
+
+	l_len = snprintf(a_buf, a_bufsz, "%s\\%s:%u", a_tpnt->mod ? a_tpnt->mod : "", a_tpnt->func, a_tpnt->line);
+
+	return	$MIN(l_len, a_bufsz - 1);
+}
+
+/* Compute a state of the trace point against the rules list, the registry must be locked */
+static int	s_tpnt_eval	(
+	const UTIL_TPNT	*a_tpnt
+		)
+{
+char	l_name[UTIL$K_TPNT_NAMESZ];
+int	i, l_state = UTIL$K_TPNT_OFF;
+
+	s_tpnt_name(a_tpnt, l_name, sizeof(l_name));
+
+	for ( i = 0; i < s_tpnt_nrules; i++ )
+		if ( __util$pattern_match(l_name, s_tpnt_rules[i].pattern) )
+			l_state = s_tpnt_rules[i].state;
+
+	return	l_state;
+}
+
+/* Add or replace a rule in the given list, the registry must be locked if it's the s_tpnt_rules */
+static int	s_tpnt_addrule	(
+	UTIL_TPNT_RULE	*a_rules,
+		int	*a_nrules,
+	const char	*a_pattern,
+		int	a_len,
+		int	a_state
+		)
+{
+int	i;
+
+	a_len = $MIN(a_len, (int) sizeof(a_rules[0].pattern) - 1);
+
+	for ( i = 0; i < *a_nrules; i++ )
+		if ( !strncmp(a_rules[i].pattern, a_pattern, a_len) && !a_rules[i].pattern[a_len] )
+			break;
+
+	if ( i >= UTIL$K_TPNT_MAXRULES )
+		return	STS$K_ERROR;
+
+	memcpy(a_rules[i].pattern, a_pattern, a_len);
+	a_rules[i].pattern[a_len] = '\0';
+	a_rules[i].state = a_state ? UTIL$K_TPNT_ON : UTIL$K_TPNT_OFF;
+
+	*a_nrules = $MAX(*a_nrules, i + 1);
+
+	return	STS$K_SUCCESS;
+}
+
+/* Recompute states of the all registered trace points, the registry must be locked */
+static void	s_tpnt_reeval	(void)
+{
+UTIL_TPNT	*l_tpnt;
+
+	for ( l_tpnt = s_tpnt_root; l_tpnt; l_tpnt = l_tpnt->link )
+		l_tpnt->state = s_tpnt_eval(l_tpnt);
+}
+
+
+/*
+ *++
+ *  Description: a slow path of the $TPNT/$IFTPNT macros: register new trace point,
+ *	format and put trace record if the point is enabled.
+ *
+ * Input:
+ *	tpnt:	A trace point descriptor
+ *	cond:	An additional condition from $IFTPNT
+ *	fmt:	A format string
+ *	...	Format string arguments
+ * Output:
+ *	NONE
+ * Return:
+ *	NONE
+ *
+ *--
+ */
+void	__util$tpnt_trace	(
+		UTIL_TPNT *	a_tpnt,
+		int		a_cond,
+		const char *	a_fmt,
+			...
+			)
+{
+va_list arglist;
+
+	if ( unlikely(s_tpnt_reload) )
+		__util$tpnt_poll();
+
+	if ( a_tpnt->state == UTIL$K_TPNT_NEW )
+		{
+		$LOCK_LONG(&s_tpnt_lock);
+
+		if ( a_tpnt->state == UTIL$K_TPNT_NEW )
+			{
+			a_tpnt->link = s_tpnt_root;
+			s_tpnt_root = a_tpnt;
+			a_tpnt->state = s_tpnt_eval(a_tpnt);
+			}
+
+		$UNLOCK_LONG(&s_tpnt_lock);
+		}
+
+	if ( (a_tpnt->state != UTIL$K_TPNT_ON) || !a_cond )
+		return;
+
+	va_start (arglist, a_fmt);
+	s_util_vtrace(a_fmt, a_tpnt->mod, a_tpnt->func, a_tpnt->line, arglist);
+	va_end (arglist);
+}
+
+/*
+ *   DESCRIPTION: Enable or disable trace points matched to the given pattern, the rule is
+ *	applied to the already registered points and will be applied to the new points.
+ *	The "*" pattern resets all previous rules.
+ *
+ *   INPUTS:
+ *	pattern:	A wildcard pattern to match "<module>\<function>:<line>", ASCIZ
+ *	state:		1/0 - ON/OFF
+ *
+ *   RETURNS:
+ *	condition code
+ */
+int	__util$tpnt_set	(
+	const char	*a_pattern,
+		int	a_state
+		)
+{
+int	l_status;
+
+	$LOCK_LONG(&s_tpnt_lock);
+
+	if ( !strcmp(a_pattern, "*") )
+		s_tpnt_nrules = 0;
+
+	if ( 1 & (l_status = s_tpnt_addrule(s_tpnt_rules, &s_tpnt_nrules, a_pattern, (int) strlen(a_pattern), a_state)) )
+		s_tpnt_reeval();
+
+	$UNLOCK_LONG(&s_tpnt_lock);
+
+	return	(1 & l_status) ? l_status : (int) $LOG(STS$K_ERROR, "Too many trace point rules, '%s' is ignored", a_pattern);
+}
+
+/*
+ *   DESCRIPTION: Load the rules from the control file, all previous rules are discarded.
+ *	The file is expected in the form:
+ *
+ *	! Comment
+ *	+CLI_ROUTINES\*		- enable all trace points in the module
+ *	-*\cli$val_check:*	- disable trace points in the function
+ *
+ *   INPUTS:
+ *	fspec:	A control file specification
+ *
+ *   RETURNS:
+ *	condition code
+ */
+int	__util$tpnt_load	(
+	const char	*a_fspec
+		)
+{
+FILE	*l_fp;
+char	l_buf[256], *l_cp;
+int	l_len, l_lineno, l_nrules = 0, l_status = STS$K_SUCCESS;
+UTIL_TPNT_RULE	l_rules[UTIL$K_TPNT_MAXRULES];
+
+	if ( !(l_fp = fopen(a_fspec, "r")) )
+		return	$LOG(STS$K_ERROR, "Error open file '%s', errno = %d", a_fspec, errno);
+
+	/* Parse the file into the local list, so the registry is not locked during I/O */
+	for ( l_lineno = 1; fgets(l_buf, sizeof(l_buf), l_fp); l_lineno++ )
+		{
+		if ( !(l_len = (int) __util$sv_normalize(l_buf, strlen(l_buf), '!', 0, l_buf, sizeof(l_buf)).len) )
+			continue;
+
+		l_cp = l_buf;
+
+		if ( (*l_cp == '+') || (*l_cp == '-') )
+			l_cp++, l_len--;
+
+		if ( l_len && !(1 & s_tpnt_addrule(l_rules, &l_nrules, l_cp, l_len, *l_buf != '-')) )
+			l_status = STS$K_ERROR;
+		}
+
+	fclose(l_fp);
+
+	$LOCK_LONG(&s_tpnt_lock);
+
+	memcpy(s_tpnt_rules, l_rules, l_nrules * sizeof(UTIL_TPNT_RULE));
+	s_tpnt_nrules = l_nrules;
+	s_tpnt_reeval();
+
+	$UNLOCK_LONG(&s_tpnt_lock);
+
+	return	(1 & l_status) ? l_status : (int) $LOG(STS$K_ERROR, "%s : too many trace point rules", a_fspec);
+}
+
+
+#ifndef	WIN32
+static void	s_tpnt_sighandler	(
+		int	a_signo
+		)
+{
+	(void) a_signo;						/* A signal has been set by the __util$tpnt_sigini() */
+
+	s_tpnt_reload = 1;
+}
+#endif
+
+/*
+ *   DESCRIPTION: Set a control file to be reloaded on the given signal. The signal handler only
+ *	flags reloading, the file is reloaded by the first $TPNT slow path, $LOG or
+ *	an explicit call of the __util$tpnt_poll().
+ *
+ *   INPUTS:
+ *	signo:	A signal number, eg. SIGUSR2
+ *	fspec:	A control file specification
+ *
+ *   RETURNS:
+ *	condition code
+ */
+int	__util$tpnt_sigini	(
+		int	a_signo,
+	const char	*a_fspec
+		)
+{
+#ifndef	WIN32
+struct sigaction l_sa = {0};
+
+	strncpy(s_tpnt_fspec, a_fspec, sizeof(s_tpnt_fspec) - 1);
+
+	l_sa.sa_handler = s_tpnt_sighandler;
+	l_sa.sa_flags = SA_RESTART;
+	sigemptyset(&l_sa.sa_mask);
+
+	if ( sigaction(a_signo, &l_sa, NULL) )
+		return	$LOG(STS$K_ERROR, "sigaction(%d) -> errno=%d", a_signo, errno);
+
+	return	STS$K_SUCCESS;
+#else
+	return	STS$K_ERROR;
+#endif
+}
+
+/*
+ *   DESCRIPTION: Reload the control file if it has been requested by signal.
+ *
+ *   RETURNS:
+ *	condition code
+ */
+int	__util$tpnt_poll	(void)
+{
+	if ( !__sync_bool_compare_and_swap(&s_tpnt_reload, 1, 0) )
+		return	STS$K_SUCCESS;
+
+	return	__util$tpnt_load(s_tpnt_fspec);
+}
+
+/*
+ *   DESCRIPTION: Out to log the list of the registered trace points with their states.
+ *
+ *   RETURNS:
+ *	STS$K_SUCCESS
+ */
+int	__util$tpnt_show	(void)
+{
+UTIL_TPNT	*l_tpnt;
+char	l_name[UTIL$K_TPNT_NAMESZ];
+int	l_count = 0;
+
+	for ( l_tpnt = __atomic_load_n(&s_tpnt_root, __ATOMIC_ACQUIRE); l_tpnt; l_tpnt = l_tpnt->link, l_count++ )
+		{
+		s_tpnt_name(l_tpnt, l_name, sizeof(l_name));
+		$LOG(STS$K_INFO, "%s = %s", l_name, (l_tpnt->state == UTIL$K_TPNT_ON) ? "ON" : "OFF");
+		}
+
+	return	$LOG(STS$K_INFO, "%d trace points, %d rules", l_count, s_tpnt_nrules);
+}
+
+
+unsigned	__util$log
+			(
+		const char *	fac,
+		unsigned	sev,
+		const char *	fmt,
+			...
+			)
+
+{
+va_list arglist;
+char	out[UTIL$SZ_OUTBUF + 8], *cp;
+unsigned olen, _sev = $SEV(sev), opcom = sev & STS$M_SYSLOG;
+struct tm _tm;
+struct timespec now;
+
+	/*
+	** Some sanity check
+	*/
+	if ( !($ISINRANGE(sev, STS$K_WARN, STS$K_ERROR)) )
+		sev = STS$K_UNDEF;
+
+	/*
+	** Out to buffer "DD-MM-YYYY HH:MM:SS.msec [<function>\<line>]<FAC>-E:" prefix
+	*/
+	s___time(&now);
+
+#ifdef	WIN32
+	localtime_s(&_tm, (time_t *)&now);
+#else
+	localtime_r((time_t *)&now, &_tm);
+#endif
+
+	if ( s_logmode != UTIL$K_LOGMODE_JSON )
+		{
+		cp = s_util_tsprefix(out, &_tm, &now);
+		*(cp++) = '%';
+		cp = s_put_str(cp, out + UTIL$SZ_OUTBUF / 2, fac);
+		*(cp++) = '-';
+		*(cp++) = severity[_sev];
+		memcpy(cp, ": ", 2);
+		olen = (cp + 2) - out;
+		}
+	else	olen = 0;
+
+	va_start (arglist, fmt);
+	olen += vsnprintf(out + olen, UTIL$SZ_OUTBUF - olen, fmt, arglist);
+	va_end (arglist);
+
+	olen = $MIN(olen, sizeof(out) - 1);
+
+	if ( s_logmode == UTIL$K_LOGMODE_JSON )				/* Convert the record to the JSON object */
+		olen = s_util_jsonrec(out, UTIL$SZ_OUTBUF, olen, &now, fac, _sev, 0, NULL, NULL, 0);
+
+	/* Add <LF> at end of record*/
+	out[olen++] = '\n';
+
+	/* Keep a copy of the record in the flight recorder's ring */
+	__util$frec_put(out, olen);
+
+	/* Write to file and flush buffer depending on severity level */
+	write (g_logoutput, out, olen );
+
+	/* ARL - for android logcat */
+	#ifdef ANDROID_LOGCAT
 		__android_log_print(ANDROID_LOG_VERBOSE, fac, "%.*s", olen, out);
 	#endif
 
@@ -1445,64 +2747,462 @@ struct timespec now;
 }
 
 /*
- * Description: Open a file to be used as default output file for $TRACE/$LOG/$DUMPHEX routines.
- *		File will be open in shared for read and append mode!
- *
- *  Input:
- *	logfile:	a log file name string, ASCIZ
- *	sloghost:	a SYSLOG Host IP address, ASCIZ
- *
- *  Implicit output:	global logoutput variable
- *
- *  Return:
- *	condition status, see STS$ constants
+ * Flight recorder stuff: every thread has a ring of the last UTIL$K_FREC_RECNR records,
+ * a record is just a copy of the line has been formatted by the $LOG/$TRACE/$PUTMSG.
+ * All rings are linked into the global table to be accessible from the signal handler.
+ * The ring keeps the alternate signal stack of the owner thread, so the dump is performed
+ * even the thread has got a stack overflow.
  */
-int	__util$deflog	(
-		const char *	logfile,
-		const char *	sloghost
-				)
-{
-#ifdef	_WIN32
-int	mode = _S_IREAD | _S_IWRITE;
-#else
-const mode_t mode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
-#endif
-
-int	fd = -1;
+typedef struct __util_frec__ {
+	volatile int	tid;					/* Owner thread Id, 0 - the ring is free	*/
+	int		lasttid;				/* Id of the thread has been put records	*/
+	volatile unsigned seq;					/* A number of records has been put		*/
+
+	struct	{
+		unsigned short	len;				/* A length of the record text			*/
+		char	text[UTIL$K_FREC_RECSZ];
+	} rec[UTIL$K_FREC_RECNR];
+
+	int	altstkerr;					/* errno of the sigaltstack(), 0 - no error	*/
+	char	altstk[UTIL$K_FREC_ALTSTKSZ];			/* An alternate stack for the signal handler	*/
+} UTIL_FREC;
+
+typedef	struct __util_frec_out__ {				/* An output context for the ring dumping	*/
+	int	fd;						/* File descriptor, -1 - output to buffer	*/
+	char	*buf;
+	size_t	bufsz,
+		buflen;
+} UTIL_FREC_OUT;
 
-	/* Is there SYSLOG Host IP ? */
-	if ( sloghost )
-		{
-		inet_pton(AF_INET, sloghost, &slogsock.sin_addr);
-		slogsock.sin_port = htons(514);
-		slogsock.sin_family = AF_INET;
-		}
+#ifndef	WIN32
 
-	if ( !logfile )
-		return	STS$K_SUCCESS;
+static UTIL_FREC * volatile s_frec_tbl[UTIL$K_FREC_MAXTHR];	/* All rings has been allocated			*/
+static __thread UTIL_FREC *s_frec_ring;				/* A ring of the current thread			*/
 
-	if ( !*logfile)
-		return	STS$K_SUCCESS;
+static pthread_key_t	s_frec_key;				/* To release the ring at thread exit		*/
+static pthread_once_t	s_frec_once = PTHREAD_ONCE_INIT;
 
-	if ( 0 > (fd = open(logfile, O_RDWR | O_CREAT | O_APPEND, mode)) )
-		return	$LOG(STS$K_ERROR, "Error opening log file '%s', errno = %d.", logfile, errno);
+static char	s_frec_fspec[256];				/* A dump file specification, ASCIZ		*/
+static volatile int s_frec_dumped;				/* Dump only once per fatal signal		*/
 
-	lseek(fd, 0L, SEEK_END);
+static const int s_frec_signals [] = {SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL};
 
-	g_logoutput = fd;
 
-	dup2(fd, STDERR_FILENO);
-	dup2(fd, STDOUT_FILENO);
+/*
+ *   DESCRIPTION: Thread-exit destructor, return the ring back to the pool, keep data in the ring
+ *	until it will be reused by other thread.
+ */
+static void	s_frec_release	(void *a_ring)
+{
+stack_t	l_ss = {0};
 
+	/* Don't leave the stack of the ring to be reused by other thread */
+	if ( !sigaltstack(NULL, &l_ss) && (l_ss.ss_sp == ((UTIL_FREC *) a_ring)->altstk) )
+		{
+		l_ss.ss_flags = SS_DISABLE;
+		sigaltstack(&l_ss, NULL);
+		}
 
-	return $LOG(STS$K_SUCCESS, "Log file '%s' has been opened.", logfile);
+	((UTIL_FREC *) a_ring)->tid = 0;
 }
 
+static void	s_frec_key_init	(void)
+{
+	pthread_key_create(&s_frec_key, s_frec_release);
+}
 
 /*
- * Description: compare a current file size with the 'limit' and rewind a current file pointer at begining of file.
+ *   DESCRIPTION: Get a free ring from the pool or allocate new one, link it to the current thread.
  *
- *  Return:
+ *   RETURNS:
+ *	An address of the ring, NULL - the pool is exhausted.
+ */
+static UTIL_FREC *	s_frec_attach	(void)
+{
+UTIL_FREC	*l_ring;
+int	i, l_tid = (int) __gettid();
+stack_t	l_ss = {0};
+
+	pthread_once(&s_frec_once, s_frec_key_init);
+
+	/* Allocate a new ring while there is free space in the table ... */
+	for ( i = 0; (i < UTIL$K_FREC_MAXTHR) && s_frec_tbl[i]; i++);
+
+	if ( (i < UTIL$K_FREC_MAXTHR) && (l_ring = calloc(1, sizeof(UTIL_FREC))) )
+		{
+		l_ring->tid = l_ring->lasttid = l_tid;
+
+		for ( ; i < UTIL$K_FREC_MAXTHR; i++ )
+			if ( __sync_bool_compare_and_swap(&s_frec_tbl[i], NULL, l_ring) )
+				break;
+
+		if ( i >= UTIL$K_FREC_MAXTHR )
+			{
+			free(l_ring);
+			l_ring = NULL;
+			}
+		}
+	else	l_ring = NULL;
+
+	/* ... otherwise reuse a ring has been released by exited thread */
+	for ( i = 0; !l_ring && (i < UTIL$K_FREC_MAXTHR); i++ )
+		{
+		if ( (l_ring = s_frec_tbl[i]) && $CMP_STORE_LONG(&l_ring->tid, 0, l_tid) )
+			{
+			l_ring->seq = 0;
+			l_ring->lasttid = l_tid;
+			}
+		else	l_ring = NULL;
+		}
+
+	if ( !l_ring )
+		return	NULL;
+
+	pthread_setspecific(s_frec_key, l_ring);
+	s_frec_ring = l_ring;
+
+	/* Install the alternate signal stack, if the thread has not own one; it can be called from the log path,
+	 * so an error is only saved to be reported by the __util$frec_thrinit() */
+	l_ring->altstkerr = 0;
+
+	if ( !sigaltstack(NULL, &l_ss) && (l_ss.ss_flags & SS_DISABLE) )
+		{
+		l_ss.ss_sp = l_ring->altstk;
+		l_ss.ss_size = sizeof(l_ring->altstk);
+		l_ss.ss_flags = 0;
+
+		if ( sigaltstack(&l_ss, NULL) )
+			l_ring->altstkerr = errno;
+		}
+
+	return	l_ring;
+}
+#endif	/* WIN32 */
+
+
+/*
+ *   DESCRIPTION: Put a copy of the record into the ring of the current thread, the oldest
+ *	record is overwritten. A tail of the record longer then UTIL$K_FREC_RECSZ is lost.
+ *
+ *   INPUTS:
+ *	rec:	A record to be saved
+ *	reclen:	A length of the record
+ *
+ *   RETURNS:
+ *	NONE
+ */
+void	__util$frec_put	(
+	const char	*a_rec,
+		unsigned a_reclen
+		)
+{
+#ifndef	WIN32
+UTIL_FREC	*l_ring;
+unsigned	l_seq;
+
+	if ( !(l_ring = s_frec_ring) && !(l_ring = s_frec_attach()) )
+		return;
+
+	l_seq = l_ring->seq;
+	a_reclen = $MIN(a_reclen, UTIL$K_FREC_RECSZ);
+
+	memcpy(l_ring->rec[l_seq % UTIL$K_FREC_RECNR].text, a_rec, a_reclen);
+	l_ring->rec[l_seq % UTIL$K_FREC_RECNR].len = (unsigned short) a_reclen;
+
+	__atomic_store_n(&l_ring->seq, l_seq + 1, __ATOMIC_RELEASE);
+#endif
+}
+
+
+/*
+ *   DESCRIPTION: Put a piece of data to the file or into the buffer, is supposed to be called
+ *	from the signal handler, so only async-signal-safe routines are used.
+ */
+static void	s_frec_out	(
+	UTIL_FREC_OUT	*a_out,
+	const char	*a_src,
+		size_t	a_srclen
+		)
+{
+	if ( a_out->fd >= 0 )
+		{
+		write(a_out->fd, a_src, a_srclen);
+		return;
+		}
+
+	a_srclen = $MIN(a_srclen, a_out->bufsz - a_out->buflen);
+	memcpy(a_out->buf + a_out->buflen, a_src, a_srclen);
+	a_out->buflen += a_srclen;
+}
+
+/*
+ *   DESCRIPTION: Convert unsigned to the decimal string w/o snprintf(), return a length of the string.
+ */
+static int	s_frec_u2dec	(
+		unsigned a_val,
+		char	*a_dst
+		)
+{
+char	l_tmp[12], *l_cp = l_tmp + sizeof(l_tmp);
+int	l_len;
+
+	do	{
+		*(--l_cp) = '0' + (a_val % 10);
+		a_val /= 10;
+		} while ( a_val );
+
+	memcpy(a_dst, l_cp, l_len = (int) (l_tmp + sizeof(l_tmp) - l_cp));
+
+	return	l_len;
+}
+
+/*
+ *   DESCRIPTION: Run over all rings and put their contents from the oldest to the newest
+ *	records into the given output context.
+ *
+ *   RETURNS:
+ *	A number of the records has been processed
+ */
+static int	s_frec_format	(
+	UTIL_FREC_OUT	*a_out
+		)
+{
+int	l_nrecs = 0;
+#ifndef	WIN32
+UTIL_FREC	*l_ring;
+unsigned	i, l_seq, l_idx, l_len;
+char	l_hdr[80];
+const char l_hdr1[] = "--- Flight recorder, TID: ", l_hdr2[] = ", records: ", l_hdr3[] = " ---\n";
+
+	for ( i = 0; (i < UTIL$K_FREC_MAXTHR) && (l_ring = s_frec_tbl[i]); i++ )
+		{
+		if ( !(l_seq = __atomic_load_n(&l_ring->seq, __ATOMIC_ACQUIRE)) )
+			continue;
+
+		l_idx = (l_seq > UTIL$K_FREC_RECNR) ? l_seq - UTIL$K_FREC_RECNR : 0;
+
+		/* Form a header line by hands, snprintf() is not async-signal-safe */
+		memcpy(l_hdr, l_hdr1, l_len = sizeof(l_hdr1) - 1);
+		l_len += s_frec_u2dec(l_ring->lasttid, l_hdr + l_len);
+		memcpy(l_hdr + l_len, l_hdr2, sizeof(l_hdr2) - 1);
+		l_len += sizeof(l_hdr2) - 1;
+		l_len += s_frec_u2dec(l_seq - l_idx, l_hdr + l_len);
+		memcpy(l_hdr + l_len, l_hdr3, sizeof(l_hdr3) - 1);
+		l_len += sizeof(l_hdr3) - 1;
+
+		s_frec_out(a_out, l_hdr, l_len);
+
+		for ( ; l_idx < l_seq; l_idx++, l_nrecs++ )
+			s_frec_out(a_out, l_ring->rec[l_idx % UTIL$K_FREC_RECNR].text, l_ring->rec[l_idx % UTIL$K_FREC_RECNR].len);
+		}
+#endif
+
+	return	l_nrecs;
+}
+
+/*
+ *   DESCRIPTION: Write contents of the all rings to the given file descriptor.
+ *	Can be called from signal handler.
+ *
+ *   INPUTS:
+ *	fd:	A file descriptor
+ *
+ *   RETURNS:
+ *	A number of the records has been written
+ */
+int	__util$frec_dump	(
+		int	a_fd
+		)
+{
+UTIL_FREC_OUT	l_out = {a_fd, NULL, 0, 0};
+
+	return	s_frec_format(&l_out);
+}
+
+/*
+ *   DESCRIPTION: Copy contents of the all rings into the given buffer, the output is truncated
+ *	to the size of the buffer.
+ *
+ *   INPUTS:
+ *	buf:	A buffer to accept records
+ *	bufsz:	A size of the buffer
+ *
+ *   OUTPUTS:
+ *	buflen:	A length of the data in the buffer
+ *
+ *   RETURNS:
+ *	STS$K_SUCCESS
+ *	STS$K_WARN	- output has been truncated
+ */
+int	__util$frec_snapshot	(
+		char	*a_buf,
+		size_t	a_bufsz,
+		size_t	*a_buflen
+		)
+{
+UTIL_FREC_OUT	l_out = {-1, a_buf, a_bufsz, 0};
+
+	s_frec_format(&l_out);
+	*a_buflen = l_out.buflen;
+
+	return	(l_out.buflen < a_bufsz) ? STS$K_SUCCESS : STS$K_WARN;
+}
+
+
+#ifndef	WIN32
+/*
+ *   DESCRIPTION: Fatal signals handler - dump rings into the file, restore default handling
+ *	of the signal and raise it again to get a core dump.
+ */
+static void	s_frec_sighandler	(
+		int	a_signo
+		)
+{
+int	l_fd = -1;
+
+	if ( __sync_lock_test_and_set(&s_frec_dumped, 1) == 0 )
+		{
+		if ( !*s_frec_fspec || (0 > (l_fd = open(s_frec_fspec, O_WRONLY | O_CREAT | O_APPEND, 0640))) )
+			l_fd = STDERR_FILENO;
+
+		__util$frec_dump(l_fd);
+
+		if ( l_fd != STDERR_FILENO )
+			close(l_fd);
+		}
+
+	signal(a_signo, SIG_DFL);
+	raise(a_signo);
+}
+#endif
+
+/*
+ *   DESCRIPTION: Attach a ring and the alternate signal stack to the current thread, is supposed to be
+ *	called at the thread start, so the dump is performed even the thread has got a stack overflow
+ *	before the first record.
+ *
+ *   RETURNS:
+ *	condition code
+ */
+int	__util$frec_thrinit	(void)
+{
+#ifndef	WIN32
+UTIL_FREC	*l_ring;
+
+	if ( !(l_ring = s_frec_ring) && !(l_ring = s_frec_attach()) )
+		return	$LOG(STS$K_WARN, "No free ring for the thread, the pool of %d rings is exhausted", UTIL$K_FREC_MAXTHR);
+
+	if ( l_ring->altstkerr )
+		return	$LOG(STS$K_WARN, "sigaltstack() -> errno=%d", l_ring->altstkerr);
+#endif
+
+	return	STS$K_SUCCESS;
+}
+
+/*
+ *   DESCRIPTION: Set a file to accept dump of the flight recorder's rings, install handler
+ *	of the fatal signals (SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL) to perform the dumping.
+ *	The handler is running on the alternate stack of the thread to survive a stack overflow,
+ *	the stack is installed for the current thread by this call; other threads should call
+ *	the __util$frec_thrinit() at start, otherwise they get the stack at the first record.
+ *
+ *   INPUTS:
+ *	dumpfile:	A dump file specification, NULL - SYS$ERROR
+ *
+ *   RETURNS:
+ *	condition code
+ */
+int	__util$frec_init	(
+	const char	*a_dumpfile
+		)
+{
+#ifndef	WIN32
+struct sigaction l_sa = {0};
+int	i;
+
+	*s_frec_fspec = '\0';
+
+	if ( a_dumpfile )
+		{
+		strncpy(s_frec_fspec, a_dumpfile, sizeof(s_frec_fspec) - 1);
+		s_frec_fspec[sizeof(s_frec_fspec) - 1] = '\0';
+		}
+
+	__util$frec_thrinit();
+
+	l_sa.sa_handler = s_frec_sighandler;
+	l_sa.sa_flags = SA_ONSTACK | SA_RESETHAND | SA_NODEFER;
+	sigemptyset(&l_sa.sa_mask);
+
+	for ( i = 0; i < (int) $ARRSZ(s_frec_signals); i++ )
+		if ( sigaction(s_frec_signals[i], &l_sa, NULL) )
+			return	$LOG(STS$K_ERROR, "sigaction(%d) -> errno=%d", s_frec_signals[i], errno);
+#endif
+
+	return	STS$K_SUCCESS;
+}
+
+
+
+/*
+ * Description: Open a file to be used as default output file for $TRACE/$LOG/$DUMPHEX routines.
+ *		File will be open in shared for read and append mode!
+ *
+ *  Input:
+ *	logfile:	a log file name string, ASCIZ
+ *	sloghost:	a SYSLOG Host IP address, ASCIZ
+ *
+ *  Implicit output:	global logoutput variable
+ *
+ *  Return:
+ *	condition status, see STS$ constants
+ */
+int	__util$deflog	(
+		const char *	logfile,
+		const char *	sloghost
+				)
+{
+#ifdef	_WIN32
+int	mode = _S_IREAD | _S_IWRITE;
+#else
+const mode_t mode = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+#endif
+
+int	fd = -1;
+
+	/* Is there SYSLOG Host IP ? */
+	if ( sloghost )
+		{
+		inet_pton(AF_INET, sloghost, &slogsock.sin_addr);
+		slogsock.sin_port = htons(514);
+		slogsock.sin_family = AF_INET;
+		}
+
+	if ( !logfile )
+		return	STS$K_SUCCESS;
+
+	if ( !*logfile)
+		return	STS$K_SUCCESS;
+
+	if ( 0 > (fd = open(logfile, O_RDWR | O_CREAT | O_APPEND, mode)) )
+		return	$LOG(STS$K_ERROR, "Error opening log file '%s', errno = %d.", logfile, errno);
+
+	lseek(fd, 0L, SEEK_END);
+
+	g_logoutput = fd;
+
+	dup2(fd, STDERR_FILENO);
+	dup2(fd, STDOUT_FILENO);
+
+
+	return $LOG(STS$K_SUCCESS, "Log file '%s' has been opened.", logfile);
+}
+
+
+/*
+ * Description: compare a current file size with the 'limit' and rewind a current file pointer at begining of file.
+ *
+ *  Return:
  *	condition status, see STS$ constants
  */
 int	__util$rewindlogfile	(
@@ -1550,7 +3250,7 @@ int	status;
  *  pattern.  The pattern may contain wildcards (*,%), where '*' matches
  *  0 or more occurrences of anything, and '%' matches any one character.
  *  In addition, a '\' in the pattern string will translate the next
- *  character as literal.  This is a recursive routine.
+ *  character as literal.
  *
  * COMMUNICATION :
  *
@@ -1575,10 +3275,11 @@ int	status;
  *    If the magic string pointer points at a WILD_PERCENT, then advance
  *    both pointers, regardless of what's in the test string.
  *
- *    If the magic pointer points to WILD_STAR, then try matching the
- *    rest of the magic string at each character position in the text
- *    string by calling C_STR$pattern_match (i.e. this function)
- *    recursively.  If any of those succeed then declare this one a success.
+ *    If the magic pointer points to WILD_STAR, then remember the position
+ *    after it and the current position in the text string. On a mismatch
+ *    go back to the last WILD_STAR and let it absorb one more character.
+ *    Only the last WILD_STAR is needed to backtrack, so the worst case is
+ *    O(n*m) without recursion.
  *
  * CAVEATS :
  *  (1) pattern$ is assumed to be preprocessed, i.e, * replaced by WILD_STAR,
@@ -1608,6 +3309,8 @@ int	status;
  *
  *
  *	27-NOV-2015	RRL	Some reformating.
+ *
+ *	19-OCT-2026	RRL	Non-recursive backtracking to the last '*' instead of the recursion on every '*'.
  */
 /*--***********************************************************************/
 
@@ -1628,61 +3331,219 @@ int	__util$pattern_match	(
 		char	*	pattern$     /* Pattern, with potential wildcards (*,%) to * match the string.*/
 				)
 {
-int done = FALSE, matched_to_eos = FALSE;
+char	*l_star = NULL, *l_resume = NULL;
 
-	while( (*pattern$ != '\0') && (!done) && ( ((*str$=='\0') && ( (*pattern$==WILD_STAR)) ) || (*str$!='\0')) )
+	while ( *str$ != '\0' )
 		{
-		switch (*pattern$)
+		if ( *pattern$ == WILD_STAR )
 			{
-			case WILD_STAR:
-				pattern$++;
-				matched_to_eos = FALSE;
-				while ( (*str$ != '\0') && (! ( matched_to_eos = __util$pattern_match( str$++, pattern$))));
-
-				if ( matched_to_eos )
-					{
-					while (*str$ != '\0') str$++;
-					while (*pattern$ != '\0') pattern$++;
-					}
-				break;
+			/* Remember positions after the star, the star matches nothing for now */
+			l_star = ++pattern$;
+			l_resume = str$;
+			continue;
+			}
 
-			case WILD_PERCENT:
-				pattern$++;
-				str$++;
-				break;
+		if ( (*pattern$ != '\0') && ((*pattern$ == WILD_PERCENT) || (*pattern$ == *str$)) )
+			{
+			str$++;
+			pattern$++;
+			continue;
+			}
 
-			/* case '\\':*/
-			/* pattern$++;*/
+		if ( !l_star )
+			return	FALSE;
 
-			default:
-				if (*str$ == *pattern$)
-					{
-					str$++;
-					pattern$++;
-					}
-				else done = TRUE;
-			}
+		/* Mismatch: the last star absorbs one more character, try the rest of pattern again */
+		pattern$ = l_star;
+		str$ = ++l_resume;
 		}
 
 	while (*pattern$ == WILD_STAR) pattern$++;
 
-	return ( (*str$ == '\0') && (*pattern$ == '\0') );
-
-
+	return ( *pattern$ == '\0' );
 }
 /******************* end of C_STR$pattern_match *******************/
 
-#if	0
-#ifndef	WIN32
-void	__util$traceback	(void)
-{
-int	i, nptrs;
-void *	buffer[128];
-char **	strings;
 
-	nptrs = backtrace(buffer, sizeof(buffer));
+/*
+ * Compiled wildcard pattern: the pattern is split by the '*' into the literal segments, they can
+ * contain '%'. The first segment is anchored at the begin of the string, the last one - at the end,
+ * the middle segments are searched from left to right, the leftmost occurrence is always the best one.
+ */
+typedef	struct __util_wild_seg__ {
+	unsigned	off,			/* An offset of the segment in the pattern */
+			len;			/* A length of the segment */
+	int		pct;			/* The segment contains '%' */
+} UTIL_WILD_SEG;
+
+struct	__util_wild__ {
+	size_t		minlen;			/* A minimal length of the string: a number of non-'*' characters */
+	int		star,			/* The pattern contains '*' */
+			segnr;			/* A number of the segments */
+	char		*pat;			/* A copy of the pattern */
+	UTIL_WILD_SEG	seg[];
+};
 
-	$LOG(STS$K_INFO, " --------------------- TRACEBACK BEGIN (%d) ------", nptrs);
+/* Compare the segment with the string, '%' matches any character */
+inline static int	s_wild_cmp	(
+	const UTIL_WILD	*a_wild,
+	const UTIL_WILD_SEG *a_seg,
+	const char	*a_str
+			)
+{
+const char	*l_pat = a_wild->pat + a_seg->off;
+unsigned	i;
+
+	if ( !a_seg->pct )
+		return	!memcmp(a_str, l_pat, a_seg->len);
+
+	for ( i = 0; i < a_seg->len; i++ )
+		if ( (l_pat[i] != WILD_PERCENT) && (l_pat[i] != a_str[i]) )
+			return	FALSE;
+
+	return	TRUE;
+}
+
+/* Find the leftmost occurrence of the segment in the string */
+static const char	*s_wild_find	(
+	const UTIL_WILD	*a_wild,
+	const UTIL_WILD_SEG *a_seg,
+	const char	*a_str,
+		size_t	a_strlen
+			)
+{
+size_t	i;
+
+	if ( a_strlen < a_seg->len )
+		return	NULL;
+
+	if ( !a_seg->pct )
+		return	__util$strstr((char *) a_str, a_strlen, a_wild->pat + a_seg->off, a_seg->len);
+
+	for ( i = 0; i <= a_strlen - a_seg->len; i++ )
+		if ( s_wild_cmp(a_wild, a_seg, a_str + i) )
+			return	a_str + i;
+
+	return	NULL;
+}
+
+/*
+ *   DESCRIPTION: Compile a wildcard pattern to be used by the __util$wild_match(), the semantic
+ *	of the wildcards is the same as for the __util$pattern_match(): '*' matches zero or more
+ *	characters, '%' matches any single character.
+ *
+ *   INPUTS:
+ *	pattern: A pattern, ASCIZ
+ *
+ *   RETURNS:
+ *	An address of the compiled pattern, must be released by __util$wild_free(), NULL - insufficient memory
+ */
+UTIL_WILD	*__util$wild_compile	(
+	const char	*a_pattern
+			)
+{
+UTIL_WILD	*l_wild;
+UTIL_WILD_SEG	*l_seg;
+size_t	l_len = strlen(a_pattern), i;
+int	l_segnr = 1;
+
+	for ( i = 0; i < l_len; i++ )
+		l_segnr += (a_pattern[i] == WILD_STAR);
+
+	if ( !(l_wild = calloc(1, sizeof(UTIL_WILD) + l_segnr * sizeof(UTIL_WILD_SEG) + l_len + 1)) )
+		return	NULL;
+
+	l_wild->pat = (char *) &l_wild->seg[l_segnr];
+	memcpy(l_wild->pat, a_pattern, l_len + 1);
+
+	l_wild->star = (l_segnr > 1);
+	l_wild->segnr = l_segnr;
+	l_wild->minlen = l_len - (l_segnr - 1);
+
+	for ( l_seg = l_wild->seg, i = 0; i <= l_len; i++ )
+		{
+		if ( i == l_len )
+			l_seg->len = (unsigned) i - l_seg->off;
+		else if ( a_pattern[i] == WILD_STAR )
+			{
+			l_seg->len = (unsigned) i - l_seg->off;
+			(++l_seg)->off = (unsigned) i + 1;		/* Next segment starts after the '*' */
+			}
+		else	l_seg->pct |= (a_pattern[i] == WILD_PERCENT);
+		}
+
+	return	l_wild;
+}
+
+void	__util$wild_free	(
+		UTIL_WILD *a_wild
+			)
+{
+	free(a_wild);
+}
+
+/*
+ *   DESCRIPTION: Match the string against the compiled wildcard pattern. The string is rejected
+ *	by its length and the first, last literal segments before the search of the middle segments.
+ *	Without '%' in the segments the search is performed by the __util$strstr(), so a cost is linear
+ *	in most cases and O(n*m) in worst case.
+ *
+ *   INPUTS:
+ *	wild:	A pattern has been compiled by the __util$wild_compile()
+ *	str:	A string to be matched
+ *	strlen:	A length of the string
+ *
+ *   RETURNS:
+ *	TRUE - the string matches the pattern, FALSE - otherwise
+ */
+int	__util$wild_match	(
+	const UTIL_WILD	*a_wild,
+	const char	*a_str,
+		size_t	a_strlen
+			)
+{
+const UTIL_WILD_SEG *l_first = a_wild->seg, *l_last = a_wild->seg + a_wild->segnr - 1, *l_seg;
+const char	*l_cp, *l_end;
+
+	if ( a_strlen < a_wild->minlen )
+		return	FALSE;
+
+	/* No '*' - exact length and comparing */
+	if ( !a_wild->star )
+		return	(a_strlen == l_first->len) && s_wild_cmp(a_wild, l_first, a_str);
+
+	/* Anchored head and tail, they cannot overlap since a length is not less than minimal */
+	if ( !s_wild_cmp(a_wild, l_first, a_str) || !s_wild_cmp(a_wild, l_last, a_str + a_strlen - l_last->len) )
+		return	FALSE;
+
+	l_cp = a_str + l_first->len;
+	l_end = a_str + a_strlen - l_last->len;
+
+	for ( l_seg = l_first + 1; l_seg < l_last; l_seg++ )
+		{
+		if ( !l_seg->len )
+			continue;					/* "**" */
+
+		if ( !(l_cp = s_wild_find(a_wild, l_seg, l_cp, l_end - l_cp)) )
+			return	FALSE;
+
+		l_cp += l_seg->len;
+		}
+
+	return	TRUE;
+}
+
+#if	0
+#ifndef	WIN32
+void	__util$traceback	(void)
+{
+int	i, nptrs;
+void *	buffer[128];
+char **	strings;
+
+	nptrs = backtrace(buffer, sizeof(buffer));
+
+	$LOG(STS$K_INFO, " --------------------- TRACEBACK BEGIN (%d) ------", nptrs);
 
 	if ( !(strings = backtrace_symbols(buffer, nptrs)) )
 		{
@@ -1785,12 +3646,16 @@ const unsigned char  *p = (unsigned char *) buf;
 **  The 'strstr' function locates the first occurrence in the string pointed
 **  to by 's1' of the sequence of characters in the string pointed to by 's2'.
 **
+**  The SSE2/AVX2 versions check the first and the last characters of the 's2' at 16/32
+**  positions at once, and compare the rest only for candidates have matched both of them,
+**  the version is selected at first call by the CPU features.
+**
 **  Return values:
 **
 **	non-NULL    the address of the located string
 **	NULL	    indicates that the string was not found
 */
-char *	__util$strstr
+static char *	s_strstr_scalar
 			(
 		char	* s1,
 		size_t	s1len,
@@ -1801,15 +3666,6 @@ char *	__util$strstr
 char	*p1 = s1, *p2 = s2 + 1;
 size_t	p1len = s1len, cmplen = s2len - 1;
 
-	/*
-	 * Sanity check ...
-	 */
-	if ( !s1 || !s2 || !s1len || !s2len )
-		return	NULL;
-
-	if ( s1len < s2len )
-		return	NULL;
-
 	/*
 	 * Special check for single-byte substring
 	 */
@@ -1826,7 +3682,7 @@ size_t	p1len = s1len, cmplen = s2len - 1;
 		 * Is the rest of the p1 is more then length of the s2 ?
 		 * No ?! Stop comparing ,  return the NULL pointer.
 		 */
-		if ( (s1len - (p1 - s1)) < cmplen )
+		if ( (s1len - (p1 - s1)) < s2len )
 			return	(NULL);
 
 		if ( !memcmp(p1 + 1,  p2, cmplen) )
@@ -1843,74 +3699,4324 @@ size_t	p1len = s1len, cmplen = s2len - 1;
 	return((char *) NULL);
 }
 
+#ifdef	__SSE2__
+static char *	s_strstr_sse2
+			(
+		char	* s1,
+		size_t	s1len,
+		char	* s2,
+		size_t	s2len
+			)
+{
+__m128i	l_first, l_last, l_blk1, l_blk2;
+size_t	i;
+unsigned l_mask;
+
+	if ( s2len == 1 )
+		return	memchr(s1, *s2, s1len);
+
+	l_first = _mm_set1_epi8(s2[0]);
+	l_last = _mm_set1_epi8(s2[s2len - 1]);
+
+	/* Both loads must be inside the s1: i + s2len - 1 + 16 <= s1len */
+	for ( i = 0; (i + s2len + 15) <= s1len; i += 16 )
+		{
+		l_blk1 = _mm_loadu_si128((const __m128i *) (s1 + i));
+		l_blk2 = _mm_loadu_si128((const __m128i *) (s1 + i + s2len - 1));
+
+		l_mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(l_first, l_blk1), _mm_cmpeq_epi8(l_last, l_blk2)));
+
+		for ( ; l_mask; l_mask &= l_mask - 1 )
+			{
+			char	*p1 = s1 + i + __builtin_ctz(l_mask);
+
+			if ( !memcmp(p1 + 1, s2 + 1, s2len - 2) )
+				return	p1;
+			}
+		}
+
+	/* Tail of the s1 */
+	return	(s1len - i >= s2len) ? s_strstr_scalar(s1 + i, s1len - i, s2, s2len) : NULL;
+}
+#endif	/* __SSE2__ */
+
+#if	defined(__GNUC__) && defined(__x86_64__)
+__attribute__((target("avx2")))
+static char *	s_strstr_avx2
+			(
+		char	* s1,
+		size_t	s1len,
+		char	* s2,
+		size_t	s2len
+			)
+{
+__m256i	l_first, l_last, l_blk1, l_blk2;
+size_t	i;
+unsigned l_mask;
+
+	if ( s2len == 1 )
+		return	memchr(s1, *s2, s1len);
+
+	l_first = _mm256_set1_epi8(s2[0]);
+	l_last = _mm256_set1_epi8(s2[s2len - 1]);
+
+	/* Both loads must be inside the s1: i + s2len - 1 + 32 <= s1len */
+	for ( i = 0; (i + s2len + 31) <= s1len; i += 32 )
+		{
+		l_blk1 = _mm256_loadu_si256((const __m256i *) (s1 + i));
+		l_blk2 = _mm256_loadu_si256((const __m256i *) (s1 + i + s2len - 1));
+
+		l_mask = (unsigned) _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(l_first, l_blk1), _mm256_cmpeq_epi8(l_last, l_blk2)));
+
+		for ( ; l_mask; l_mask &= l_mask - 1 )
+			{
+			char	*p1 = s1 + i + __builtin_ctz(l_mask);
+
+			if ( !memcmp(p1 + 1, s2 + 1, s2len - 2) )
+				return	p1;
+			}
+		}
+
+	/* Tail of the s1, is less than 32 + s2len octets */
+	return	(s1len - i >= s2len) ? s_strstr_sse2(s1 + i, s1len - i, s2, s2len) : NULL;
+}
+#endif	/* __GNUC__ && __x86_64__ */
+
+typedef char *(* UTIL_STRSTR_FN) (char *s1, size_t s1len, char *s2, size_t s2len);
+
+static char *	s_strstr_select	(char *s1, size_t s1len, char *s2, size_t s2len);
+
+static UTIL_STRSTR_FN	s_strstr_impl = s_strstr_select;	/* Is replaced by the best version at first call */
+
+/* Select the version of the substring search by the CPU features, and call it */
+static char *	s_strstr_select
+			(
+		char	* s1,
+		size_t	s1len,
+		char	* s2,
+		size_t	s2len
+			)
+{
+UTIL_STRSTR_FN	l_fn = s_strstr_scalar;
+
+#if	defined(__GNUC__) && defined(__x86_64__)
+	__builtin_cpu_init();
+
+	l_fn = __builtin_cpu_supports("avx2") ? s_strstr_avx2 : s_strstr_sse2;
+#elif	defined(__SSE2__)
+	l_fn = s_strstr_sse2;
+#endif
+
+	__atomic_store_n(&s_strstr_impl, l_fn, __ATOMIC_RELAXED);
+
+	return	l_fn(s1, s1len, s2, s2len);
+}
+
+char *	__util$strstr
+			(
+		char	* s1,
+		size_t	s1len,
+		char	* s2,
+		size_t	s2len
+			)
+{
+	/*
+	 * Sanity check ...
+	 */
+	if ( !s1 || !s2 || !s1len || !s2len )
+		return	NULL;
+
+	if ( s1len < s2len )
+		return	NULL;
+
+	return	__atomic_load_n(&s_strstr_impl, __ATOMIC_RELAXED)(s1, s1len, s2, s2len);
+}
+
+
+/*
+ * ASCII-only case-insensitive comparing, folding and hashing: 'A'-'Z' are folded to 'a'-'z', other octets
+ * (include 0x80-0xFF) are compared as is, so the result doesn't depend on the locale.
+ * 16/32 octets are folded and compared by the SSE2/AVX2 instructions, 8 octets - by the 64-bits
+ * arithmetic (SWAR), the AVX2 version is selected by the CPU features at first call for the long strings.
+ */
+#define	UTIL$K_BLIND_AVX2SZ	64			/* A minimal length of the string to use AVX2		*/
+
+#define	UTIL$K_SWAR_01	0x0101010101010101ULL
+#define	UTIL$K_SWAR_80	0x8080808080808080ULL
+
+/* Fold a single octet */
+inline static unsigned char	s_fold_ch	(
+		unsigned char	a_ch
+			)
+{
+	return	a_ch + ((((unsigned) a_ch - 'A') < 26) << 5);
+}
+
+/* Fold 8 octets at once: 0x20 bit is set for the ASCII octets in the 'A'-'Z' range */
+inline static unsigned long long	s_fold_swar	(
+		unsigned long long	a_qw
+			)
+{
+unsigned long long	l_7bit = a_qw & ~UTIL$K_SWAR_80,
+			l_gez = l_7bit + (0x80 - 'A') * UTIL$K_SWAR_01,	/* 0x80 - an octet >= 'A'	*/
+			l_gtz = l_7bit + (0x7F - 'Z') * UTIL$K_SWAR_01;	/* 0x80 - an octet > 'Z'	*/
+
+	return	a_qw | (((l_gez ^ l_gtz) & ~a_qw & UTIL$K_SWAR_80) >> 2);
+}
+
+#ifndef	__SSE2__
+/* Return a difference of the first different octets of the folded 8 octets (little-endian order) */
+inline static int	s_cmp_blind_qw	(
+	unsigned long long	a_qw1,
+	unsigned long long	a_qw2
+			)
+{
+int	l_sh = __builtin_ctzll(a_qw1 ^ a_qw2) & ~7;
+
+	return	(int) ((a_qw1 >> l_sh) & 0xFF) - (int) ((a_qw2 >> l_sh) & 0xFF);
+}
+
+/*
+ * Compare by 8 octets at once: the last 8 (or 4) octets are loaded with overlapping
+ * the previous ones, the overlapped octets are equal already.
+ */
+static int	s_cmp_blind_tail	(
+	const unsigned char *a_s1,
+	const unsigned char *a_s2,
+		size_t	a_len
+			)
+{
+unsigned long long	l_qw1, l_qw2;
+unsigned	l_lw1[2], l_lw2[2];
+int	l_diff;
+
+#if	__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	if ( a_len >= 8 )
+		{
+		for ( ; a_len > 8; a_len -= 8, a_s1 += 8, a_s2 += 8 )
+			{
+			memcpy(&l_qw1, a_s1, 8);
+			memcpy(&l_qw2, a_s2, 8);
+
+			if ( (l_qw1 = s_fold_swar(l_qw1)) != (l_qw2 = s_fold_swar(l_qw2)) )
+				return	s_cmp_blind_qw(l_qw1, l_qw2);
+			}
+
+		memcpy(&l_qw1, a_s1 + a_len - 8, 8);
+		memcpy(&l_qw2, a_s2 + a_len - 8, 8);
+
+		return	((l_qw1 = s_fold_swar(l_qw1)) != (l_qw2 = s_fold_swar(l_qw2))) ? s_cmp_blind_qw(l_qw1, l_qw2) : 0;
+		}
+
+	if ( a_len >= 4 )
+		{
+		memcpy(&l_lw1[0], a_s1, 4);
+		memcpy(&l_lw1[1], a_s1 + a_len - 4, 4);
+		memcpy(&l_lw2[0], a_s2, 4);
+		memcpy(&l_lw2[1], a_s2 + a_len - 4, 4);
+
+		memcpy(&l_qw1, l_lw1, 8);
+		memcpy(&l_qw2, l_lw2, 8);
+
+		return	((l_qw1 = s_fold_swar(l_qw1)) != (l_qw2 = s_fold_swar(l_qw2))) ? s_cmp_blind_qw(l_qw1, l_qw2) : 0;
+		}
+#endif
+
+	for ( ; a_len; a_len--, a_s1++, a_s2++ )
+		if ( (l_diff = s_fold_ch(*a_s1) - s_fold_ch(*a_s2)) )
+			return	l_diff;
+
+	return	0;
+}
+
+#endif	/* !__SSE2__ */
+
+#ifdef	__SSE2__
+inline static __m128i	s_fold_sse2	(
+		__m128i	a_x
+			)
+{
+__m128i	l_upper = _mm_cmplt_epi8(_mm_add_epi8(a_x, _mm_set1_epi8((char) (0x80 - 'A'))), _mm_set1_epi8(-128 + 26));
+
+	return	_mm_or_si128(a_x, _mm_and_si128(l_upper, _mm_set1_epi8(0x20)));
+}
+
+/*
+ * Compare a string is shorter than 16 octets by the single SSE2 register: the first and the last 8 (or 4) octets
+ * are loaded with overlapping, a position of the first different octet is mapped back to the string.
+ */
+static int	s_cmp_blind_short	(
+	const unsigned char *a_s1,
+	const unsigned char *a_s2,
+		size_t	a_len
+			)
+{
+unsigned long long	l_lo1, l_hi1 = 0, l_lo2, l_hi2 = 0;
+unsigned	l_lw1, l_lw2, l_mask, l_half;
+int	l_diff;
+
+	if ( a_len >= 8 )
+		{
+		memcpy(&l_lo1, a_s1, 8);
+		memcpy(&l_hi1, a_s1 + a_len - 8, 8);
+		memcpy(&l_lo2, a_s2, 8);
+		memcpy(&l_hi2, a_s2 + a_len - 8, 8);
+		l_half = 8;
+		}
+	else if ( a_len >= 4 )
+		{
+		memcpy(&l_lw1, a_s1, 4);
+		memcpy(&l_lw2, a_s2, 4);
+		l_lo1 = l_lw1;
+		l_lo2 = l_lw2;
+
+		memcpy(&l_lw1, a_s1 + a_len - 4, 4);
+		memcpy(&l_lw2, a_s2 + a_len - 4, 4);
+		l_lo1 |= (unsigned long long) l_lw1 << 32;
+		l_lo2 |= (unsigned long long) l_lw2 << 32;
+		l_half = 4;
+		}
+	else	{
+		for ( ; a_len; a_len--, a_s1++, a_s2++ )
+			if ( (l_diff = s_fold_ch(*a_s1) - s_fold_ch(*a_s2)) )
+				return	l_diff;
+
+		return	0;
+		}
+
+	l_mask = 0xFFFF ^ (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(s_fold_sse2(_mm_set_epi64x(l_hi1, l_lo1)),
+			s_fold_sse2(_mm_set_epi64x(l_hi2, l_lo2))));
+
+	if ( !l_mask )
+		return	0;
+
+	if ( (l_mask = __builtin_ctz(l_mask)) >= l_half )
+		l_mask += (unsigned) a_len - 2 * l_half;
+
+	return	s_fold_ch(a_s1[l_mask]) - s_fold_ch(a_s2[l_mask]);
+}
+
+static int	s_cmp_blind_sse2	(
+	const unsigned char *a_s1,
+	const unsigned char *a_s2,
+		size_t	a_len
+			)
+{
+unsigned	l_mask;
+
+	for ( ; a_len >= 16; a_len -= 16, a_s1 += 16, a_s2 += 16 )
+		{
+		l_mask = 0xFFFF ^ (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(s_fold_sse2(_mm_loadu_si128((const __m128i *) a_s1)),
+				s_fold_sse2(_mm_loadu_si128((const __m128i *) a_s2))));
+
+		if ( l_mask )
+			{
+			l_mask = __builtin_ctz(l_mask);
+			return	s_fold_ch(a_s1[l_mask]) - s_fold_ch(a_s2[l_mask]);
+			}
+		}
+
+	return	s_cmp_blind_short(a_s1, a_s2, a_len);
+}
+#else
+#define	s_cmp_blind_short	s_cmp_blind_tail
+#define	s_cmp_blind_sse2	s_cmp_blind_tail
+#endif	/* __SSE2__ */
+
+#if	defined(__GNUC__) && defined(__x86_64__)
+__attribute__((target("avx2")))
+static int	s_cmp_blind_avx2	(
+	const unsigned char *a_s1,
+	const unsigned char *a_s2,
+		size_t	a_len
+			)
+{
+__m256i	l_bias = _mm256_set1_epi8((char) (0x80 - 'A')), l_lim = _mm256_set1_epi8(-128 + 26), l_bit = _mm256_set1_epi8(0x20), l_x1, l_x2;
+unsigned	l_mask;
+
+	for ( ; a_len >= 32; a_len -= 32, a_s1 += 32, a_s2 += 32 )
+		{
+		l_x1 = _mm256_loadu_si256((const __m256i *) a_s1);
+		l_x2 = _mm256_loadu_si256((const __m256i *) a_s2);
+
+		l_x1 = _mm256_or_si256(l_x1, _mm256_and_si256(_mm256_cmpgt_epi8(l_lim, _mm256_add_epi8(l_x1, l_bias)), l_bit));
+		l_x2 = _mm256_or_si256(l_x2, _mm256_and_si256(_mm256_cmpgt_epi8(l_lim, _mm256_add_epi8(l_x2, l_bias)), l_bit));
+
+		if ( (l_mask = ~(unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(l_x1, l_x2))) )
+			{
+			l_mask = __builtin_ctz(l_mask);
+			return	s_fold_ch(a_s1[l_mask]) - s_fold_ch(a_s2[l_mask]);
+			}
+		}
+
+	return	s_cmp_blind_sse2(a_s1, a_s2, a_len);
+}
+#endif	/* __GNUC__ && __x86_64__ */
+
+typedef int (* UTIL_CMPBLIND_FN) (const unsigned char *s1, const unsigned char *s2, size_t len);
+
+static UTIL_CMPBLIND_FN	s_cmp_blind_impl;			/* Is set by the s_blind_select() at first call */
+
+static void	s_blind_select	(void)
+{
+UTIL_CMPBLIND_FN	l_fn = s_cmp_blind_sse2;
+
+#if	defined(__GNUC__) && defined(__x86_64__)
+	__builtin_cpu_init();
+
+	if ( __builtin_cpu_supports("avx2") )
+		l_fn = s_cmp_blind_avx2;
+#endif
+
+	__atomic_store_n(&s_cmp_blind_impl, l_fn, __ATOMIC_RELAXED);
+}
+
+/*
+ *   DESCRIPTION: Case-insensitive comparing of two strings (ASCII letters only, NIL is not a terminator).
+ *
+ *   INPUTS:
+ *	s1, s2:	Strings to be compared
+ *	len:	A number of octets to be compared
+ *
+ *   RETURNS:
+ *	<0, 0, >0 - like the memcmp() on the folded strings
+ */
+int	__util$memcmp_blind	(
+	const void	*a_s1,
+	const void	*a_s2,
+		size_t	a_len
+			)
+{
+UTIL_CMPBLIND_FN	l_fn;
+int	l_diff;
+
+	if ( a_len < 16 )					/* Keywords, options ...			*/
+		{
+		/* They are mostly different in the first octet, so check it before loading of the register */
+		if ( a_len && (l_diff = s_fold_ch(*(const unsigned char *) a_s1) - s_fold_ch(*(const unsigned char *) a_s2)) )
+			return	l_diff;
+
+		return	s_cmp_blind_short(a_s1, a_s2, a_len);
+		}
+
+	if ( a_len < UTIL$K_BLIND_AVX2SZ )
+		return	s_cmp_blind_sse2(a_s1, a_s2, a_len);
+
+	if ( unlikely(!(l_fn = __atomic_load_n(&s_cmp_blind_impl, __ATOMIC_RELAXED))) )
+		s_blind_select(), l_fn = s_cmp_blind_impl;
+
+	return	l_fn(a_s1, a_s2, a_len);
+}
+
+/*
+ *   DESCRIPTION: Fold a string to the lower case (ASCII letters only), source and destination can be the same.
+ *
+ *   INPUTS:
+ *	src:	A string to be folded
+ *	len:	A length of the string
+ *
+ *   OUTPUTS:
+ *	dst:	A folded string, it's not null-terminated
+ */
+void	__util$fold_blind	(
+		void	*a_dst,
+	const void	*a_src,
+		size_t	a_len
+			)
+{
+const unsigned char *l_src = (const unsigned char *) a_src;
+unsigned char	*l_dst = (unsigned char *) a_dst;
+unsigned long long	l_qw;
+
+#ifdef	__SSE2__
+	for ( ; a_len >= 16; a_len -= 16, l_src += 16, l_dst += 16 )
+		_mm_storeu_si128((__m128i *) l_dst, s_fold_sse2(_mm_loadu_si128((const __m128i *) l_src)));
+#endif
+
+	for ( ; a_len >= 8; a_len -= 8, l_src += 8, l_dst += 8 )
+		{
+		memcpy(&l_qw, l_src, 8);
+		l_qw = s_fold_swar(l_qw);
+		memcpy(l_dst, &l_qw, 8);
+		}
+
+	for ( ; a_len; a_len--, l_src++, l_dst++ )
+		*l_dst = s_fold_ch(*l_src);
+}
+
+/*
+ *   DESCRIPTION: Compute a case-insensitive hash of the string (ASCII letters only),
+ *	the strings are equal by the __util$memcmp_blind() have the same hash.
+ *
+ *   RETURNS:
+ *	A 64-bits hash value
+ */
+unsigned long long	__util$hash_blind	(
+	const void	*a_src,
+		size_t	a_len
+			)
+{
+const unsigned char *l_src = (const unsigned char *) a_src;
+unsigned long long	l_h = 0x9E3779B97F4A7C15ULL ^ a_len, l_qw;
+
+	/* 8 octets are folded and mixed per step, the tail is padded by zeros */
+	for ( ; a_len >= 8; a_len -= 8, l_src += 8 )
+		{
+		memcpy(&l_qw, l_src, 8);
+		l_h = (l_h ^ s_fold_swar(l_qw)) * 0xFF51AFD7ED558CCDULL;
+		l_h ^= l_h >> 29;
+		}
+
+	if ( a_len )
+		{
+		l_qw = 0;
+		memcpy(&l_qw, l_src, a_len);
+		l_h = (l_h ^ s_fold_swar(l_qw)) * 0xFF51AFD7ED558CCDULL;
+		}
+
+	l_h = (l_h ^ (l_h >> 33)) * 0xC4CEB9FE1A85EC53ULL;
+
+	return	l_h ^ (l_h >> 33);
+}
+
+
+/*
+ * Line normalization: the comment marker, spaces and tabs (HT, VT, CR, LF, FF) are located by the SSE2/AVX2
+ * comparisons of 64 octets per step, the result is two bit masks, so a position of the comment, the first
+ * and the last significant characters and the runs of the characters to be copied are found by the bit scans.
+ * A tail of the line is classified in the zero-padded local block, so nothing is read beyond the source.
+ */
+#define	UTIL$K_LINE_BLKSZ	64
+
+typedef void (* UTIL_LINECLS_FN) (const unsigned char *src, unsigned char marker, unsigned long long *ws, unsigned long long *mk);
+
+static void	s_linecls_scalar	(
+	const unsigned char *a_src,
+	unsigned char	a_marker,
+	unsigned long long *a_ws,
+	unsigned long long *a_mk
+			)
+{
+int	i;
+
+	for ( *a_ws = *a_mk = 0, i = 0; i < UTIL$K_LINE_BLKSZ; i++ )
+		{
+		*a_ws |= (unsigned long long) ((a_src[i] == ' ') || ((unsigned) (a_src[i] - '\t') < 5)) << i;
+		*a_mk |= (unsigned long long) (a_src[i] == a_marker) << i;
+		}
+}
+
+#ifdef	__SSE2__
+static void	s_linecls_sse2	(
+	const unsigned char *a_src,
+	unsigned char	a_marker,
+	unsigned long long *a_ws,
+	unsigned long long *a_mk
+			)
+{
+__m128i	l_x, l_sp = _mm_set1_epi8(' '), l_bias = _mm_set1_epi8((char) (0x80 - '\t')), l_lim = _mm_set1_epi8(-128 + 5),
+	l_mark = _mm_set1_epi8((char) a_marker);
+int	i;
+
+	for ( *a_ws = *a_mk = 0, i = 0; i < UTIL$K_LINE_BLKSZ; i += 16 )
+		{
+		l_x = _mm_loadu_si128((const __m128i *) (a_src + i));
+
+		*a_ws |= (unsigned long long) (unsigned) _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(l_x, l_sp),
+				_mm_cmplt_epi8(_mm_add_epi8(l_x, l_bias), l_lim))) << i;
+		*a_mk |= (unsigned long long) (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(l_x, l_mark)) << i;
+		}
+}
+#endif	/* __SSE2__ */
+
+#if	defined(__GNUC__) && defined(__x86_64__)
+__attribute__((target("avx2")))
+static void	s_linecls_avx2	(
+	const unsigned char *a_src,
+	unsigned char	a_marker,
+	unsigned long long *a_ws,
+	unsigned long long *a_mk
+			)
+{
+__m256i	l_x0 = _mm256_loadu_si256((const __m256i *) a_src), l_x1 = _mm256_loadu_si256((const __m256i *) (a_src + 32)),
+	l_sp = _mm256_set1_epi8(' '), l_bias = _mm256_set1_epi8((char) (0x80 - '\t')), l_lim = _mm256_set1_epi8(-128 + 5),
+	l_mark = _mm256_set1_epi8((char) a_marker);
+
+	*a_ws = (unsigned) _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(l_x0, l_sp),
+			_mm256_cmpgt_epi8(l_lim, _mm256_add_epi8(l_x0, l_bias))))
+		| ((unsigned long long) (unsigned) _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(l_x1, l_sp),
+			_mm256_cmpgt_epi8(l_lim, _mm256_add_epi8(l_x1, l_bias)))) << 32);
+
+	*a_mk = (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(l_x0, l_mark))
+		| ((unsigned long long) (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(l_x1, l_mark)) << 32);
+}
+#endif	/* __GNUC__ && __x86_64__ */
+
+static UTIL_LINECLS_FN	s_linecls_impl;				/* Is set by the s_linecls_select() at first call */
+
+static void	s_linecls_select	(void)
+{
+UTIL_LINECLS_FN	l_fn = s_linecls_scalar;
+
+#ifdef	__SSE2__
+	l_fn = s_linecls_sse2;
+#endif
+
+#if	defined(__GNUC__) && defined(__x86_64__)
+	__builtin_cpu_init();
+
+	if ( __builtin_cpu_supports("avx2") )
+		l_fn = s_linecls_avx2;
+#endif
+
+	__atomic_store_n(&s_linecls_impl, l_fn, __ATOMIC_RELAXED);
+}
+
+/*
+ *   DESCRIPTION: Normalize a line in the single pass: cut it at the comment marker, remove leading and trailing
+ *	spaces or tabs (HT and VT, CR, LF), optionally remove (UTIL$M_LINE_COLLAPSE) or replace by the single space
+ *	(UTIL$M_LINE_SQUEEZE) the spaces or tabs inside the line. The source is not need to be null-terminated.
+ *	Without the output buffer a view of the source is returned, the source is not changed.
+ *	The output buffer can be the same as the source.
+ *
+ *   INPUTS:
+ *	src:	A line to be normalized
+ *	srclen:	A length of the line
+ *	marker:	A comment marker, 0 - no comments
+ *	flags:	UTIL$M_LINE_COLLAPSE, UTIL$M_LINE_SQUEEZE - the output buffer is required
+ *	dstsz:	A size of the output buffer
+ *
+ *   OUTPUTS:
+ *	dst:	(optional) A null-terminated normalized line, it's truncated to fit into the buffer
+ *
+ *   RETURNS:
+ *	A view of the normalized line in the source or in the output buffer
+ */
+STRVIEW	__util$sv_normalize	(
+	const char	*a_src,
+		size_t	a_srclen,
+		char	a_marker,
+		int	a_flags,
+		char	*a_dst,
+		size_t	a_dstsz
+			)
+{
+const unsigned char *l_src = (const unsigned char *) a_src;
+unsigned char	l_blk[UTIL$K_LINE_BLKSZ];
+unsigned long long	l_ws, l_mk, l_valid, l_ns;
+size_t	l_off, l_blen, l_first = (size_t) -1, l_last = 0, l_outlen = 0, l_outend = 0, l_pos, l_run;
+STRVIEW	l_sv = {a_src, 0};
+UTIL_LINECLS_FN	l_fn;
+int	l_done = 0, l_copy;
+
+	if ( a_dst && !a_dstsz )
+		a_dst = NULL;
+
+	l_copy = (a_flags & (UTIL$M_LINE_COLLAPSE | UTIL$M_LINE_SQUEEZE)) && a_dst;
+
+	if ( unlikely(!(l_fn = __atomic_load_n(&s_linecls_impl, __ATOMIC_RELAXED))) )
+		s_linecls_select(), l_fn = s_linecls_impl;
+
+	for ( l_off = 0; !l_done && (l_off < a_srclen); l_off += UTIL$K_LINE_BLKSZ )
+		{
+		l_blen = a_srclen - l_off;
+
+		if ( l_blen < UTIL$K_LINE_BLKSZ )
+			{
+			memcpy(l_blk, l_src + l_off, l_blen);
+			memset(l_blk + l_blen, 0, UTIL$K_LINE_BLKSZ - l_blen);
+			l_fn(l_blk, (unsigned char) a_marker, &l_ws, &l_mk);
+			l_valid = (1ULL << l_blen) - 1;
+			}
+		else	{
+			l_fn(l_src + l_off, (unsigned char) a_marker, &l_ws, &l_mk);
+			l_valid = ~0ULL;
+			}
+
+		/* Cut the line at the first comment marker */
+		if ( a_marker && (l_mk &= l_valid) )
+			{
+			l_valid &= (1ULL << __builtin_ctzll(l_mk)) - 1;
+			l_done = 1;
+			}
+
+		if ( !(l_ns = ~l_ws & l_valid) )
+			continue;
+
+		if ( l_first == (size_t) -1 )
+			l_first = l_off + __builtin_ctzll(l_ns);
+
+		l_last = l_off + 63 - __builtin_clzll(l_ns);
+
+		if ( !l_copy )
+			continue;
+
+		/* Copy the runs of the significant characters, the output is never ahead of the source */
+		while ( l_ns )
+			{
+			l_pos = __builtin_ctzll(l_ns);
+			l_run = (~(l_ns >> l_pos)) ? (size_t) __builtin_ctzll(~(l_ns >> l_pos)) : UTIL$K_LINE_BLKSZ - l_pos;
+			l_ns &= (l_pos + l_run < UTIL$K_LINE_BLKSZ) ? ~(((1ULL << l_run) - 1) << l_pos) : ((1ULL << l_pos) - 1);
+
+			l_pos += l_off;
+
+			if ( (a_flags & UTIL$M_LINE_SQUEEZE) && !(a_flags & UTIL$M_LINE_COLLAPSE)
+				&& l_outlen && (l_pos > l_outend) && (l_outlen < a_dstsz - 1) )
+				a_dst[l_outlen++] = ' ';
+
+			l_outend = l_pos + l_run;
+			l_run = (l_run < a_dstsz - 1 - l_outlen) ? l_run : a_dstsz - 1 - l_outlen;
+			memmove(a_dst + l_outlen, a_src + l_pos, l_run);
+			l_outlen += l_run;
+			}
+		}
+
+	if ( l_copy )
+		{
+		a_dst[l_outlen] = '\0';
+		l_sv.ptr = a_dst;
+		l_sv.len = l_outlen;
+		}
+	else if ( l_first != (size_t) -1 )
+		{
+		l_sv.ptr = a_src + l_first;
+		l_sv.len = l_last + 1 - l_first;
+
+		if ( a_dst )
+			{
+			l_sv.len = (l_sv.len < a_dstsz - 1) ? l_sv.len : a_dstsz - 1;
+			memmove(a_dst, l_sv.ptr, l_sv.len);
+			a_dst[l_sv.len] = '\0';
+			l_sv.ptr = a_dst;
+			}
+		}
+	else if ( a_dst )
+		{
+		*a_dst = '\0';
+		l_sv.ptr = a_dst;
+		}
+
+	return	l_sv;
+}
+
+
+/*
+ * Hexadecimal encoding and decoding: SSSE3/AVX2 kernels convert 16/32 octets per step,
+ * a version is selected by the CPU features at first call, the scalar code is used for the tails.
+ * Only '0'-'9', 'a'-'f', 'A'-'F' are accepted by the decoder.
+ */
+#define	UTIL$K_HEX_BAD	0xFF
+
+static const unsigned char s_hexval[256] = {
+	['0'] = 0x10, ['1'] = 0x11, ['2'] = 0x12, ['3'] = 0x13, ['4'] = 0x14,	/* Biased by 0x10 to keep 0 as "invalid" */
+	['5'] = 0x15, ['6'] = 0x16, ['7'] = 0x17, ['8'] = 0x18, ['9'] = 0x19,
+	['a'] = 0x1a, ['b'] = 0x1b, ['c'] = 0x1c, ['d'] = 0x1d, ['e'] = 0x1e, ['f'] = 0x1f,
+	['A'] = 0x1a, ['B'] = 0x1b, ['C'] = 0x1c, ['D'] = 0x1d, ['E'] = 0x1e, ['F'] = 0x1f,
+	};
+
+/* Return a value of the hex digit, UTIL$K_HEX_BAD - not a hex digit */
+inline static unsigned char	s_hex_nibble	(
+		unsigned char	a_ch
+			)
+{
+	return	s_hexval[a_ch] ? s_hexval[a_ch] - 0x10 : UTIL$K_HEX_BAD;
+}
+
+static void	s_bin2hex_scalar	(
+	const unsigned char *a_src,
+		size_t	a_srclen,
+		char	*a_dst
+			)
+{
+	for ( ; a_srclen; a_srclen--, a_src++, a_dst += 2)
+		memcpy(a_dst, __util$hex2lut_lc + (*a_src) * 2, 2);
+}
+
+/* Decode pairs of the hex digits, return a number of the source characters has been decoded */
+static size_t	s_hex2bin_scalar	(
+	const unsigned char *a_src,
+		size_t	a_srclen,
+	unsigned char	*a_dst
+			)
+{
+unsigned char	h, l;
+size_t	i;
+
+	for ( i = 0; (i + 1) < a_srclen; i += 2, a_dst++)
+		{
+		h = s_hex_nibble(a_src[i]);
+		l = s_hex_nibble(a_src[i + 1]);
+
+		if ( (h | l) == UTIL$K_HEX_BAD )
+			return	(h == UTIL$K_HEX_BAD) ? i : i + 1;
+
+		*a_dst = (unsigned char) ((h << 4) | l);
+		}
+
+	return	i;
+}
+
+#if	defined(__GNUC__) && defined(__x86_64__)
+__attribute__((target("ssse3")))
+static void	s_bin2hex_ssse3	(
+	const unsigned char *a_src,
+		size_t	a_srclen,
+		char	*a_dst
+			)
+{
+const __m128i	l_lut = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'),
+		l_mask = _mm_set1_epi8(0x0F);
+__m128i	l_src, l_hi, l_lo;
+
+	for ( ; a_srclen >= 16; a_srclen -= 16, a_src += 16, a_dst += 32)
+		{
+		l_src = _mm_loadu_si128((const __m128i *) a_src);
+
+		l_hi = _mm_shuffle_epi8(l_lut, _mm_and_si128(_mm_srli_epi16(l_src, 4), l_mask));
+		l_lo = _mm_shuffle_epi8(l_lut, _mm_and_si128(l_src, l_mask));
+
+		_mm_storeu_si128((__m128i *) a_dst, _mm_unpacklo_epi8(l_hi, l_lo));
+		_mm_storeu_si128((__m128i *) (a_dst + 16), _mm_unpackhi_epi8(l_hi, l_lo));
+		}
+
+	s_bin2hex_scalar(a_src, a_srclen, a_dst);
+}
+
+/* Map 16 characters to the nibbles, return a mask of the invalid characters */
+__attribute__((target("ssse3")))
+inline static unsigned	s_hex_nibbles_ssse3	(
+		__m128i	a_src,
+		__m128i	*a_val
+			)
+{
+__m128i	l_dig, l_let, l_isdig, l_islet;
+
+	l_dig = _mm_sub_epi8(a_src, _mm_set1_epi8('0'));
+	l_let = _mm_sub_epi8(_mm_or_si128(a_src, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+
+	l_isdig = _mm_cmpeq_epi8(_mm_min_epu8(l_dig, _mm_set1_epi8(9)), l_dig);
+	l_islet = _mm_cmpeq_epi8(_mm_min_epu8(l_let, _mm_set1_epi8(5)), l_let);
+
+	*a_val = _mm_or_si128(_mm_and_si128(l_isdig, l_dig), _mm_and_si128(l_islet, _mm_add_epi8(l_let, _mm_set1_epi8(10))));
+
+	return	~(unsigned) _mm_movemask_epi8(_mm_or_si128(l_isdig, l_islet)) & 0xFFFF;
+}
+
+__attribute__((target("ssse3")))
+static size_t	s_hex2bin_ssse3	(
+	const unsigned char *a_src,
+		size_t	a_srclen,
+	unsigned char	*a_dst
+			)
+{
+const __m128i	l_mul = _mm_set1_epi16(0x0110);		/* High nibble * 16 + low nibble * 1 */
+__m128i	l_v1, l_v2;
+size_t	i;
+
+	for ( i = 0; (i + 32) <= a_srclen; i += 32, a_dst += 16)
+		{
+		if ( s_hex_nibbles_ssse3(_mm_loadu_si128((const __m128i *) (a_src + i)), &l_v1)
+			| s_hex_nibbles_ssse3(_mm_loadu_si128((const __m128i *) (a_src + i + 16)), &l_v2) )
+			break;				/* Let the scalar code to find a position of the invalid character */
+
+		_mm_storeu_si128((__m128i *) a_dst, _mm_packus_epi16(_mm_maddubs_epi16(l_v1, l_mul), _mm_maddubs_epi16(l_v2, l_mul)));
+		}
+
+	return	i + s_hex2bin_scalar(a_src + i, a_srclen - i, a_dst);
+}
+
+__attribute__((target("avx2")))
+static void	s_bin2hex_avx2	(
+	const unsigned char *a_src,
+		size_t	a_srclen,
+		char	*a_dst
+			)
+{
+const __m256i	l_lut = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+			'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'),
+		l_mask = _mm256_set1_epi8(0x0F);
+__m256i	l_src, l_hi, l_lo, l_r1, l_r2;
+
+	for ( ; a_srclen >= 32; a_srclen -= 32, a_src += 32, a_dst += 64)
+		{
+		l_src = _mm256_loadu_si256((const __m256i *) a_src);
+
+		l_hi = _mm256_shuffle_epi8(l_lut, _mm256_and_si256(_mm256_srli_epi16(l_src, 4), l_mask));
+		l_lo = _mm256_shuffle_epi8(l_lut, _mm256_and_si256(l_src, l_mask));
+
+		/* Unpacking is working inside of the 128-bits lanes, so reorder lanes */
+		l_r1 = _mm256_unpacklo_epi8(l_hi, l_lo);
+		l_r2 = _mm256_unpackhi_epi8(l_hi, l_lo);
+
+		_mm256_storeu_si256((__m256i *) a_dst, _mm256_permute2x128_si256(l_r1, l_r2, 0x20));
+		_mm256_storeu_si256((__m256i *) (a_dst + 32), _mm256_permute2x128_si256(l_r1, l_r2, 0x31));
+		}
+
+	s_bin2hex_ssse3(a_src, a_srclen, a_dst);
+}
+
+__attribute__((target("avx2")))
+inline static unsigned	s_hex_nibbles_avx2	(
+		__m256i	a_src,
+		__m256i	*a_val
+			)
+{
+__m256i	l_dig, l_let, l_isdig, l_islet;
+
+	l_dig = _mm256_sub_epi8(a_src, _mm256_set1_epi8('0'));
+	l_let = _mm256_sub_epi8(_mm256_or_si256(a_src, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+
+	l_isdig = _mm256_cmpeq_epi8(_mm256_min_epu8(l_dig, _mm256_set1_epi8(9)), l_dig);
+	l_islet = _mm256_cmpeq_epi8(_mm256_min_epu8(l_let, _mm256_set1_epi8(5)), l_let);
+
+	*a_val = _mm256_or_si256(_mm256_and_si256(l_isdig, l_dig), _mm256_and_si256(l_islet, _mm256_add_epi8(l_let, _mm256_set1_epi8(10))));
+
+	return	~(unsigned) _mm256_movemask_epi8(_mm256_or_si256(l_isdig, l_islet));
+}
+
+__attribute__((target("avx2")))
+static size_t	s_hex2bin_avx2	(
+	const unsigned char *a_src,
+		size_t	a_srclen,
+	unsigned char	*a_dst
+			)
+{
+const __m256i	l_mul = _mm256_set1_epi16(0x0110);
+__m256i	l_v1, l_v2, l_out;
+size_t	i;
+
+	for ( i = 0; (i + 64) <= a_srclen; i += 64, a_dst += 32)
+		{
+		if ( s_hex_nibbles_avx2(_mm256_loadu_si256((const __m256i *) (a_src + i)), &l_v1)
+			| s_hex_nibbles_avx2(_mm256_loadu_si256((const __m256i *) (a_src + i + 32)), &l_v2) )
+			break;
+
+		/* Packing is working inside of the 128-bits lanes: 64-bits quads are come as 0, 2, 1, 3 */
+		l_out = _mm256_packus_epi16(_mm256_maddubs_epi16(l_v1, l_mul), _mm256_maddubs_epi16(l_v2, l_mul));
+		_mm256_storeu_si256((__m256i *) a_dst, _mm256_permute4x64_epi64(l_out, 0xD8));
+		}
+
+	return	i + s_hex2bin_ssse3(a_src + i, a_srclen - i, a_dst);
+}
+#endif	/* __GNUC__ && __x86_64__ */
+
+typedef void (* UTIL_BIN2HEX_FN) (const unsigned char *src, size_t srclen, char *dst);
+typedef size_t (* UTIL_HEX2BIN_FN) (const unsigned char *src, size_t srclen, unsigned char *dst);
+
+static UTIL_BIN2HEX_FN	s_bin2hex_impl;				/* Are set by the s_hex_select() at first call */
+static UTIL_HEX2BIN_FN	s_hex2bin_impl;
+
+static void	s_hex_select	(void)
+{
+UTIL_BIN2HEX_FN	l_enc = s_bin2hex_scalar;
+UTIL_HEX2BIN_FN	l_dec = s_hex2bin_scalar;
+
+#if	defined(__GNUC__) && defined(__x86_64__)
+	__builtin_cpu_init();
+
+	if ( __builtin_cpu_supports("avx2") )
+		l_enc = s_bin2hex_avx2, l_dec = s_hex2bin_avx2;
+	else if ( __builtin_cpu_supports("ssse3") )
+		l_enc = s_bin2hex_ssse3, l_dec = s_hex2bin_ssse3;
+#endif
+
+	__atomic_store_n(&s_hex2bin_impl, l_dec, __ATOMIC_RELAXED);
+	__atomic_store_n(&s_bin2hex_impl, l_enc, __ATOMIC_RELAXED);
+}
+
+/*
+ *   DESCRIPTION: Convert a sequence of octets to the hexadecimal string (lowercase),
+ *	the output buffer must have room for <srcbinlen * 2 + 1> characters.
+ *
+ *   INPUTS:
+ *	srcbin:		An address of the source data
+ *	srcbinlen:	A length of the source data
+ *
+ *   OUTPUTS:
+ *	dsthex:		A null-terminated hex-string
+ *
+ *   RETURNS:
+ *	A length of the hex-string
+ */
+size_t	__util$bin2hex	(
+	const void	*a_srcbin,
+		void	*a_dsthex,
+		size_t	a_srcbinlen
+			)
+{
+UTIL_BIN2HEX_FN	l_fn;
+
+	if ( unlikely(!(l_fn = __atomic_load_n(&s_bin2hex_impl, __ATOMIC_RELAXED))) )
+		s_hex_select(), l_fn = s_bin2hex_impl;
+
+	l_fn((const unsigned char *) a_srcbin, a_srcbinlen, (char *) a_dsthex);
+	((char *) a_dsthex)[a_srcbinlen * 2] = '\0';
+
+	return	a_srcbinlen * 2;
+}
+
+/*
+ *   DESCRIPTION: Convert a hexadecimal string to the sequence of octets with a strict check
+ *	of the input, the output buffer must have room for <(srchexlen + 1) / 2> octets.
+ *	A string of odd length is converted as it has a leading '0'.
+ *
+ *   INPUTS:
+ *	srchex:		An address of the hex-string
+ *	srchexlen:	A length of the hex-string
+ *
+ *   OUTPUTS:
+ *	dstbin:		Converted octets
+ *	dstbinlen:	(optional) A number of octets have been stored
+ *	errpos:		(optional) An offset of the first invalid character in the hex-string
+ *
+ *   RETURNS:
+ *	STS$K_SUCCESS
+ *	STS$K_ERROR	- invalid character
+ */
+int	__util$hex2bin_ex	(
+	const void	*a_srchex,
+		size_t	a_srchexlen,
+		void	*a_dstbin,
+		size_t	*a_dstbinlen,
+		size_t	*a_errpos
+			)
+{
+const unsigned char *l_src = (const unsigned char *) a_srchex;
+unsigned char	*l_dst = (unsigned char *) a_dstbin, l_nib;
+UTIL_HEX2BIN_FN	l_fn;
+size_t	l_done = 0, l_len = a_srchexlen;
+
+	if ( a_dstbinlen )
+		*a_dstbinlen = 0;
+
+	if ( a_srchexlen & 1 )
+		{
+		if ( (l_nib = s_hex_nibble(*l_src)) == UTIL$K_HEX_BAD )
+			goto	bad_char;
+
+		*(l_dst++) = l_nib;
+		l_src++;
+		l_len--;
+		}
+
+	if ( unlikely(!(l_fn = __atomic_load_n(&s_hex2bin_impl, __ATOMIC_RELAXED))) )
+		s_hex_select(), l_fn = s_hex2bin_impl;
+
+	l_done = l_fn(l_src, l_len, l_dst);
+
+	if ( a_dstbinlen )
+		*a_dstbinlen = (a_srchexlen & 1) + l_done / 2;
+
+	if ( l_done == l_len )
+		return	STS$K_SUCCESS;
+
+bad_char:
+	if ( a_errpos )
+		*a_errpos = (l_src - (const unsigned char *) a_srchex) + l_done;
+
+	return	STS$K_ERROR;
+}
+
+/*
+ *   DESCRIPTION: Convert a hexadecimal string to the sequence of octets,
+ *	see __util$hex2bin_ex().
+ *
+ *   RETURNS:
+ *	A length of the data in the output buffer, 0 - invalid character in the hex-string
+ */
+size_t	__util$hex2bin	(
+	const void	*a_srchex,
+		void	*a_dstbin,
+		size_t	a_srchexlen
+			)
+{
+size_t	l_len;
+
+	return	(1 & __util$hex2bin_ex(a_srchex, a_srchexlen, a_dstbin, &l_len, NULL)) ? l_len : 0;
+}
+
+
+/*
+ * Base64 and Base64url (RFC 4648) encoding and decoding: SSSE3/AVX2 kernels convert 12/24 octets
+ * to 16/32 characters and back per step, a version is selected by the CPU features at first call,
+ * the scalar code is used for the tails and for the groups with a padding.
+ * The decoder is strict: only the characters of the selected alphabet are accepted, the padding
+ * must be correct (or absent with UTIL$M_B64_NOPAD), unused bits of the last group must be zero.
+ */
+static const char s_b64chr[2][65] = {
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+	};
+
+static const unsigned char s_b64val[2][256] = {		/* 0xFF - not a character of the alphabet	*/
+	{
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3e, 0xff, 0xff, 0xff, 0x3f,
+		0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+		0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+		0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	},
+	{
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3e, 0xff, 0xff,
+		0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+		0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0x3f,
+		0xff, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+		0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	}
+	};
+
+/* Encode <srclen / 3> groups of 3 octets to 4 characters */
+static size_t	s_b64enc_scalar	(
+	const unsigned char *a_src,
+		size_t	a_srclen,
+		char	*a_dst,
+		int	a_url
+			)
+{
+const char	*l_chr = s_b64chr[a_url];
+char	*l_dst = a_dst;
+unsigned	l_grp;
+
+	for ( ; a_srclen >= 3; a_srclen -= 3, a_src += 3, l_dst += 4)
+		{
+		l_grp = (a_src[0] << 16) | (a_src[1] << 8) | a_src[2];
+
+		l_dst[0] = l_chr[l_grp >> 18];
+		l_dst[1] = l_chr[(l_grp >> 12) & 0x3F];
+		l_dst[2] = l_chr[(l_grp >> 6) & 0x3F];
+		l_dst[3] = l_chr[l_grp & 0x3F];
+		}
+
+	return	l_dst - a_dst;
+}
+
+/* Decode groups of 4 characters up to the group with an invalid character or padding, return a number of processed characters */
+static size_t	s_b64dec_scalar	(
+	const unsigned char *a_src,
+		size_t	a_srclen,
+	unsigned char	*a_dst,
+		int	a_url
+			)
+{
+const unsigned char *l_val = s_b64val[a_url];
+size_t	l_done;
+unsigned	l_a, l_b, l_c, l_d;
+
+	for ( l_done = 0; a_srclen - l_done >= 4; l_done += 4, a_dst += 3 )
+		{
+		l_a = l_val[a_src[l_done]];
+		l_b = l_val[a_src[l_done + 1]];
+		l_c = l_val[a_src[l_done + 2]];
+		l_d = l_val[a_src[l_done + 3]];
+
+		if ( (l_a | l_b | l_c | l_d) & 0x80 )
+			break;
+
+		l_a = (l_a << 18) | (l_b << 12) | (l_c << 6) | l_d;
+		a_dst[0] = (unsigned char) (l_a >> 16);
+		a_dst[1] = (unsigned char) (l_a >> 8);
+		a_dst[2] = (unsigned char) l_a;
+		}
+
+	return	l_done;
+}
+
+#if	defined(__GNUC__) && defined(__x86_64__)
+/*
+ * 12 octets of the 128-bits lane are spread to 16 of the 6-bits indexes by the shuffle and multiplications,
+ * the indexes are translated to the characters by adding an offset is selected by the range of the index.
+ */
+__attribute__((target("ssse3")))
+static inline __m128i	s_b64enc_ssse3_lane	(
+		__m128i	a_in,
+		__m128i	a_shift
+			)
+{
+__m128i	l_idx, l_res;
+
+	a_in = _mm_shuffle_epi8(a_in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+
+	l_idx = _mm_or_si128(_mm_mulhi_epu16(_mm_and_si128(a_in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040)),
+			_mm_mullo_epi16(_mm_and_si128(a_in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010)));
+
+	/* 0-25: 13, 26-51: 0, 52-61: 1-10, 62: 11, 63: 12 */
+	l_res = _mm_subs_epu8(l_idx, _mm_set1_epi8(51));
+	l_res = _mm_or_si128(l_res, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), l_idx), _mm_set1_epi8(13)));
+
+	return	_mm_add_epi8(_mm_shuffle_epi8(a_shift, l_res), l_idx);
+}
+
+static inline __m128i	s_b64_shift_lut	(
+		int	a_url
+			)
+{
+	return	_mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, (a_url ? '-' : '+') - 62, (a_url ? '_' : '/') - 63, 'A', 0, 0);
+}
+
+__attribute__((target("ssse3")))
+static size_t	s_b64enc_ssse3	(
+	const unsigned char *a_src,
+		size_t	a_srclen,
+		char	*a_dst,
+		int	a_url
+			)
+{
+__m128i	l_shift = s_b64_shift_lut(a_url);
+char	*l_dst = a_dst;
+
+	/* 16 octets are loaded to get 12 */
+	for ( ; a_srclen >= 16; a_srclen -= 12, a_src += 12, l_dst += 16 )
+		_mm_storeu_si128((__m128i *) l_dst, s_b64enc_ssse3_lane(_mm_loadu_si128((const __m128i *) a_src), l_shift));
+
+	return	(l_dst - a_dst) + s_b64enc_scalar(a_src, a_srclen, l_dst, a_url);
+}
+
+/*
+ * 16 characters are checked by the two lookups by the high and low nibbles, translated to 6-bits values
+ * by adding an offset is selected by the high nibble, packed by the multiplications to 12 octets.
+ * Base64url characters are translated to the Base64 ones, '+' and '/' are replaced by the invalid character.
+ */
+__attribute__((target("ssse3")))
+static inline int	s_b64dec_ssse3_lane	(
+		__m128i	a_in,
+		__m128i	*a_out,
+		int	a_url
+			)
+{
+__m128i	l_hi, l_lo, l_m2f = _mm_set1_epi8(0x2f);
+
+	if ( a_url )
+		{
+		a_in = _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi8(a_in, _mm_set1_epi8('+')), _mm_cmpeq_epi8(a_in, _mm_set1_epi8('/'))), a_in);
+		a_in = _mm_xor_si128(a_in, _mm_or_si128(_mm_and_si128(_mm_cmpeq_epi8(a_in, _mm_set1_epi8('-')), _mm_set1_epi8('-' ^ '+')),
+					_mm_and_si128(_mm_cmpeq_epi8(a_in, _mm_set1_epi8('_')), _mm_set1_epi8('_' ^ '/'))));
+		}
+
+	l_hi = _mm_and_si128(_mm_srli_epi32(a_in, 4), l_m2f);
+	l_lo = _mm_and_si128(a_in, l_m2f);
+
+	if ( _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(
+			_mm_shuffle_epi8(_mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A), l_lo),
+			_mm_shuffle_epi8(_mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10), l_hi)),
+			_mm_setzero_si128())) != 0xFFFF )
+		return	STS$K_ERROR;
+
+	a_in = _mm_add_epi8(a_in, _mm_shuffle_epi8(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0),
+			_mm_add_epi8(_mm_cmpeq_epi8(a_in, l_m2f), l_hi)));
+
+	a_in = _mm_madd_epi16(_mm_maddubs_epi16(a_in, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+	*a_out = _mm_shuffle_epi8(a_in, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+	return	STS$K_SUCCESS;
+}
+
+__attribute__((target("ssse3")))
+static size_t	s_b64dec_ssse3	(
+	const unsigned char *a_src,
+		size_t	a_srclen,
+	unsigned char	*a_dst,
+		int	a_url
+			)
+{
+size_t	l_done;
+__m128i	l_out;
+
+	/* 16 octets are stored to put 12, so a next group must follow */
+	for ( l_done = 0; a_srclen - l_done >= 32; l_done += 16, a_dst += 12 )
+		{
+		if ( !(1 & s_b64dec_ssse3_lane(_mm_loadu_si128((const __m128i *) (a_src + l_done)), &l_out, a_url)) )
+			break;
+
+		_mm_storeu_si128((__m128i *) a_dst, l_out);
+		}
+
+	return	l_done + s_b64dec_scalar(a_src + l_done, a_srclen - l_done, a_dst, a_url);
+}
+
+__attribute__((target("avx2")))
+static size_t	s_b64enc_avx2	(
+	const unsigned char *a_src,
+		size_t	a_srclen,
+		char	*a_dst,
+		int	a_url
+			)
+{
+__m256i	l_in, l_idx, l_res, l_shift = _mm256_broadcastsi128_si256(s_b64_shift_lut(a_url));
+char	*l_dst = a_dst;
+
+	/* 12 octets to the each of lanes, 28 octets are read */
+	for ( ; a_srclen >= 32; a_srclen -= 24, a_src += 24, l_dst += 32 )
+		{
+		l_in = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) a_src)),
+				_mm_loadu_si128((const __m128i *) (a_src + 12)), 1);
+
+		l_in = _mm256_shuffle_epi8(l_in, _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+				1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+
+		l_idx = _mm256_or_si256(_mm256_mulhi_epu16(_mm256_and_si256(l_in, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040)),
+				_mm256_mullo_epi16(_mm256_and_si256(l_in, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010)));
+
+		l_res = _mm256_subs_epu8(l_idx, _mm256_set1_epi8(51));
+		l_res = _mm256_or_si256(l_res, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), l_idx), _mm256_set1_epi8(13)));
+
+		_mm256_storeu_si256((__m256i *) l_dst, _mm256_add_epi8(_mm256_shuffle_epi8(l_shift, l_res), l_idx));
+		}
+
+	return	(l_dst - a_dst) + s_b64enc_ssse3(a_src, a_srclen, l_dst, a_url);
+}
+
+__attribute__((target("avx2")))
+static size_t	s_b64dec_avx2	(
+	const unsigned char *a_src,
+		size_t	a_srclen,
+	unsigned char	*a_dst,
+		int	a_url
+			)
+{
+size_t	l_done;
+__m256i	l_in, l_hi, l_lo, l_m2f = _mm256_set1_epi8(0x2f);
+
+	/* 32 octets are stored to put 24, so a next block must follow */
+	for ( l_done = 0; a_srclen - l_done >= 64; l_done += 32, a_dst += 24 )
+		{
+		l_in = _mm256_loadu_si256((const __m256i *) (a_src + l_done));
+
+		if ( a_url )
+			{
+			l_in = _mm256_andnot_si256(_mm256_or_si256(_mm256_cmpeq_epi8(l_in, _mm256_set1_epi8('+')),
+					_mm256_cmpeq_epi8(l_in, _mm256_set1_epi8('/'))), l_in);
+			l_in = _mm256_xor_si256(l_in, _mm256_or_si256(
+					_mm256_and_si256(_mm256_cmpeq_epi8(l_in, _mm256_set1_epi8('-')), _mm256_set1_epi8('-' ^ '+')),
+					_mm256_and_si256(_mm256_cmpeq_epi8(l_in, _mm256_set1_epi8('_')), _mm256_set1_epi8('_' ^ '/'))));
+			}
+
+		l_hi = _mm256_and_si256(_mm256_srli_epi32(l_in, 4), l_m2f);
+		l_lo = _mm256_and_si256(l_in, l_m2f);
+
+		if ( !_mm256_testz_si256(
+			_mm256_shuffle_epi8(_mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+				0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A), l_lo),
+			_mm256_shuffle_epi8(_mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+				0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10), l_hi)) )
+			break;
+
+		l_in = _mm256_add_epi8(l_in, _mm256_shuffle_epi8(_mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+				0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0), _mm256_add_epi8(_mm256_cmpeq_epi8(l_in, l_m2f), l_hi)));
+
+		l_in = _mm256_madd_epi16(_mm256_maddubs_epi16(l_in, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+		l_in = _mm256_shuffle_epi8(l_in, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+				2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+		_mm256_storeu_si256((__m256i *) a_dst, _mm256_permutevar8x32_epi32(l_in, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7)));
+		}
+
+	return	l_done + s_b64dec_ssse3(a_src + l_done, a_srclen - l_done, a_dst, a_url);
+}
+#endif	/* __GNUC__ && __x86_64__ */
+
+typedef size_t (* UTIL_B64ENC_FN) (const unsigned char *src, size_t srclen, char *dst, int url);
+typedef size_t (* UTIL_B64DEC_FN) (const unsigned char *src, size_t srclen, unsigned char *dst, int url);
+
+static UTIL_B64ENC_FN	s_b64enc_impl;				/* Are set by the s_b64_select() at first call */
+static UTIL_B64DEC_FN	s_b64dec_impl;
+
+static void	s_b64_select	(void)
+{
+UTIL_B64ENC_FN	l_enc = s_b64enc_scalar;
+UTIL_B64DEC_FN	l_dec = s_b64dec_scalar;
+
+#if	defined(__GNUC__) && defined(__x86_64__)
+	__builtin_cpu_init();
+
+	if ( __builtin_cpu_supports("avx2") )
+		l_enc = s_b64enc_avx2, l_dec = s_b64dec_avx2;
+	else if ( __builtin_cpu_supports("ssse3") )
+		l_enc = s_b64enc_ssse3, l_dec = s_b64dec_ssse3;
+#endif
+
+	__atomic_store_n(&s_b64dec_impl, l_dec, __ATOMIC_RELAXED);
+	__atomic_store_n(&s_b64enc_impl, l_enc, __ATOMIC_RELAXED);
+}
+
+/*
+ *   DESCRIPTION: Decode a last group of 4 characters is not accepted by the bulk decoder:
+ *	a group with the padding or with an invalid character.
+ *
+ *   OUTPUTS:
+ *	dst:	Decoded octets
+ *	dstlen:	A number of decoded octets
+ *	badpos:	An index of the invalid character in the group
+ *
+ *   RETURNS:
+ *	STS$K_SUCCESS	- a group without padding
+ *	STS$K_INFO	- a group with the padding, it must be the last one
+ *	STS$K_ERROR	- invalid character
+ */
+static int	s_b64dec_group	(
+	const unsigned char *a_grp,
+	unsigned char	*a_dst,
+		size_t	*a_dstlen,
+		int	*a_badpos,
+		int	a_flags
+			)
+{
+const unsigned char *l_val = s_b64val[a_flags & UTIL$M_B64_URL];
+unsigned	l_a = l_val[a_grp[0]], l_b = l_val[a_grp[1]], l_c = l_val[a_grp[2]], l_d = l_val[a_grp[3]];
+int	l_pad = !(a_flags & UTIL$M_B64_NOPAD);
+
+	*a_dstlen = 0;
+
+	if ( (l_a | l_b) & 0x80 )
+		{
+		*a_badpos = (l_a & 0x80) ? 0 : 1;
+		return	STS$K_ERROR;
+		}
+
+	if ( l_pad && (a_grp[2] == '=') )			/* "xx==" - 1 octet, 4 bits must be zero	*/
+		{
+		if ( (a_grp[3] != '=') || (l_b & 0x0F) )
+			{
+			*a_badpos = (a_grp[3] != '=') ? 2 : 1;
+			return	STS$K_ERROR;
+			}
+
+		a_dst[0] = (unsigned char) ((l_a << 2) | (l_b >> 4));
+		*a_dstlen = 1;
+
+		return	STS$K_INFO;
+		}
+
+	if ( l_c & 0x80 )
+		{
+		*a_badpos = 2;
+		return	STS$K_ERROR;
+		}
+
+	if ( l_pad && (a_grp[3] == '=') )			/* "xxx=" - 2 octets, 2 bits must be zero	*/
+		{
+		if ( l_c & 0x03 )
+			{
+			*a_badpos = 2;
+			return	STS$K_ERROR;
+			}
+
+		a_dst[0] = (unsigned char) ((l_a << 2) | (l_b >> 4));
+		a_dst[1] = (unsigned char) ((l_b << 4) | (l_c >> 2));
+		*a_dstlen = 2;
+
+		return	STS$K_INFO;
+		}
+
+	if ( l_d & 0x80 )
+		{
+		*a_badpos = 3;
+		return	STS$K_ERROR;
+		}
+
+	a_dst[0] = (unsigned char) ((l_a << 2) | (l_b >> 4));
+	a_dst[1] = (unsigned char) ((l_b << 4) | (l_c >> 2));
+	a_dst[2] = (unsigned char) ((l_c << 6) | l_d);
+	*a_dstlen = 3;
+
+	return	STS$K_SUCCESS;
+}
+
+/* Initialize a context of the chunked encoding or decoding, flags: UTIL$M_B64_URL, UTIL$M_B64_NOPAD */
+void	__util$b64_init	(
+		UTIL_B64CTX	*a_ctx,
+		int		a_flags
+			)
+{
+	memset(a_ctx, 0, sizeof(UTIL_B64CTX));
+	a_ctx->flags = a_flags;
+}
+
+/*
+ *   DESCRIPTION: Encode a next chunk of data, an incomplete group of octets is kept in the context
+ *	up to the next call. The output buffer must have room for $B64ENCLEN(srclen + 2) characters.
+ *
+ *   RETURNS:
+ *	A number of characters have been put into the output buffer
+ */
+size_t	__util$b64enc_update	(
+		UTIL_B64CTX	*a_ctx,
+	const void	*a_src,
+		size_t	a_srclen,
+		void	*a_dst
+			)
+{
+const unsigned char *l_src = (const unsigned char *) a_src;
+char	*l_dst = (char *) a_dst;
+int	l_url = a_ctx->flags & UTIL$M_B64_URL;
+size_t	l_len;
+UTIL_B64ENC_FN	l_fn;
+
+	if ( a_ctx->carrynr )
+		{
+		for ( ; a_srclen && (a_ctx->carrynr < 3); a_srclen--)
+			a_ctx->carry[a_ctx->carrynr++] = *(l_src++);
+
+		if ( a_ctx->carrynr < 3 )
+			return	0;
+
+		l_dst += s_b64enc_scalar(a_ctx->carry, 3, l_dst, l_url);
+		a_ctx->carrynr = 0;
+		}
+
+	if ( unlikely(!(l_fn = __atomic_load_n(&s_b64enc_impl, __ATOMIC_RELAXED))) )
+		s_b64_select(), l_fn = s_b64enc_impl;
+
+	l_len = a_srclen - a_srclen % 3;
+	l_dst += l_fn(l_src, l_len, l_dst, l_url);
+
+	memcpy(a_ctx->carry, l_src + l_len, a_ctx->carrynr = (unsigned) (a_srclen - l_len));
+
+	return	l_dst - (char *) a_dst;
+}
+
+/*
+ *   DESCRIPTION: Encode a rest of data is kept in the context, put the padding (if it's not disabled),
+ *	the output is null-terminated, so the buffer must have room for 5 characters.
+ *
+ *   RETURNS:
+ *	A number of characters have been put into the output buffer (without NIL)
+ */
+size_t	__util$b64enc_final	(
+		UTIL_B64CTX	*a_ctx,
+		void	*a_dst
+			)
+{
+const char *l_chr = s_b64chr[a_ctx->flags & UTIL$M_B64_URL];
+unsigned char	*l_src = a_ctx->carry;
+char	*l_dst = (char *) a_dst;
+size_t	l_len = 0;
+
+	if ( a_ctx->carrynr )
+		{
+		if ( a_ctx->carrynr == 1 )
+			l_src[1] = 0;
+
+		l_dst[0] = l_chr[l_src[0] >> 2];
+		l_dst[1] = l_chr[((l_src[0] & 0x03) << 4) | (l_src[1] >> 4)];
+		l_dst[2] = (a_ctx->carrynr == 2) ? l_chr[(l_src[1] & 0x0F) << 2] : '=';
+		l_dst[3] = '=';
+
+		l_len = (a_ctx->flags & UTIL$M_B64_NOPAD) ? a_ctx->carrynr + 1 : 4;
+		a_ctx->carrynr = 0;
+		}
+
+	l_dst[l_len] = '\0';
+
+	return	l_len;
+}
+
+/*
+ *   DESCRIPTION: Decode a next chunk of data, an incomplete group of characters is kept in the context
+ *	up to the next call. The output buffer must have room for $B64DECLEN(srclen + 3) octets.
+ *
+ *   OUTPUTS:
+ *	dst:	Decoded octets
+ *	dstlen:	A number of octets have been put into the output buffer
+ *
+ *   RETURNS:
+ *	STS$K_SUCCESS
+ *	STS$K_ERROR	- invalid character or data after the padding, an offset of the character
+ *			in the whole input is in the ctx->errpos
+ */
+int	__util$b64dec_update	(
+		UTIL_B64CTX	*a_ctx,
+	const void	*a_src,
+		size_t	a_srclen,
+		void	*a_dst,
+		size_t	*a_dstlen
+			)
+{
+const unsigned char *l_src = (const unsigned char *) a_src;
+unsigned char	*l_dst = (unsigned char *) a_dst;
+size_t	l_len, l_done;
+int	l_status = STS$K_SUCCESS, l_badpos = 0;
+UTIL_B64DEC_FN	l_fn;
+
+	*a_dstlen = 0;
+
+	if ( a_ctx->done && a_srclen )				/* Nothing is allowed after the padding		*/
+		{
+		a_ctx->errpos = a_ctx->pos + a_ctx->carrynr;
+		return	STS$K_ERROR;
+		}
+
+	if ( a_ctx->carrynr )
+		{
+		for ( ; a_srclen && (a_ctx->carrynr < 4); a_srclen-- )
+			a_ctx->carry[a_ctx->carrynr++] = *(l_src++);
+
+		if ( a_ctx->carrynr < 4 )
+			return	STS$K_SUCCESS;
+
+		if ( !(1 & (l_status = s_b64dec_group(a_ctx->carry, l_dst, &l_len, &l_badpos, a_ctx->flags))) )
+			{
+			a_ctx->errpos = a_ctx->pos + l_badpos;
+			return	STS$K_ERROR;
+			}
+
+		l_dst += l_len;
+		a_ctx->pos += 4;
+		a_ctx->carrynr = 0;
+		}
+
+	if ( unlikely(!(l_fn = __atomic_load_n(&s_b64dec_impl, __ATOMIC_RELAXED))) )
+		s_b64_select(), l_fn = s_b64dec_impl;
+
+	/* Bulk decoding stops at the group with a padding or with an invalid character */
+	while ( (l_status == STS$K_SUCCESS) && (a_srclen >= 4) )
+		{
+		l_done = l_fn(l_src, a_srclen & ~((size_t) 3), l_dst, a_ctx->flags & UTIL$M_B64_URL);
+		l_src += l_done;
+		l_dst += l_done / 4 * 3;
+		a_ctx->pos += l_done;
+
+		if ( (a_srclen -= l_done) < 4 )
+			break;
+
+		if ( !(1 & (l_status = s_b64dec_group(l_src, l_dst, &l_len, &l_badpos, a_ctx->flags))) )
+			{
+			a_ctx->errpos = a_ctx->pos + l_badpos;
+			*a_dstlen = l_dst - (unsigned char *) a_dst;
+			return	STS$K_ERROR;
+			}
+
+		l_src += 4;
+		l_dst += l_len;
+		a_ctx->pos += 4;
+		a_srclen -= 4;
+		}
+
+	*a_dstlen = l_dst - (unsigned char *) a_dst;
+
+	if ( l_status == STS$K_INFO )
+		{
+		a_ctx->done = 1;
+
+		if ( a_srclen )
+			{
+			a_ctx->errpos = a_ctx->pos;
+			return	STS$K_ERROR;
+			}
+		}
+
+	memcpy(a_ctx->carry, l_src, a_ctx->carrynr = (unsigned) a_srclen);
+
+	return	STS$K_SUCCESS;
+}
+
+/*
+ *   DESCRIPTION: Complete decoding, an incomplete group of characters is accepted only with UTIL$M_B64_NOPAD.
+ *	The output buffer must have room for 2 octets.
+ *
+ *   RETURNS:
+ *	STS$K_SUCCESS
+ *	STS$K_ERROR	- truncated input, an offset of the group is in the ctx->errpos
+ */
+int	__util$b64dec_final	(
+		UTIL_B64CTX	*a_ctx,
+		void	*a_dst,
+		size_t	*a_dstlen
+			)
+{
+unsigned char	l_grp[4], l_tmp[3];
+int	l_badpos = 0;
+
+	*a_dstlen = 0;
+
+	if ( !a_ctx->carrynr )
+		return	STS$K_SUCCESS;
+
+	a_ctx->errpos = a_ctx->pos + a_ctx->carrynr;
+
+	if ( !(a_ctx->flags & UTIL$M_B64_NOPAD) || (a_ctx->carrynr == 1) )
+		return	STS$K_ERROR;
+
+	/* Complete the group by a valid character, check that unused bits are zero */
+	memcpy(l_grp, a_ctx->carry, a_ctx->carrynr);
+	memset(l_grp + a_ctx->carrynr, 'A', 4 - a_ctx->carrynr);
+
+	if ( !(1 & s_b64dec_group(l_grp, l_tmp, a_dstlen, &l_badpos, a_ctx->flags)) )
+		{
+		a_ctx->errpos = a_ctx->pos + l_badpos;
+		*a_dstlen = 0;
+		return	STS$K_ERROR;
+		}
+
+	if ( l_tmp[a_ctx->carrynr - 1] )
+		{
+		a_ctx->errpos = a_ctx->pos + a_ctx->carrynr - 1;
+		*a_dstlen = 0;
+		return	STS$K_ERROR;
+		}
+
+	memcpy(a_dst, l_tmp, *a_dstlen = a_ctx->carrynr - 1);
+	a_ctx->carrynr = 0;
+
+	return	STS$K_SUCCESS;
+}
+
+/*
+ *   DESCRIPTION: Encode a sequence of octets to the Base64 or Base64url string,
+ *	the output buffer must have room for $B64ENCLEN(srcbinlen) + 1 characters.
+ *
+ *   INPUTS:
+ *	srcbin:		An address of the source data
+ *	srcbinlen:	A length of the source data
+ *	flags:		UTIL$M_B64_URL, UTIL$M_B64_NOPAD
+ *
+ *   OUTPUTS:
+ *	dstb64:		A null-terminated string
+ *
+ *   RETURNS:
+ *	A length of the string
+ */
+size_t	__util$b64enc	(
+	const void	*a_srcbin,
+		void	*a_dstb64,
+		size_t	a_srcbinlen,
+		int	a_flags
+			)
+{
+UTIL_B64CTX	l_ctx;
+size_t	l_len;
+
+	__util$b64_init(&l_ctx, a_flags);
+	l_len = __util$b64enc_update(&l_ctx, a_srcbin, a_srcbinlen, a_dstb64);
+
+	return	l_len + __util$b64enc_final(&l_ctx, (char *) a_dstb64 + l_len);
+}
+
+/*
+ *   DESCRIPTION: Decode a Base64 or Base64url string with a strict check of the input,
+ *	the output buffer must have room for $B64DECLEN(srcb64len) octets.
+ *
+ *   INPUTS:
+ *	srcb64:		An address of the string
+ *	srcb64len:	A length of the string
+ *	flags:		UTIL$M_B64_URL, UTIL$M_B64_NOPAD
+ *
+ *   OUTPUTS:
+ *	dstbin:		Decoded octets
+ *	dstbinlen:	(optional) A number of octets have been stored
+ *	errpos:		(optional) An offset of the first invalid character in the string
+ *
+ *   RETURNS:
+ *	STS$K_SUCCESS
+ *	STS$K_ERROR	- invalid character, padding or length of the string
+ */
+int	__util$b64dec_ex	(
+	const void	*a_srcb64,
+		size_t	a_srcb64len,
+		void	*a_dstbin,
+		size_t	*a_dstbinlen,
+		size_t	*a_errpos,
+		int	a_flags
+			)
+{
+UTIL_B64CTX	l_ctx;
+size_t	l_len = 0, l_tail = 0;
+int	l_status;
+
+	__util$b64_init(&l_ctx, a_flags);
+
+	if ( 1 & (l_status = __util$b64dec_update(&l_ctx, a_srcb64, a_srcb64len, a_dstbin, &l_len)) )
+		l_status = __util$b64dec_final(&l_ctx, (char *) a_dstbin + l_len, &l_tail);
+
+	if ( a_dstbinlen )
+		*a_dstbinlen = l_len + l_tail;
+
+	if ( a_errpos && !(1 & l_status) )
+		*a_errpos = l_ctx.errpos;
+
+	return	l_status;
+}
+
+/*
+ *   DESCRIPTION: Decode a Base64 or Base64url string, see __util$b64dec_ex().
+ *
+ *   RETURNS:
+ *	A length of the data in the output buffer, 0 - invalid string
+ */
+size_t	__util$b64dec	(
+	const void	*a_srcb64,
+		void	*a_dstbin,
+		size_t	a_srcb64len,
+		int	a_flags
+			)
+{
+size_t	l_len;
+
+	return	(1 & __util$b64dec_ex(a_srcb64, a_srcb64len, a_dstbin, &l_len, NULL, a_flags)) ? l_len : 0;
+}
+
+
+/*
+ * Zero checking and zeroing of the memory blocks: a head is processed up to the aligned address,
+ * the aligned blocks are OR-reduced by the SSE2/AVX2 registers. The large blocks are zeroed
+ * by the non-temporal stores to don't evict the useful data from the CPU caches, the memset() is used
+ * for other blocks - it's not slower than the SIMD stores (ERMS "rep stosb" on the modern CPU).
+ */
+#define	UTIL$K_BZERO_NTSZ	(4 * 1024 * 1024)	/* A default size of the block to be zeroed bypassing caches	*/
+
+static size_t	s_bzero_ntsz = UTIL$K_BZERO_NTSZ;	/* Is set by the half of the last level cache at first call	*/
+
+static int	s_iszero_scalar	(
+	const unsigned char *a_buf,
+		size_t	a_bufsz
+			)
+{
+const unsigned long long *l_qw;
+
+	/* Step by octets up to the address is aligned on 8 octets boundary */
+	for ( ; a_bufsz && ((size_t) a_buf & 7); a_bufsz--, a_buf++ )
+		if ( *a_buf )
+			return	STS$K_WARN;
+
+	for ( l_qw = (const unsigned long long *) a_buf; a_bufsz >= 32; a_bufsz -= 32, l_qw += 4 )
+		if ( l_qw[0] | l_qw[1] | l_qw[2] | l_qw[3] )
+			return	STS$K_WARN;
+
+	for ( a_buf = (const unsigned char *) l_qw; a_bufsz; a_bufsz--, a_buf++ )
+		if ( *a_buf )
+			return	STS$K_WARN;
+
+	return	STS$K_SUCCESS;
+}
+
+static void	s_bzero_scalar	(
+	unsigned char	*a_buf,
+		size_t	a_bufsz
+			)
+{
+	memset(a_buf, 0, a_bufsz);
+}
+
+#ifdef	__SSE2__
+static int	s_iszero_sse2	(
+	const unsigned char *a_buf,
+		size_t	a_bufsz
+			)
+{
+const __m128i	*l_p;
+__m128i	l_acc;
+size_t	l_head;
+
+	l_head = (16 - ((size_t) a_buf & 15)) & 15;
+	l_head = (l_head < a_bufsz) ? l_head : a_bufsz;
+
+	if ( !(1 & s_iszero_scalar(a_buf, l_head)) )
+		return	STS$K_WARN;
+
+	for ( l_p = (const __m128i *) (a_buf + l_head), a_bufsz -= l_head; a_bufsz >= 64; a_bufsz -= 64, l_p += 4 )
+		{
+		l_acc = _mm_or_si128(_mm_or_si128(_mm_load_si128(l_p), _mm_load_si128(l_p + 1)),
+				_mm_or_si128(_mm_load_si128(l_p + 2), _mm_load_si128(l_p + 3)));
+
+		if ( _mm_movemask_epi8(_mm_cmpeq_epi8(l_acc, _mm_setzero_si128())) != 0xFFFF )
+			return	STS$K_WARN;
+		}
+
+	return	s_iszero_scalar((const unsigned char *) l_p, a_bufsz);
+}
+
+/* Zero a block is larger than 64 octets by the non-temporal stores */
+static void	s_bzero_sse2	(
+	unsigned char	*a_buf,
+		size_t	a_bufsz
+			)
+{
+const __m128i	l_zero = _mm_setzero_si128();
+unsigned char	*l_end = a_buf + a_bufsz;
+__m128i	*l_p;
+
+	/* Unaligned head and tail are overlapped with aligned stores */
+	_mm_storeu_si128((__m128i *) a_buf, l_zero);
+	_mm_storeu_si128((__m128i *) (l_end - 16), l_zero);
+
+	l_p = (__m128i *) (((size_t) a_buf + 16) & ~(size_t) 15);
+
+	for ( a_bufsz = (l_end - (unsigned char *) l_p) & ~(size_t) 63; a_bufsz; a_bufsz -= 64, l_p += 4 )
+		{
+		_mm_stream_si128(l_p, l_zero);
+		_mm_stream_si128(l_p + 1, l_zero);
+		_mm_stream_si128(l_p + 2, l_zero);
+		_mm_stream_si128(l_p + 3, l_zero);
+		}
+
+	for ( ; (unsigned char *) (l_p + 1) <= l_end; l_p++ )
+		_mm_stream_si128(l_p, l_zero);
+
+	_mm_sfence();
+}
+#endif	/* __SSE2__ */
+
+#if	defined(__GNUC__) && defined(__x86_64__)
+__attribute__((target("avx2")))
+static int	s_iszero_avx2	(
+	const unsigned char *a_buf,
+		size_t	a_bufsz
+			)
+{
+const __m256i	*l_p;
+__m256i	l_acc;
+size_t	l_head;
+
+	l_head = (32 - ((size_t) a_buf & 31)) & 31;
+	l_head = (l_head < a_bufsz) ? l_head : a_bufsz;
+
+	if ( !(1 & s_iszero_scalar(a_buf, l_head)) )
+		return	STS$K_WARN;
+
+	for ( l_p = (const __m256i *) (a_buf + l_head), a_bufsz -= l_head; a_bufsz >= 128; a_bufsz -= 128, l_p += 4 )
+		{
+		l_acc = _mm256_or_si256(_mm256_or_si256(_mm256_load_si256(l_p), _mm256_load_si256(l_p + 1)),
+				_mm256_or_si256(_mm256_load_si256(l_p + 2), _mm256_load_si256(l_p + 3)));
+
+		if ( !_mm256_testz_si256(l_acc, l_acc) )
+			return	STS$K_WARN;
+		}
+
+	return	s_iszero_sse2((const unsigned char *) l_p, a_bufsz);
+}
+
+__attribute__((target("avx2")))
+static void	s_bzero_avx2	(
+	unsigned char	*a_buf,
+		size_t	a_bufsz
+			)
+{
+const __m256i	l_zero = _mm256_setzero_si256();
+unsigned char	*l_end = a_buf + a_bufsz;
+__m256i	*l_p;
+
+	_mm256_storeu_si256((__m256i *) a_buf, l_zero);
+	_mm256_storeu_si256((__m256i *) (l_end - 32), l_zero);
+
+	l_p = (__m256i *) (((size_t) a_buf + 32) & ~(size_t) 31);
+
+	for ( a_bufsz = (l_end - (unsigned char *) l_p) & ~(size_t) 127; a_bufsz; a_bufsz -= 128, l_p += 4 )
+		{
+		_mm256_stream_si256(l_p, l_zero);
+		_mm256_stream_si256(l_p + 1, l_zero);
+		_mm256_stream_si256(l_p + 2, l_zero);
+		_mm256_stream_si256(l_p + 3, l_zero);
+		}
+
+	for ( ; (unsigned char *) (l_p + 1) <= l_end; l_p++ )
+		_mm256_stream_si256(l_p, l_zero);
+
+	_mm_sfence();
+}
+#endif	/* __GNUC__ && __x86_64__ */
+
+typedef int (* UTIL_ISZERO_FN) (const unsigned char *buf, size_t bufsz);
+typedef void (* UTIL_BZERO_FN) (unsigned char *buf, size_t bufsz);
+
+static UTIL_ISZERO_FN	s_iszero_impl;				/* Are set by the s_zero_select() at first call */
+static UTIL_BZERO_FN	s_bzero_impl;
+
+static void	s_zero_select	(void)
+{
+UTIL_ISZERO_FN	l_chk = s_iszero_scalar;
+UTIL_BZERO_FN	l_clr = s_bzero_scalar;
+
+#if	defined(_SC_LEVEL3_CACHE_SIZE)
+long	l_llc;
+
+	if ( (64 * 1024) < (l_llc = sysconf(_SC_LEVEL3_CACHE_SIZE)) )
+		s_bzero_ntsz = (size_t) l_llc / 2;
+#endif
+
+#if	defined(__GNUC__) && defined(__x86_64__)
+	__builtin_cpu_init();
+
+	if ( __builtin_cpu_supports("avx2") )
+		l_chk = s_iszero_avx2, l_clr = s_bzero_avx2;
+	else	l_chk = s_iszero_sse2, l_clr = s_bzero_sse2;
+#elif	defined(__SSE2__)
+	l_chk = s_iszero_sse2, l_clr = s_bzero_sse2;
+#endif
+
+	__atomic_store_n(&s_bzero_impl, l_clr, __ATOMIC_RELAXED);
+	__atomic_store_n(&s_iszero_impl, l_chk, __ATOMIC_RELAXED);
+}
+
+/*
+ *   DESCRIPTION: Check buffer for consecutive zero octets.
+ *
+ *   INPUTS:
+ *	bufp:	An address of the buffer to check
+ *	bufsz:	A length of data in the buffer
+ *
+ *   RETURNS:
+ *	STS$K_SUCCESS	- the buffer is zero filled
+ *	STS$K_WARN	- the buffer is not zero filled
+ */
+int	__util$iszero	(
+	const void	*a_bufp,
+		size_t	a_bufsz
+			)
+{
+UTIL_ISZERO_FN	l_fn;
+
+	if ( unlikely(!(l_fn = __atomic_load_n(&s_iszero_impl, __ATOMIC_RELAXED))) )
+		s_zero_select(), l_fn = s_iszero_impl;
+
+	return	l_fn((const unsigned char *) a_bufp, a_bufsz);
+}
+
+/*
+ *   DESCRIPTION: Zeroing memory block, a block is larger than the last level cache
+ *	is zeroed by the non-temporal stores.
+ *
+ *   INPUTS:
+ *	bufp:	An address of the memory block
+ *	bufsz:	A length of the memory block
+ *
+ *   RETURNS:
+ *	STS$K_SUCCESS
+ */
+int	__util$bzero	(
+		void	*a_bufp,
+		size_t	a_bufsz
+			)
+{
+UTIL_BZERO_FN	l_fn;
+
+	if ( unlikely(!(l_fn = __atomic_load_n(&s_bzero_impl, __ATOMIC_RELAXED))) )
+		s_zero_select(), l_fn = s_bzero_impl;
+
+	if ( a_bufsz < s_bzero_ntsz )
+		memset(a_bufp, 0, a_bufsz);
+	else	l_fn((unsigned char *) a_bufp, a_bufsz);
+
+	return	STS$K_SUCCESS;
+}
+
+
+/*
+ * XOR-ing data with a repeating key: a short key is expanded into the buffer to get long runs,
+ * a run of the data is XOR-ed with a part of the key by the SSE2/AVX2 version is selected at first call.
+ */
+#define	UTIL$K_STRXOR_SUPERSZ	1024			/* A minimal length of the expanded key			*/
+#define	UTIL$K_STRXOR_MTCHUNK	(1024 * 1024)		/* A minimal size of data to be XOR-ed by the one thread	*/
+
+static void	s_xor_scalar	(
+	unsigned char	*a_dst,
+	const unsigned char *a_src,
+	const unsigned char *a_key,
+		size_t	a_len
+			)
+{
+unsigned long long	l_qw, l_kqw;
+
+	for ( ; a_len >= 8; a_len -= 8, a_dst += 8, a_src += 8, a_key += 8 )
+		{
+		memcpy(&l_qw, a_src, 8);
+		memcpy(&l_kqw, a_key, 8);
+		l_qw ^= l_kqw;
+		memcpy(a_dst, &l_qw, 8);
+		}
+
+	for ( ; a_len; a_len--, a_dst++, a_src++, a_key++ )
+		*a_dst = *a_src ^ *a_key;
+}
+
+#ifdef	__SSE2__
+static void	s_xor_sse2	(
+	unsigned char	*a_dst,
+	const unsigned char *a_src,
+	const unsigned char *a_key,
+		size_t	a_len
+			)
+{
+__m128i	l_v1, l_v2;
+
+	for ( ; a_len >= 32; a_len -= 32, a_dst += 32, a_src += 32, a_key += 32 )
+		{
+		l_v1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) a_src), _mm_loadu_si128((const __m128i *) a_key));
+		l_v2 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (a_src + 16)), _mm_loadu_si128((const __m128i *) (a_key + 16)));
+
+		_mm_storeu_si128((__m128i *) a_dst, l_v1);
+		_mm_storeu_si128((__m128i *) (a_dst + 16), l_v2);
+		}
+
+	s_xor_scalar(a_dst, a_src, a_key, a_len);
+}
+#endif	/* __SSE2__ */
+
+#if	defined(__GNUC__) && defined(__x86_64__)
+__attribute__((target("avx2")))
+static void	s_xor_avx2	(
+	unsigned char	*a_dst,
+	const unsigned char *a_src,
+	const unsigned char *a_key,
+		size_t	a_len
+			)
+{
+__m256i	l_v1, l_v2;
+
+	for ( ; a_len >= 64; a_len -= 64, a_dst += 64, a_src += 64, a_key += 64 )
+		{
+		l_v1 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) a_src), _mm256_loadu_si256((const __m256i *) a_key));
+		l_v2 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (a_src + 32)), _mm256_loadu_si256((const __m256i *) (a_key + 32)));
+
+		_mm256_storeu_si256((__m256i *) a_dst, l_v1);
+		_mm256_storeu_si256((__m256i *) (a_dst + 32), l_v2);
+		}
+
+	s_xor_sse2(a_dst, a_src, a_key, a_len);
+}
+#endif	/* __GNUC__ && __x86_64__ */
+
+typedef void (* UTIL_XOR_FN) (unsigned char *dst, const unsigned char *src, const unsigned char *key, size_t len);
+
+static UTIL_XOR_FN	s_xor_impl;				/* Is set by the s_xor_select() at first call */
+
+static UTIL_XOR_FN	s_xor_select	(void)
+{
+UTIL_XOR_FN	l_fn = s_xor_scalar;
+
+#if	defined(__GNUC__) && defined(__x86_64__)
+	__builtin_cpu_init();
+
+	l_fn = __builtin_cpu_supports("avx2") ? s_xor_avx2 : s_xor_sse2;
+#elif	defined(__SSE2__)
+	l_fn = s_xor_sse2;
+#endif
+
+	__atomic_store_n(&s_xor_impl, l_fn, __ATOMIC_RELAXED);
+
+	return	l_fn;
+}
+
+/* XOR the data with the key is started from the given position */
+static void	s_strxor	(
+	const unsigned char *a_key,
+		size_t	a_keysz,
+		size_t	a_pos,
+	const unsigned char *a_src,
+	unsigned char	*a_dst,
+		size_t	a_len
+			)
+{
+unsigned char	l_super[UTIL$K_STRXOR_SUPERSZ * 2];
+size_t	l_run, l_supersz;
+UTIL_XOR_FN	l_fn;
+
+	if ( unlikely(!(l_fn = __atomic_load_n(&s_xor_impl, __ATOMIC_RELAXED))) )
+		l_fn = s_xor_select();
+
+	/* Repeat a short key to XOR the data by the long runs */
+	if ( (a_keysz < UTIL$K_STRXOR_SUPERSZ) && (a_len > (a_keysz - a_pos)) )
+		{
+		for ( l_supersz = 0; l_supersz < UTIL$K_STRXOR_SUPERSZ; l_supersz += a_keysz )
+			memcpy(l_super + l_supersz, a_key, a_keysz);
+
+		a_key = l_super;
+		a_keysz = l_supersz;
+		}
+
+	for ( ; a_len; a_len -= l_run, a_src += l_run, a_dst += l_run, a_pos = 0 )
+		{
+		l_run = a_keysz - a_pos;
+		l_run = (l_run < a_len) ? l_run : a_len;
+
+		l_fn(a_dst, a_src, a_key + a_pos, l_run);
+		}
+}
+
+/* Check the context, compute a position in the key and a length of data to be XOR-ed */
+static int	s_strxor_prep	(
+		int	a_keysz,
+		int	a_srcsz,
+		int	a_dstsz,
+		int	*a_ctx,
+		size_t	*a_pos,
+		size_t	*a_len
+			)
+{
+int	l_sz = (a_srcsz > a_dstsz) ? a_dstsz : a_srcsz;
+
+	if ( a_ctx && (*a_ctx > 0) && (*a_ctx > a_keysz) )	/* Check that <ctx> is in key's area */
+		return	STS$K_ERROR;
+
+	*a_len = (l_sz > 0) ? (size_t) l_sz : 0;
+	*a_pos = (a_ctx && (*a_ctx > 0)) ? (size_t) *a_ctx : 0;
+
+	if ( *a_len && (a_keysz <= 0) )
+		return	STS$K_ERROR;
+
+	if ( a_ctx )						/* Store a key's position after last XOR-ed octet */
+		*a_ctx = *a_len ? (int) ((*a_pos + *a_len - 1) % a_keysz) + 1 : (int) *a_pos;
+
+	*a_pos = (*a_pos == (size_t) a_keysz) ? 0 : *a_pos;	/* Key's position has not been wrapped around yet */
+
+	return	STS$K_SUCCESS;
+}
+
+/*
+ *   DESCRIPTION: XOR-ing octet source string with a given key, result is in destination buffer,
+ *	the source and the destination can be the same buffer.
+ *
+ *   INPUTS:
+ *	key:	A buffer with the key
+ *	keysz:	A length of the key
+ *	src:	A buffer with the data to be XOR-ed
+ *	srcsz:	A length of the source data
+ *	dstsz:	A size of the output buffer
+ *	ctx:	A position in the key to keep context between consecutive calls,
+ *		should be set to -1 at first call, can be NULL if it is not used
+ *
+ *   OUTPUTS:
+ *	dst:	XOR-ed data
+ *	ctx:	A position in the key for next call
+ *
+ *   RETURNS:
+ *	condition code
+ */
+int	__util$strxor	(
+		void	*a_key,
+		int	a_keysz,
+		void	*a_src,
+		int	a_srcsz,
+		void	*a_dst,
+		int	a_dstsz,
+		int	*a_ctx
+			)
+{
+size_t	l_pos, l_len;
+int	l_sts;
+
+	if ( !(1 & (l_sts = s_strxor_prep(a_keysz, a_srcsz, a_dstsz, a_ctx, &l_pos, &l_len))) )
+		return	l_sts;
+
+	if ( l_len )
+		s_strxor(a_key, a_keysz, l_pos, a_src, a_dst, l_len);
+
+	return	STS$K_SUCCESS;
+}
+
+#ifndef	WIN32
+typedef	struct __util_strxor_job__ {
+	const unsigned char *key,
+			*src;
+	unsigned char	*dst;
+	size_t		keysz,
+			pos,
+			len;
+} UTIL_STRXOR_JOB;
+
+static void	*s_strxor_worker	(
+		void	*a_job
+			)
+{
+UTIL_STRXOR_JOB *l_job = (UTIL_STRXOR_JOB *) a_job;
+
+	s_strxor(l_job->key, l_job->keysz, l_job->pos, l_job->src, l_job->dst, l_job->len);
+
+	return	NULL;
+}
+#endif
+
+/*
+ *   DESCRIPTION: XOR-ing a large buffer by the several threads, see __util$strxor().
+ *	A number of the threads is reduced to get at least UTIL$K_STRXOR_MTCHUNK octets per thread.
+ *
+ *   INPUTS:
+ *	...
+ *	thrnr:	A number of the threads, the current thread is one of them, <= 1 - the single thread,
+ *		no more than UTIL$K_STRXOR_MAXTHR
+ *
+ *   RETURNS:
+ *	condition code
+ */
+int	__util$strxor_mt	(
+		void	*a_key,
+		int	a_keysz,
+		void	*a_src,
+		int	a_srcsz,
+		void	*a_dst,
+		int	a_dstsz,
+		int	*a_ctx,
+		int	a_thrnr
+			)
+{
+#ifndef	WIN32
+UTIL_STRXOR_JOB	l_jobs[UTIL$K_STRXOR_MAXTHR];
+pthread_t	l_tids[UTIL$K_STRXOR_MAXTHR];
+size_t	l_pos, l_len, l_chunk, l_off;
+int	l_sts, i, l_thrnr;
+
+	if ( !(1 & (l_sts = s_strxor_prep(a_keysz, a_srcsz, a_dstsz, a_ctx, &l_pos, &l_len))) )
+		return	l_sts;
+
+	/* Clamp to [1, UTIL$K_STRXOR_MAXTHR] at first, a zero or negative number - the single thread */
+	a_thrnr = (a_thrnr < 1) ? 1 : (a_thrnr < UTIL$K_STRXOR_MAXTHR) ? a_thrnr : UTIL$K_STRXOR_MAXTHR;
+	a_thrnr = ((size_t) a_thrnr < (l_len / UTIL$K_STRXOR_MTCHUNK)) ? a_thrnr : (int) (l_len / UTIL$K_STRXOR_MTCHUNK);
+
+	if ( a_thrnr < 2 )
+		{
+		if ( l_len )
+			s_strxor(a_key, a_keysz, l_pos, a_src, a_dst, l_len);
+
+		return	STS$K_SUCCESS;
+		}
+
+	/* Split data to the chunks are aligned on 64 octets, the last chunk is processed by the current thread */
+	l_chunk = (l_len / a_thrnr) & ~(size_t) 63;
+
+	for ( i = 0, l_off = 0; i < a_thrnr; i++, l_off += l_chunk )
+		{
+		l_jobs[i].key = a_key;
+		l_jobs[i].keysz = a_keysz;
+		l_jobs[i].pos = (l_pos + l_off) % a_keysz;
+		l_jobs[i].src = (unsigned char *) a_src + l_off;
+		l_jobs[i].dst = (unsigned char *) a_dst + l_off;
+		l_jobs[i].len = (i == (a_thrnr - 1)) ? l_len - l_off : l_chunk;
+		}
+
+	for ( l_thrnr = 0; l_thrnr < (a_thrnr - 1); l_thrnr++ )
+		if ( pthread_create(&l_tids[l_thrnr], NULL, s_strxor_worker, &l_jobs[l_thrnr]) )
+			break;
+
+	/* Chunks of the threads are not started are processed by the current thread */
+	for ( i = l_thrnr; i < a_thrnr; i++ )
+		s_strxor_worker(&l_jobs[i]);
+
+	for ( i = 0; i < l_thrnr; i++ )
+		pthread_join(l_tids[i], NULL);
+
+	return	STS$K_SUCCESS;
+#else
+	return	__util$strxor(a_key, a_keysz, a_src, a_srcsz, a_dst, a_dstsz, a_ctx);
+#endif
+}
+
+
+/*
+ * Multi-pattern search: Aho-Corasick automaton is compiled into the DFA, the input characters
+ * are mapped into the classes (all characters are not used by the patterns are in the class 0),
+ * so a row of the transition table has only <a number of classes> entries.
+ * An entry of the table is an offset of the next state's row, UTIL$M_MPM_OUT bit is set
+ * if the next state has output - one or more patterns is ended at this state.
+ */
+#define	UTIL$M_MPM_OUT	0x80000000U
+#define	UTIL$K_MPM_SPLITSZ	1024			/* Scan two halves of the buffer at once, if it's not less	*/
+#define	UTIL$K_MPM_DEFERNR	128			/* A number of the deferred match positions of the second half	*/
+
+typedef	struct __util_mpm_out__ {
+	int	id,				/* A pattern id - index in the patterns array */
+		next;				/* Next output of the state, -1 - end of list */
+} UTIL_MPM_OUT;
+
+struct	__util_mpm__ {
+	unsigned short	cls[256];		/* Character -> class map */
+	unsigned	clsnr,			/* A number of classes, a length of the row */
+			statenr;		/* A number of the DFA's states */
+	unsigned	*delta;			/* Transition table: statenr * clsnr */
+	int		*out;			/* The first output of the state, -1 - no output */
+	UTIL_MPM_OUT	*outs;			/* Outputs list */
+	unsigned short	*patlen;		/* Lengths of the patterns */
+	int		patnr,
+			maxlen;			/* A maximum length of the patterns */
+};
+
+/*
+ *   DESCRIPTION: Compile a set of patterns into the multi-pattern matcher.
+ *
+ *   INPUTS:
+ *	pats:	An array of the patterns, addresses of the strings
+ *	lens:	An array of the lengths of the patterns
+ *	patnr:	A number of patterns, the pattern's index is used as pattern id
+ *	flags:	UTIL$M_MPM_NOCASE - case insensitive matching
+ *
+ *   RETURNS:
+ *	An address of the matcher, must be released by __util$mpm_free(), NULL - insufficient memory
+ */
+static UTIL_MPM	*s_mpm_compile	(
+	const char	**a_pats,
+	const unsigned short *a_lens,
+		int	a_patnr,
+		int	a_flags
+			)
+{
+UTIL_MPM	*l_mpm;
+unsigned	*l_goto = NULL, *l_fail = NULL, *l_queue = NULL, *l_delta, l_maxstates = 1, l_state, l_next, l_cls, l_head, l_tail;
+int	i, j, l_outnr = 0;
+unsigned char	l_ch;
+
+	if ( !(l_mpm = calloc(1, sizeof(UTIL_MPM))) )
+		return	NULL;
+
+	l_mpm->patnr = a_patnr;
+
+	/* Map characters of the patterns to the classes, class 0 is "any other character" */
+	for ( l_mpm->clsnr = 1, i = 0; i < a_patnr; i++ )
+		{
+		for ( j = 0; j < a_lens[i]; j++ )
+			{
+			l_ch = (unsigned char) a_pats[i][j];
+
+			if ( a_flags & UTIL$M_MPM_NOCASE )
+				l_ch = (unsigned char) tolower(l_ch);
+
+			if ( !l_mpm->cls[l_ch] )
+				{
+				l_mpm->cls[l_ch] = (unsigned short) l_mpm->clsnr++;
+
+				if ( a_flags & UTIL$M_MPM_NOCASE )
+					l_mpm->cls[toupper(l_ch)] = l_mpm->cls[l_ch];
+				}
+			}
+
+		l_maxstates += a_lens[i];
+		}
+
+	if ( !(l_goto = malloc(l_maxstates * l_mpm->clsnr * sizeof(unsigned)))
+		|| !(l_fail = calloc(l_maxstates, sizeof(unsigned)))
+		|| !(l_queue = malloc(l_maxstates * sizeof(unsigned)))
+		|| !(l_mpm->out = malloc(l_maxstates * sizeof(int)))
+		|| !(l_mpm->outs = malloc((a_patnr + 1) * sizeof(UTIL_MPM_OUT)))
+		|| !(l_mpm->patlen = malloc((a_patnr + 1) * sizeof(unsigned short))) )
+		{
+		free(l_goto);
+		free(l_fail);
+		free(l_queue);
+		__util$mpm_free(l_mpm);
+
+		return	NULL;
+		}
+
+	memset(l_goto, 0xff, l_maxstates * l_mpm->clsnr * sizeof(unsigned));	/* (unsigned) -1 - no transition */
+	memset(l_mpm->out, 0xff, l_maxstates * sizeof(int));
+
+	/* Build the trie */
+	for ( l_mpm->statenr = 1, i = 0; i < a_patnr; i++ )
+		{
+		l_mpm->patlen[i] = a_lens[i];
+		l_mpm->maxlen = (a_lens[i] > l_mpm->maxlen) ? a_lens[i] : l_mpm->maxlen;
+
+		if ( !a_lens[i] )
+			continue;						/* Empty pattern never matches */
+
+		for ( l_state = 0, j = 0; j < a_lens[i]; j++ )
+			{
+			l_cls = l_mpm->cls[(unsigned char) a_pats[i][j]];
+
+			if ( (l_next = l_goto[l_state * l_mpm->clsnr + l_cls]) == (unsigned) -1 )
+				l_next = l_goto[l_state * l_mpm->clsnr + l_cls] = l_mpm->statenr++;
+
+			l_state = l_next;
+			}
+
+		/* Add the pattern at head of the output list of the state */
+		l_mpm->outs[l_outnr].id = i;
+		l_mpm->outs[l_outnr].next = l_mpm->out[l_state];
+		l_mpm->out[l_state] = l_outnr++;
+		}
+
+	/*
+	 * Breadth-first pass: compute the failure links, complete the transitions of every state
+	 * by the transitions of its failure state, append output list of the failure state.
+	 */
+	for ( l_head = l_tail = 0, l_cls = 0; l_cls < l_mpm->clsnr; l_cls++ )
+		{
+		if ( (l_next = l_goto[l_cls]) == (unsigned) -1 )
+			l_goto[l_cls] = 0;
+		else	{
+			l_fail[l_next] = 0;
+			l_queue[l_tail++] = l_next;
+			}
+		}
+
+	while ( l_head < l_tail )
+		{
+		l_state = l_queue[l_head++];
+
+		/* Append outputs of the failure state, it has been completed because it's less deep */
+		if ( l_mpm->out[l_state] < 0 )
+			l_mpm->out[l_state] = l_mpm->out[l_fail[l_state]];
+		else	{
+			for ( i = l_mpm->out[l_state]; l_mpm->outs[i].next >= 0; i = l_mpm->outs[i].next);
+
+			l_mpm->outs[i].next = l_mpm->out[l_fail[l_state]];
+			}
+
+		for ( l_cls = 0; l_cls < l_mpm->clsnr; l_cls++ )
+			{
+			if ( (l_next = l_goto[l_state * l_mpm->clsnr + l_cls]) == (unsigned) -1 )
+				l_goto[l_state * l_mpm->clsnr + l_cls] = l_goto[l_fail[l_state] * l_mpm->clsnr + l_cls];
+			else	{
+				l_fail[l_next] = l_goto[l_fail[l_state] * l_mpm->clsnr + l_cls];
+				l_queue[l_tail++] = l_next;
+				}
+			}
+		}
+
+	/* Convert the state numbers into the row offsets with the output flag */
+	for ( i = 0; i < (int) (l_mpm->statenr * l_mpm->clsnr); i++ )
+		{
+		l_next = l_goto[i];
+		l_goto[i] = (l_next * l_mpm->clsnr) | ((l_mpm->out[l_next] >= 0) ? UTIL$M_MPM_OUT : 0);
+		}
+
+	/* Release unused space */
+	if ( (l_delta = realloc(l_goto, l_mpm->statenr * l_mpm->clsnr * sizeof(unsigned))) )
+		l_goto = l_delta;
+
+	l_mpm->delta = l_goto;
+
+	free(l_fail);
+	free(l_queue);
+
+	return	l_mpm;
+}
+
+UTIL_MPM	*__util$mpm_compile	(
+	const ASC	*a_pats,
+		int	a_patnr,
+		int	a_flags
+			)
+{
+UTIL_MPM	*l_mpm;
+const char	**l_pats;
+unsigned short	*l_lens;
+int	i;
+
+	if ( !(l_pats = malloc(a_patnr * (sizeof(char *) + sizeof(unsigned short)) + 1)) )
+		return	NULL;
+
+	l_lens = (unsigned short *) (l_pats + a_patnr);
+
+	for ( i = 0; i < a_patnr; i++ )
+		{
+		l_pats[i] = a_pats[i].sts;
+		l_lens[i] = a_pats[i].len;
+		}
+
+	l_mpm = s_mpm_compile(l_pats, l_lens, a_patnr, a_flags);
+
+	free(l_pats);
+
+	return	l_mpm;
+}
+
+UTIL_MPM	*__util$mpm_compile_kwd	(
+	const KWDENT	*a_kwds,
+		int	a_kwdnr,
+		int	a_flags
+			)
+{
+UTIL_MPM	*l_mpm;
+const char	**l_pats;
+unsigned short	*l_lens;
+int	i;
+
+	if ( !(l_pats = malloc(a_kwdnr * (sizeof(char *) + sizeof(unsigned short)) + 1)) )
+		return	NULL;
+
+	l_lens = (unsigned short *) (l_pats + a_kwdnr);
+
+	for ( i = 0; i < a_kwdnr; i++ )
+		{
+		l_pats[i] = a_kwds[i].kwd.sts;
+		l_lens[i] = a_kwds[i].kwd.len;
+		}
+
+	l_mpm = s_mpm_compile(l_pats, l_lens, a_kwdnr, a_flags);
+
+	free(l_pats);
+
+	return	l_mpm;
+}
+
+void	__util$mpm_free	(
+		UTIL_MPM *a_mpm
+			)
+{
+	if ( !a_mpm )
+		return;
+
+	free(a_mpm->delta);
+	free(a_mpm->out);
+	free(a_mpm->outs);
+	free(a_mpm->patlen);
+	free(a_mpm);
+}
+
+/* Report matches are ended at the given position, return 0 to stop scanning */
+inline static int	s_mpm_report	(
+	const UTIL_MPM	*a_mpm,
+		unsigned a_row,
+		size_t	a_end,
+		UTIL_MPM_CB a_cb,
+		void	*a_arg,
+		int	*a_count
+			)
+{
+int	i;
+
+	for ( i = a_mpm->out[a_row / a_mpm->clsnr]; i >= 0; i = a_mpm->outs[i].next )
+		{
+		(*a_count)++;
+
+		if ( a_cb && !(1 & a_cb(a_arg, a_mpm->outs[i].id, a_end - a_mpm->patlen[a_mpm->outs[i].id], a_mpm->patlen[a_mpm->outs[i].id])) )
+			return	0;
+		}
+
+	return	1;
+}
+
+/*
+ *   DESCRIPTION: Scan the buffer for all patterns of the matcher in the single pass,
+ *	every match (including overlapped) is reported to the callback routine in order of
+ *	the match end position.
+ *	A transition of the DFA depends on the previous one, so to hide a latency of the table
+ *	lookup the halves of the large buffer are scanned at once, the matches of the second
+ *	half are deferred to keep the order.
+ *
+ *   INPUTS:
+ *	mpm:	A matcher has been compiled by the __util$mpm_compile()
+ *	buf:	A buffer to be scanned
+ *	bufsz:	A size of the data in the buffer
+ *	cb:	A callback routine: cb(arg, id, off, len), is called for every match, NULL - count only;
+ *		return even (error) condition code to stop scanning
+ *	arg:	An argument to be passed to the callback routine
+ *
+ *   RETURNS:
+ *	A number of the matches
+ */
+int	__util$mpm_scan	(
+	const UTIL_MPM	*a_mpm,
+	const void	*a_buf,
+		size_t	a_bufsz,
+		UTIL_MPM_CB a_cb,
+		void	*a_arg
+			)
+{
+const unsigned char *l_buf = (const unsigned char *) a_buf, *l_end = l_buf + a_bufsz, *l_cpa = l_buf, *l_cpb = l_end, *l_mid = l_end;
+const unsigned	*l_delta = a_mpm->delta;
+const unsigned short *l_cls = a_mpm->cls;
+unsigned	l_rowa = 0, l_rowb = 0, l_nexta, l_nextb;
+int	i, l_count = 0, l_defnr = 0;
+struct	{
+	unsigned	row;
+	size_t		end;
+	} l_defer[UTIL$K_MPM_DEFERNR];
+
+	/*
+	 * The second half is started before the middle to catch the matches are crossed it,
+	 * the matches are ended before the middle are reported by the first half.
+	 */
+	if ( (a_bufsz >= UTIL$K_MPM_SPLITSZ) && (a_mpm->maxlen < (int) (a_bufsz / 2)) )
+		{
+		l_mid = l_buf + a_bufsz / 2;
+		l_cpb = l_mid - (a_mpm->maxlen ? a_mpm->maxlen - 1 : 0);
+
+		for ( ; (l_cpa < l_mid) && (l_defnr < UTIL$K_MPM_DEFERNR); l_cpa++, l_cpb++ )
+			{
+			l_nexta = l_delta[l_rowa + l_cls[*l_cpa]];
+			l_nextb = l_delta[l_rowb + l_cls[*l_cpb]];
+			l_rowa = l_nexta & ~UTIL$M_MPM_OUT;
+			l_rowb = l_nextb & ~UTIL$M_MPM_OUT;
+
+			if ( unlikely(l_nexta & UTIL$M_MPM_OUT) )
+				if ( !s_mpm_report(a_mpm, l_rowa, l_cpa + 1 - l_buf, a_cb, a_arg, &l_count) )
+					return	l_count;
+
+			if ( unlikely(l_nextb & UTIL$M_MPM_OUT) && (l_cpb >= l_mid) )
+				{
+				l_defer[l_defnr].row = l_rowb;
+				l_defer[l_defnr++].end = l_cpb + 1 - l_buf;
+				}
+			}
+		}
+
+	/* Rest of the first half, whole buffer if it has not been split */
+	for ( ; l_cpa < l_mid; l_cpa++ )
+		{
+		l_nexta = l_delta[l_rowa + l_cls[*l_cpa]];
+		l_rowa = l_nexta & ~UTIL$M_MPM_OUT;
+
+		if ( unlikely(l_nexta & UTIL$M_MPM_OUT) )
+			if ( !s_mpm_report(a_mpm, l_rowa, l_cpa + 1 - l_buf, a_cb, a_arg, &l_count) )
+				return	l_count;
+		}
+
+	/* Deferred matches of the second half */
+	for ( i = 0; i < l_defnr; i++ )
+		if ( !s_mpm_report(a_mpm, l_defer[i].row, l_defer[i].end, a_cb, a_arg, &l_count) )
+			return	l_count;
+
+	/* Rest of the second half */
+	for ( ; l_cpb < l_end; l_cpb++ )
+		{
+		l_nextb = l_delta[l_rowb + l_cls[*l_cpb]];
+		l_rowb = l_nextb & ~UTIL$M_MPM_OUT;
+
+		if ( unlikely(l_nextb & UTIL$M_MPM_OUT) && (l_cpb >= l_mid) )
+			if ( !s_mpm_report(a_mpm, l_rowb, l_cpb + 1 - l_buf, a_cb, a_arg, &l_count) )
+				return	l_count;
+		}
+
+	return	l_count;
+}
+
+
+/*
+ * A set of the wildcard patterns: every pattern is anchored by its longest literal run without '%',
+ * the anchors are compiled into the multi-pattern matcher, so the string is scanned once and only
+ * patterns with an anchor are found in the string are verified by the __util$wild_match().
+ * Patterns without literals ("*", "%%%" ...) are verified for every string.
+ */
+#define	UTIL$K_WILDSET_STACKMAP	(8 * 1024)		/* A size of the visited patterns bitmap on the stack	*/
+
+struct	__util_wildset__ {
+	int		patnr;
+	UTIL_WILD	**wild;				/* Compiled patterns, index is a pattern id	*/
+	UTIL_MPM	*mpm;				/* Anchors matcher, NULL - no anchors		*/
+	int		*anchor2pat,			/* Anchor id -> pattern id			*/
+			*always,			/* Patterns without anchor			*/
+			alwaysnr;
+};
+
+typedef	struct __util_wildset_ctx__ {
+	const UTIL_WILDSET *set;
+	const char	*str;
+	size_t		len;
+	unsigned char	*visited;			/* A bitmap of the checked patterns		*/
+	int		*ids,				/* Matched pattern ids, NULL - the first only	*/
+			idsnr,
+			count,				/* A number of the matched patterns		*/
+			first;				/* The lowest matched pattern id, -1 - no match	*/
+} UTIL_WILDSET_CTX;
+
+/* Verify the pattern, add it into the results */
+static void	s_wildset_check	(
+		UTIL_WILDSET_CTX *a_ctx,
+		int	a_pat
+			)
+{
+int	j;
+
+	/* No map - the first matching pattern only is requested, a repeated check is just a waste of time */
+	if ( a_ctx->visited )
+		{
+		if ( a_ctx->visited[a_pat / 8] & (1 << (a_pat % 8)) )
+			return;
+
+		a_ctx->visited[a_pat / 8] |= (unsigned char) (1 << (a_pat % 8));
+		}
+
+	/* Only the first matching pattern is requested and the lower one has been found */
+	if ( !a_ctx->ids && (a_ctx->first >= 0) && (a_ctx->first < a_pat) )
+		return;
+
+	if ( !__util$wild_match(a_ctx->set->wild[a_pat], a_ctx->str, a_ctx->len) )
+		return;
+
+	/* Keep the lowest ids in ascending order, the highest one is dropped when the array is full */
+	if ( a_ctx->ids && a_ctx->idsnr )
+		{
+		j = (a_ctx->count < a_ctx->idsnr) ? a_ctx->count : a_ctx->idsnr - 1;
+
+		if ( (j < a_ctx->count) && (a_ctx->ids[j] < a_pat) )
+			j = -1;
+
+		for ( ; (j > 0) && (a_ctx->ids[j - 1] > a_pat); j-- )
+			a_ctx->ids[j] = a_ctx->ids[j - 1];
+
+		if ( j >= 0 )
+			a_ctx->ids[j] = a_pat;
+		}
+
+	a_ctx->count++;
+	a_ctx->first = ((a_ctx->first < 0) || (a_pat < a_ctx->first)) ? a_pat : a_ctx->first;
+}
+
+/* Callback for the anchors matcher */
+static int	s_wildset_anchor	(
+		void	*a_ctx,
+		int	a_id,
+		size_t	a_off,
+		size_t	a_len
+			)
+{
+UTIL_WILDSET_CTX *l_ctx = (UTIL_WILDSET_CTX *) a_ctx;
+
+	(void) a_off;						/* A position of the anchor is not used,	*/
+	(void) a_len;						/* the pattern is matched against whole string	*/
+
+	s_wildset_check(l_ctx, l_ctx->set->anchor2pat[a_id]);
+
+	return	STS$K_SUCCESS;
+}
+
+void	__util$wildset_free	(
+		UTIL_WILDSET *a_set
+			)
+{
+int	i;
+
+	if ( !a_set )
+		return;
+
+	for ( i = 0; a_set->wild && (i < a_set->patnr); i++ )
+		__util$wild_free(a_set->wild[i]);
+
+	__util$mpm_free(a_set->mpm);
+	free(a_set->wild);
+	free(a_set->anchor2pat);
+	free(a_set->always);
+	free(a_set);
+}
+
+/*
+ *   DESCRIPTION: Compile a set of the wildcard patterns, the semantic of the wildcards is the same
+ *	as for the __util$pattern_match().
+ *
+ *   INPUTS:
+ *	patterns: An array of the patterns, ASCIZ; an index of the pattern is used as pattern id
+ *	patnr:	A number of the patterns
+ *
+ *   RETURNS:
+ *	An address of the set, must be released by __util$wildset_free(), NULL - insufficient memory
+ */
+UTIL_WILDSET	*__util$wildset_compile	(
+	const char	**a_patterns,
+		int	a_patnr
+			)
+{
+UTIL_WILDSET	*l_set;
+ASC	*l_anchors = NULL;
+const UTIL_WILD	*l_wild;
+const char	*l_cp, *l_best;
+unsigned	l_run, l_bestlen, j;
+int	i, k, l_anchornr = 0;
+
+	if ( !(l_set = calloc(1, sizeof(UTIL_WILDSET))) )
+		return	NULL;
+
+	l_set->patnr = a_patnr;
+
+	if ( !(l_set->wild = calloc(a_patnr + 1, sizeof(UTIL_WILD *)))
+		|| !(l_set->anchor2pat = malloc((a_patnr + 1) * sizeof(int)))
+		|| !(l_set->always = malloc((a_patnr + 1) * sizeof(int)))
+		|| !(l_anchors = malloc((a_patnr + 1) * sizeof(ASC))) )
+		{
+		free(l_anchors);
+		__util$wildset_free(l_set);
+		return	NULL;
+		}
+
+	for ( i = 0; i < a_patnr; i++ )
+		{
+		if ( !(l_set->wild[i] = __util$wild_compile(a_patterns[i])) )
+			{
+			free(l_anchors);
+			__util$wildset_free(l_set);
+			return	NULL;
+			}
+
+		/* Looking for the longest run of the literal characters in the segments */
+		for ( l_wild = l_set->wild[i], l_best = NULL, l_bestlen = 0, k = 0; k < l_wild->segnr; k++ )
+			{
+			for ( l_cp = l_wild->pat + l_wild->seg[k].off, l_run = 0, j = 0; j <= l_wild->seg[k].len; j++ )
+				{
+				if ( (j < l_wild->seg[k].len) && (l_cp[j] != WILD_PERCENT) )
+					{
+					l_run++;
+					continue;
+					}
+
+				if ( l_run > l_bestlen )
+					{
+					l_bestlen = l_run;
+					l_best = l_cp + j - l_run;
+					}
+
+				l_run = 0;
+				}
+			}
+
+		if ( !l_bestlen )
+			{
+			l_set->always[l_set->alwaysnr++] = i;
+			continue;
+			}
+
+		/* A part of the long run is an anchor too */
+		l_anchors[l_anchornr].len = (unsigned char) ((l_bestlen < ASC$K_SZ) ? l_bestlen : ASC$K_SZ);
+		memcpy(l_anchors[l_anchornr].sts, l_best, l_anchors[l_anchornr].len);
+		l_set->anchor2pat[l_anchornr++] = i;
+		}
+
+	if ( l_anchornr && !(l_set->mpm = __util$mpm_compile(l_anchors, l_anchornr, 0)) )
+		{
+		free(l_anchors);
+		__util$wildset_free(l_set);
+		return	NULL;
+		}
+
+	free(l_anchors);
+
+	return	l_set;
+}
+
+/*
+ *   DESCRIPTION: Match the string against the set of the wildcard patterns.
+ *
+ *   INPUTS:
+ *	set:	A set has been compiled by the __util$wildset_compile()
+ *	str:	A string to be matched
+ *	strlen:	A length of the string
+ *	ids:	An array to accept the lowest ids of the matched patterns in ascending order,
+ *		NULL - the first one only
+ *	idsnr:	A size of the array
+ *
+ *   OUTPUTS:
+ *	idsnr:	A number of the matched patterns, can be more than the size of the array
+ *
+ *   RETURNS:
+ *	ids != NULL:	condition code, STS$K_ERROR - insufficient memory
+ *	ids == NULL:	The lowest id of the matched patterns, -1 - no match
+ */
+int	__util$wildset_match	(
+	const UTIL_WILDSET *a_set,
+	const char	*a_str,
+		size_t	a_strlen,
+		int	*a_ids,
+		int	*a_idsnr
+			)
+{
+UTIL_WILDSET_CTX l_ctx = {a_set, a_str, a_strlen, NULL, a_ids, (a_ids && a_idsnr) ? *a_idsnr : 0, 0, -1};
+unsigned char	l_map[UTIL$K_WILDSET_STACKMAP];
+int	i;
+
+	if ( (a_set->patnr / 8 + 1) <= (int) sizeof(l_map) )
+		memset(l_ctx.visited = l_map, 0, a_set->patnr / 8 + 1);
+	else if ( !(l_ctx.visited = calloc(a_set->patnr / 8 + 1, 1)) && a_ids )
+		return	$LOG(STS$K_ERROR, "Insufficient memory for %d patterns map", a_set->patnr);
+
+	for ( i = 0; i < a_set->alwaysnr; i++ )
+		s_wildset_check(&l_ctx, a_set->always[i]);
+
+	if ( a_set->mpm )
+		__util$mpm_scan(a_set->mpm, a_str, a_strlen, s_wildset_anchor, &l_ctx);
+
+	if ( l_ctx.visited != l_map )
+		free(l_ctx.visited);
+
+	if ( !a_ids )
+		return	l_ctx.first;
+
+	if ( a_idsnr )
+		*a_idsnr = l_ctx.count;
+
+	return	STS$K_SUCCESS;
+}
+
+#ifndef	WIN32
+typedef	struct __util_wildset_job__ {
+	const UTIL_WILDSET *set;
+	const ASC	*strs;
+	int		*ids,
+			strnr,
+			next;				/* Next string to be matched, is shared by the threads */
+} UTIL_WILDSET_JOB;
+
+#define	UTIL$K_WILDSET_CHUNK	64			/* A number of strings are taken by the thread at once	*/
+
+static void	*s_wildset_worker	(
+		void	*a_job
+			)
+{
+UTIL_WILDSET_JOB *l_job = (UTIL_WILDSET_JOB *) a_job;
+int	i, l_end;
+
+	while ( (i = __atomic_fetch_add(&l_job->next, UTIL$K_WILDSET_CHUNK, __ATOMIC_RELAXED)) < l_job->strnr )
+		{
+		l_end = ((i + UTIL$K_WILDSET_CHUNK) < l_job->strnr) ? i + UTIL$K_WILDSET_CHUNK : l_job->strnr;
+
+		for ( ; i < l_end; i++ )
+			l_job->ids[i] = __util$wildset_match(l_job->set, l_job->strs[i].sts, l_job->strs[i].len, NULL, NULL);
+		}
+
+	return	NULL;
+}
+#endif
+
+/*
+ *   DESCRIPTION: Match the strings against the set of the wildcard patterns by the several threads.
+ *
+ *   INPUTS:
+ *	set:	A set has been compiled by the __util$wildset_compile()
+ *	strs:	An array of the strings to be matched
+ *	strnr:	A number of the strings
+ *	thrnr:	A number of the threads, the current thread is one of them
+ *
+ *   OUTPUTS:
+ *	ids:	An array of the lowest ids of matched patterns for every string, -1 - no match
+ *
+ *   RETURNS:
+ *	STS$K_SUCCESS
+ */
+int	__util$wildset_batch	(
+	const UTIL_WILDSET *a_set,
+	const ASC	*a_strs,
+		int	a_strnr,
+		int	*a_ids,
+		int	a_thrnr
+			)
+{
+#ifndef	WIN32
+UTIL_WILDSET_JOB l_job = {a_set, a_strs, a_ids, a_strnr, 0};
+pthread_t	l_tids[UTIL$K_WILDSET_MAXTHR];
+int	i, l_thrnr;
+
+	a_thrnr = (a_thrnr < UTIL$K_WILDSET_MAXTHR) ? a_thrnr : UTIL$K_WILDSET_MAXTHR;
+
+	/* Start additional threads, the current thread is working too */
+	for ( l_thrnr = 0; l_thrnr < (a_thrnr - 1); l_thrnr++ )
+		if ( pthread_create(&l_tids[l_thrnr], NULL, s_wildset_worker, &l_job) )
+			break;
+
+	s_wildset_worker(&l_job);
+
+	for ( i = 0; i < l_thrnr; i++ )
+		pthread_join(l_tids[i], NULL);
+#else
+int	i;
+
+	for ( i = 0; i < a_strnr; i++ )
+		a_ids[i] = __util$wildset_match(a_set, a_strs[i].sts, a_strs[i].len, NULL, NULL);
+#endif
+
+	return	STS$K_SUCCESS;
+}
+
+
+/*
+ * Compiled keywords table: a trie is built over the keywords are case-folded at compile time
+ * (UTIL$K_LOOKUP_NCASE), the characters are mapped into the classes like the __util$mpm_*().
+ * Every node knows the keyword is ended at the node and the only keyword is ended under the node,
+ * so exact and unique abbreviation lookups are done by the single walk over the token.
+ */
+#define	UTIL$K_KWDIDX_AMBIG	(-2)			/* Several keywords are ended under the node		*/
+
+typedef	struct __util_kwdnode__ {
+	int	exact,					/* An index of the keyword is ended at the node, -1 - none */
+		uniq;					/* An index of the only keyword under the node, -1 - none,
+							   UTIL$K_KWDIDX_AMBIG - several keywords */
+} UTIL_KWDNODE;
+
+struct	__util_kwdidx__ {
+	KWDENT		*ktbl;				/* Table has been compiled, is not copied ! */
+	unsigned short	cls[256];			/* Character -> class map, 0 - not used by the keywords */
+	int		flags,
+			clsnr,				/* A number of classes, a length of the row */
+			nodenr;
+	UTIL_KWDNODE	*nodes;
+	int		*next;				/* Transitions: nodenr * clsnr, 0 - no transition */
+};
+
+/*
+ *   DESCRIPTION: Compile keywords table into the index for the __util$kwdidx_lookup(),
+ *	the table must not be changed or released while the index is in use.
+ *
+ *   INPUTS:
+ *	ktbl:	A keyword table
+ *	ktblsz:	A size of the keywords table (in elements)
+ *	flags:	UTIL$K_LOOKUP_NCASE
+ *
+ *   RETURNS:
+ *	An address of the index, NULL - insufficient memory
+ */
+UTIL_KWDIDX	*__util$kwdidx_compile	(
+		KWDENT	*a_ktbl,
+		int	a_ktblsz,
+		int	a_flags
+			)
+{
+UTIL_KWDIDX	*l_idx;
+int	i, j, l_node, l_maxnodes = 1, *l_next;
+unsigned char	c;
+
+	if ( !(l_idx = calloc(1, sizeof(UTIL_KWDIDX))) )
+		return	NULL;
+
+	l_idx->ktbl = a_ktbl;
+	l_idx->flags = a_flags;
+	l_idx->clsnr = 1;
+
+	/* Assign classes to the characters of the keywords */
+	for ( i = 0; i < a_ktblsz; i++ )
+		{
+		l_maxnodes += a_ktbl[i].kwd.len;
+
+		for ( j = 0; j < a_ktbl[i].kwd.len; j++ )
+			{
+			c = (a_flags & UTIL$K_LOOKUP_NCASE) ? tolower((unsigned char) a_ktbl[i].kwd.sts[j]) : (unsigned char) a_ktbl[i].kwd.sts[j];
+
+			if ( !l_idx->cls[c] )
+				{
+				l_idx->cls[c] = l_idx->clsnr++;
+
+				if ( (a_flags & UTIL$K_LOOKUP_NCASE) && isalpha(c) )
+					l_idx->cls[toupper(c)] = l_idx->cls[c];
+				}
+			}
+		}
+
+	l_idx->nodenr = 1;
+
+	if ( !(l_idx->nodes = malloc(l_maxnodes * sizeof(UTIL_KWDNODE)))
+		|| !(l_idx->next = calloc((size_t) l_maxnodes * l_idx->clsnr, sizeof(int))) )
+		{
+		__util$kwdidx_free(l_idx);
+		return	NULL;
+		}
+
+	l_idx->nodes[0].exact = l_idx->nodes[0].uniq = -1;
+
+	for ( i = 0; i < a_ktblsz; i++ )
+		{
+		for ( l_node = j = 0; j < a_ktbl[i].kwd.len; j++ )
+			{
+			l_next = &l_idx->next[l_node * l_idx->clsnr + l_idx->cls[(unsigned char) a_ktbl[i].kwd.sts[j]]];
+
+			if ( !*l_next )
+				{
+				*l_next = l_idx->nodenr++;
+				l_idx->nodes[*l_next].exact = l_idx->nodes[*l_next].uniq = -1;
+				}
+
+			l_node = *l_next;
+			}
+
+		/* A duplicate of the keyword is never found */
+		if ( l_idx->nodes[l_node].exact >= 0 )
+			continue;
+
+		l_idx->nodes[l_node].exact = i;
+
+		/* Walk again from the root to count the new keyword in the nodes on the path */
+		for ( l_node = j = 0; ; j++ )
+			{
+			l_idx->nodes[l_node].uniq = (l_idx->nodes[l_node].uniq == -1) ? i : UTIL$K_KWDIDX_AMBIG;
+
+			if ( j == a_ktbl[i].kwd.len )
+				break;
+
+			l_node = l_idx->next[l_node * l_idx->clsnr + l_idx->cls[(unsigned char) a_ktbl[i].kwd.sts[j]]];
+			}
+		}
+
+	/* Release unused space */
+	if ( (l_next = realloc(l_idx->next, (size_t) l_idx->nodenr * l_idx->clsnr * sizeof(int))) )
+		l_idx->next = l_next;
+
+	return	l_idx;
+}
+
+/*
+ *   DESCRIPTION: Translate a given keyword string to the entry of the keywords table by the index,
+ *	an exact match is preferred over an abbreviation.
+ *
+ *   INPUTS:
+ *	idx:	An index has been compiled by the __util$kwdidx_compile()
+ *	src:	A pointer to the buffer with string to process
+ *	srclen:	A length of the source buffer
+ *	flags:	UTIL$K_LOOKUP_ABBREV, case sensitivity is defined at compile time
+ *
+ *   OUTPUTS:
+ *	kwd:	A has been found keyword's entry
+ *
+ *   RETURNS:
+ *	STS$K_SUCCESS	- keyword has been found, result in the <kwd>
+ *	STS$K_ERROR	- no matching keyword
+ *	STS$K_FATAL	- ambiguous abbreviation
+ */
+int	__util$kwdidx_lookup	(
+	const UTIL_KWDIDX *a_idx,
+	const char	*a_src,
+		int	a_srclen,
+		KWDENT	**a_kwd,
+		int	a_flags
+			)
+{
+const UTIL_KWDNODE	*l_node;
+int	l_node_idx = 0, l_cls;
+
+	for ( ; a_srclen > 0; a_srclen--, a_src++ )
+		{
+		if ( !(l_cls = a_idx->cls[(unsigned char) *a_src]) )
+			return	STS$K_ERROR;
+
+		if ( !(l_node_idx = a_idx->next[l_node_idx * a_idx->clsnr + l_cls]) )
+			return	STS$K_ERROR;
+		}
+
+	l_node = &a_idx->nodes[l_node_idx];
+
+	if ( l_node->exact >= 0 )
+		{
+		*a_kwd = &a_idx->ktbl[l_node->exact];
+		return	STS$K_SUCCESS;
+		}
+
+	if ( !(a_flags & UTIL$K_LOOKUP_ABBREV) || (l_node->uniq == -1) )
+		return	STS$K_ERROR;
+
+	if ( l_node->uniq == UTIL$K_KWDIDX_AMBIG )
+		return	STS$K_FATAL;
+
+	*a_kwd = &a_idx->ktbl[l_node->uniq];
+
+	return	STS$K_SUCCESS;
+}
+
+void	__util$kwdidx_free	(
+		UTIL_KWDIDX	*a_idx
+			)
+{
+	if ( !a_idx )
+		return;
+
+	free(a_idx->nodes);
+	free(a_idx->next);
+	free(a_idx);
+}
+
+
+/*
+ * String arena: blocks are chained, an allocation is a bump of the pointer in the current block.
+ * The __util$arena_reset() just returns to the first block, the blocks are reused by next allocations.
+ */
+struct	__util_arena_blk__ {
+	UTIL_ARENA_BLK	*next;
+	size_t		size;				/* A size of the data area */
+	long long	data[];				/* Aligned data area */
+};
+
+/* Switch to the next block or allocate new one to satisfy the request */
+static void	*s_arena_grow	(
+		UTIL_ARENA	*a_arena,
+		size_t		a_sz
+			)
+{
+UTIL_ARENA_BLK	*l_blk;
+size_t	l_blksz = a_arena->blksz ? a_arena->blksz : UTIL$K_ARENA_BLKSZ;
+
+	/* Is there a block has been kept after reset ? */
+	if ( !a_arena->cur || !(l_blk = a_arena->cur->next) || (l_blk->size < a_sz) )
+		{
+		l_blksz = (a_sz > l_blksz) ? a_sz : l_blksz;
+
+		if ( !(l_blk = malloc(sizeof(UTIL_ARENA_BLK) + l_blksz)) )
+			return	NULL;
+
+		l_blk->size = l_blksz;
+
+		/* Insert new block after the current one */
+		if ( a_arena->cur )
+			{
+			l_blk->next = a_arena->cur->next;
+			a_arena->cur->next = l_blk;
+			}
+		else	{
+			l_blk->next = a_arena->head;
+			a_arena->head = l_blk;
+			}
+		}
+
+	a_arena->cur = l_blk;
+	a_arena->ptr = (char *) l_blk->data + a_sz;
+	a_arena->end = (char *) l_blk->data + l_blk->size;
+
+	return	l_blk->data;
+}
+
+/*
+ *   DESCRIPTION: Initialize an arena, no memory is allocated until first request.
+ *
+ *   INPUTS:
+ *	arena:	An arena to be initialized
+ *	blksz:	A size of the block, 0 - UTIL$K_ARENA_BLKSZ
+ *
+ *   RETURNS:
+ *	STS$K_SUCCESS
+ */
+int	__util$arena_init	(
+		UTIL_ARENA	*a_arena,
+		size_t		a_blksz
+			)
+{
+	memset(a_arena, 0, sizeof(UTIL_ARENA));
+	a_arena->blksz = a_blksz;
+
+	return	STS$K_SUCCESS;
+}
+
+/*
+ *   DESCRIPTION: Allocate a memory area from the arena, the area is aligned on UTIL$K_ARENA_ALIGN
+ *	and is not zeroed.
+ *
+ *   RETURNS:
+ *	An address of the area, NULL - insufficient memory
+ */
+void	*__util$arena_alloc	(
+		UTIL_ARENA	*a_arena,
+		size_t		a_sz
+			)
+{
+char	*l_ptr;
+
+	a_sz = a_sz ? (a_sz + (UTIL$K_ARENA_ALIGN - 1)) & ~((size_t) UTIL$K_ARENA_ALIGN - 1) : UTIL$K_ARENA_ALIGN;
+
+	if ( unlikely((size_t) (a_arena->end - a_arena->ptr) < a_sz) )
+		return	s_arena_grow(a_arena, a_sz);
+
+	l_ptr = a_arena->ptr;
+	a_arena->ptr += a_sz;
+
+	return	l_ptr;
+}
+
+/*
+ *   DESCRIPTION: Put a string into the arena as the compact counted string: <1 + length + 1> octets,
+ *	a string is longer than ASC$K_SZ - 1 is truncated like by the __util$sv2asc().
+ *
+ *   INPUTS:
+ *	arena:	An arena
+ *	src:	A string to be copied
+ *	srclen:	A length of the string
+ *
+ *   RETURNS:
+ *	An address of the string to be read by the $ASC*() macros, NULL - insufficient memory
+ */
+const ASC	*__util$arena_asc	(
+		UTIL_ARENA	*a_arena,
+		const char	*a_src,
+		size_t		a_srclen
+			)
+{
+ASC	*l_asc;
+
+	a_srclen = (a_srclen < (ASC$K_SZ - 1)) ? a_srclen : (ASC$K_SZ - 1);
+
+	if ( !(l_asc = __util$arena_alloc(a_arena, a_srclen + 2)) )
+		return	NULL;
+
+	l_asc->len = (unsigned char) a_srclen;
+	memcpy(l_asc->sts, a_src, a_srclen);
+	l_asc->sts[a_srclen] = '\0';
+
+	return	l_asc;
+}
+
+/*
+ *   DESCRIPTION: Put a copy of the string into the arena, the copy is null-terminated.
+ *
+ *   RETURNS:
+ *	A view of the copy, an address is NULL - insufficient memory
+ */
+STRVIEW	__util$arena_sv	(
+		UTIL_ARENA	*a_arena,
+		const char	*a_src,
+		size_t		a_srclen
+			)
+{
+STRVIEW	l_sv = {NULL, 0};
+char	*l_cp;
+
+	if ( !(l_cp = __util$arena_alloc(a_arena, a_srclen + 1)) )
+		return	l_sv;
+
+	memcpy(l_cp, a_src, a_srclen);
+	l_cp[a_srclen] = '\0';
+
+	l_sv.ptr = l_cp;
+	l_sv.len = a_srclen;
+
+	return	l_sv;
+}
+
+/* Release all allocations at once, the blocks are kept to be reused */
+void	__util$arena_reset	(
+		UTIL_ARENA	*a_arena
+			)
+{
+	if ( !(a_arena->cur = a_arena->head) )
+		return;
+
+	a_arena->ptr = (char *) a_arena->head->data;
+	a_arena->end = (char *) a_arena->head->data + a_arena->head->size;
+}
+
+/* Release all blocks of the arena, an arena can be allocated in the own block */
+void	__util$arena_free	(
+		UTIL_ARENA	*a_arena
+			)
+{
+UTIL_ARENA_BLK	*l_blk, *l_next;
+
+	for ( l_blk = a_arena->head; l_blk; l_blk = l_next )
+		{
+		l_next = l_blk->next;
+		free(l_blk);
+		}
+}
+
+
+
+/*
+ * UUID: the version 4 (random) and version 7 (Unix time-ordered, RFC 9562) generators are fed by
+ * a per-thread xoshiro256** generator, it's seeded from the getrandom() (when available), the time,
+ * the PID/TID and is reseeded in the child process after fork().
+ * Version 7 keeps a 12-bits counter in the 'rand_a' field, so the UUIDs are generated by a thread
+ * are monotonic even in the same millisecond.
+ * The text form is produced and parsed by the tables, without the printf()/scanf() family.
+ */
+typedef	struct __util_uuid_rng__
+{
+	unsigned long long	s[4];			/* xoshiro256** state				*/
+	unsigned long long	lastms;			/* v7: a timestamp of the last UUID		*/
+	unsigned		seq,			/* v7: a counter in the 'rand_a' field		*/
+				gen;			/* A fork generation of the seed, 0 - not seeded*/
+} UTIL_UUID_RNG;
+
+static __thread UTIL_UUID_RNG	s_uuid_rng;
+static unsigned			s_uuid_gen = 1;		/* Is bumped in the child process		*/
+static pthread_once_t		s_uuid_once = PTHREAD_ONCE_INIT;
+
+/* Offsets of the octets' hex digits in the "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx" */
+static const unsigned char s_uuid_off[UTIL$K_UUIDSZ] = {0, 2, 4, 6, 9, 11, 14, 16, 19, 21, 24, 26, 28, 30, 32, 34};
+
+static void	s_uuid_atfork	(void)
+{
+	__atomic_add_fetch(&s_uuid_gen, 1, __ATOMIC_RELAXED);
+}
+
+static void	s_uuid_once_init	(void)
+{
+	pthread_atfork(NULL, NULL, s_uuid_atfork);
+}
+
+inline static unsigned long long	s_splitmix64	(
+		unsigned long long	*a_x
+			)
+{
+unsigned long long	l_z = (*a_x += 0x9E3779B97F4A7C15ULL);
+
+	l_z = (l_z ^ (l_z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	l_z = (l_z ^ (l_z >> 27)) * 0x94D049BB133111EBULL;
+
+	return	l_z ^ (l_z >> 31);
+}
+
+static void	s_uuid_seed	(
+		UTIL_UUID_RNG	*a_rng,
+		unsigned	a_gen
+			)
+{
+unsigned long long	l_rnd[4] = {0}, l_x;
+struct timespec	l_now;
+int	i;
+
+	pthread_once(&s_uuid_once, s_uuid_once_init);
+
+#if	defined(__linux__) && defined(SYS_getrandom)
+	syscall(SYS_getrandom, l_rnd, sizeof(l_rnd), 1 /* GRND_NONBLOCK */);
+#endif
+	/* The entropy is mixed in anyway: getrandom() can be unavailable or failed */
+	clock_gettime(CLOCK_REALTIME, &l_now);
+	l_x = ((unsigned long long) l_now.tv_sec * 1000000000ULL + l_now.tv_nsec)
+		^ ((unsigned long long) getpid() << 32) ^ (unsigned long long) __gettid() ^ (unsigned long long) (size_t) a_rng;
+
+	for ( i = 0; i < 4; i++ )
+		a_rng->s[i] = l_rnd[i] ^ s_splitmix64(&l_x);
+
+	a_rng->lastms = 0;
+	a_rng->seq = 0;
+	a_rng->gen = a_gen;
+}
+
+inline static unsigned long long	s_uuid_rotl	(
+		unsigned long long	a_x,
+		int		a_k
+			)
+{
+	return	(a_x << a_k) | (a_x >> (64 - a_k));
+}
+
+/* xoshiro256** step */
+inline static unsigned long long	s_uuid_next	(
+		UTIL_UUID_RNG	*a_rng
+			)
+{
+unsigned long long	*l_s = a_rng->s, l_res = s_uuid_rotl(l_s[1] * 5, 7) * 9, l_t = l_s[1] << 17;
+
+	l_s[2] ^= l_s[0];
+	l_s[3] ^= l_s[1];
+	l_s[1] ^= l_s[2];
+	l_s[0] ^= l_s[3];
+	l_s[2] ^= l_t;
+	l_s[3] = s_uuid_rotl(l_s[3], 45);
+
+	return	l_res;
+}
+
+/* Return the thread's generator, (re)seed it at first use and after fork() */
+inline static UTIL_UUID_RNG	*s_uuid_rng_get	(void)
+{
+UTIL_UUID_RNG	*l_rng = &s_uuid_rng;
+unsigned	l_gen = __atomic_load_n(&s_uuid_gen, __ATOMIC_RELAXED);
+
+	if ( unlikely(l_rng->gen != l_gen) )
+		s_uuid_seed(l_rng, l_gen);
+
+	return	l_rng;
+}
+
+inline static unsigned long long	s_uuid_load64	(
+	const unsigned char	*a_src
+			)
+{
+unsigned long long	l_val;
+
+	memcpy(&l_val, a_src, sizeof(l_val));
+
+#if	__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	l_val = __builtin_bswap64(l_val);
+#endif
+	return	l_val;
+}
+
+/*
+ *   DESCRIPTION: Generate a random UUID (version 4).
+ *
+ *   OUTPUTS:
+ *	uuid:	A 16 octets buffer to accept UUID
+ *
+ *   RETURNS:
+ *	STS$K_SUCCESS
+ */
+int	__util$uuid_v4	(
+		void	*a_uuid
+			)
+{
+UTIL_UUID_RNG	*l_rng = s_uuid_rng_get();
+unsigned long long	l_rnd[2];
+unsigned char	*l_uuid = (unsigned char *) a_uuid;
+
+	l_rnd[0] = s_uuid_next(l_rng);
+	l_rnd[1] = s_uuid_next(l_rng);
+	memcpy(l_uuid, l_rnd, UTIL$K_UUIDSZ);
+
+	l_uuid[6] = (l_uuid[6] & 0x0F) | 0x40;			/* Version 4					*/
+	l_uuid[8] = (l_uuid[8] & 0x3F) | 0x80;			/* Variant 10xx - RFC 9562			*/
+
+	return	STS$K_SUCCESS;
+}
+
+/*
+ *   DESCRIPTION: Generate a time-ordered UUID (version 7): 48 bits of the Unix time in milliseconds,
+ *	12 bits of the counter, 62 random bits. The counter starts from the random value in the new
+ *	millisecond and is incremented in the same one, at overflow (or if the clock has gone back)
+ *	the timestamp of the previous UUID is continued.
+ *
+ *   OUTPUTS:
+ *	uuid:	A 16 octets buffer to accept UUID
+ *
+ *   RETURNS:
+ *	STS$K_SUCCESS
+ */
+int	__util$uuid_v7	(
+		void	*a_uuid
+			)
+{
+UTIL_UUID_RNG	*l_rng = s_uuid_rng_get();
+unsigned long long	l_ms, l_rnd = s_uuid_next(l_rng);
+unsigned char	*l_uuid = (unsigned char *) a_uuid;
+struct timespec	l_now;
+
+	clock_gettime(CLOCK_REALTIME, &l_now);
+	l_ms = (unsigned long long) l_now.tv_sec * 1000ULL + l_now.tv_nsec / 1000000;
+
+	if ( l_ms > l_rng->lastms )
+		l_rng->seq = (unsigned) (l_rnd >> 53) & 0x7FF;	/* A half of the range is left to increment	*/
+	else if ( ++l_rng->seq > 0xFFF )
+		{
+		l_ms = l_rng->lastms + 1;
+		l_rng->seq = 0;
+		}
+	else	l_ms = l_rng->lastms;
+
+	l_rng->lastms = l_ms;
+
+	l_uuid[0] = (unsigned char) (l_ms >> 40);
+	l_uuid[1] = (unsigned char) (l_ms >> 32);
+	l_uuid[2] = (unsigned char) (l_ms >> 24);
+	l_uuid[3] = (unsigned char) (l_ms >> 16);
+	l_uuid[4] = (unsigned char) (l_ms >> 8);
+	l_uuid[5] = (unsigned char) l_ms;
+	l_uuid[6] = 0x70 | (unsigned char) (l_rng->seq >> 8);	/* Version 7					*/
+	l_uuid[7] = (unsigned char) l_rng->seq;
+
+	memcpy(l_uuid + 8, &l_rnd, 8);
+	l_uuid[8] = (l_uuid[8] & 0x3F) | 0x80;			/* Variant 10xx - RFC 9562			*/
+
+	return	STS$K_SUCCESS;
+}
+
+/*
+ *   DESCRIPTION: Convert UUID from the binary form to the text string "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx"
+ *	in lower case, the string is null-terminated, it's truncated to fit into the buffer.
+ *
+ *   INPUTS:
+ *	uuid:	UUID to be converted
+ *	buf:	A buffer to accept text string
+ *	bufsz:	A size of the buffer, UTIL$K_UUIDSTRLEN + 1 is enough
+ *
+ *   RETURNS:
+ *	A length of the string in the buffer
+ */
+int	__util$uuid2str	(
+	const void	*a_uuid,
+		char	*a_buf,
+		int	a_bufsz
+			)
+{
+const unsigned char	*l_uuid = (const unsigned char *) a_uuid;
+char	l_tmp[UTIL$K_UUIDSTRLEN], *l_dst;
+int	i, l_len;
+
+	if ( a_bufsz < 1 )
+		return	0;
+
+	l_dst = (a_bufsz > UTIL$K_UUIDSTRLEN) ? a_buf : l_tmp;
+
+	for ( i = 0; i < UTIL$K_UUIDSZ; i++ )
+		memcpy(l_dst + s_uuid_off[i], __util$hex2lut_lc + l_uuid[i] * 2, 2);
+
+	l_dst[8] = l_dst[13] = l_dst[18] = l_dst[23] = '-';
+
+	if ( (l_len = UTIL$K_UUIDSTRLEN) > a_bufsz - 1 )
+		memcpy(a_buf, l_tmp, l_len = a_bufsz - 1);
+
+	a_buf[l_len] = '\0';
+
+	return	l_len;
+}
+
+/*
+ *   DESCRIPTION: Parse UUID in the canonical text form "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx",
+ *	hex digits in any case are accepted, nothing else.
+ *
+ *   INPUTS:
+ *	src:	A text string
+ *	srclen:	A length of the string
+ *
+ *   OUTPUTS:
+ *	uuid:	A 16 octets buffer to accept UUID, it's not changed on error
+ *
+ *   RETURNS:
+ *	STS$K_SUCCESS, STS$K_ERROR - illformed UUID string
+ */
+int	__util$uuid_parse	(
+	const char	*a_src,
+		size_t	a_srclen,
+		void	*a_uuid
+			)
+{
+const unsigned char	*l_src = (const unsigned char *) a_src;
+unsigned char	l_bin[UTIL$K_UUIDSZ], l_hi, l_lo, l_ok = 0x10;
+int	i;
+
+	if ( (a_srclen != UTIL$K_UUIDSTRLEN)
+		|| (l_src[8] != '-') || (l_src[13] != '-') || (l_src[18] != '-') || (l_src[23] != '-') )
+		return	STS$K_ERROR;
+
+	/* 0x10 bit is set for all valid digits in the s_hexval[] */
+	for ( i = 0; i < UTIL$K_UUIDSZ; i++ )
+		{
+		l_hi = s_hexval[l_src[s_uuid_off[i]]];
+		l_lo = s_hexval[l_src[s_uuid_off[i] + 1]];
+
+		l_ok &= l_hi & l_lo;
+		l_bin[i] = (unsigned char) ((l_hi << 4) | (l_lo & 0x0F));
+		}
+
+	if ( !l_ok )
+		return	STS$K_ERROR;
+
+	memcpy(a_uuid, l_bin, UTIL$K_UUIDSZ);
+
+	return	STS$K_SUCCESS;
+}
+
+/*
+ *   DESCRIPTION: Compare two UUIDs as 128-bits big-endian numbers, so the version 7 UUIDs are ordered by time.
+ *
+ *   RETURNS:
+ *	<0, 0, >0 - like the memcmp()
+ */
+int	__util$uuid_cmp	(
+	const void	*a_uuid1,
+	const void	*a_uuid2
+			)
+{
+unsigned long long	l_a = s_uuid_load64(a_uuid1), l_b = s_uuid_load64(a_uuid2);
+
+	if ( l_a == l_b )
+		{
+		l_a = s_uuid_load64((const unsigned char *) a_uuid1 + 8);
+		l_b = s_uuid_load64((const unsigned char *) a_uuid2 + 8);
+		}
+
+	return	(l_a > l_b) - (l_a < l_b);
+}
+
+/* Return a 64-bits hash of UUID, all 128 bits are mixed in (the version 7 UUIDs have not the random prefix) */
+unsigned long long	__util$uuid_hash	(
+	const void	*a_uuid
+			)
+{
+unsigned long long	l_h, l_lo;
+
+	memcpy(&l_h, a_uuid, 8);
+	memcpy(&l_lo, (const unsigned char *) a_uuid + 8, 8);
+
+	l_h ^= s_uuid_rotl(l_lo, 29) * 0x9E3779B97F4A7C15ULL;
+	l_h = (l_h ^ (l_h >> 33)) * 0xFF51AFD7ED558CCDULL;
+	l_h = (l_h ^ (l_h >> 33)) * 0xC4CEB9FE1A85EC53ULL;
+
+	return	l_h ^ (l_h >> 33);
+}
+
+
+
+unsigned	__util$out
+			(
+		char *	fmt,
+			...
+			)
+
+{
+va_list arglist;
+char	out[1024] = {0};
+int	olen = 0;
+
+	va_start (arglist, fmt);
+	olen += vsnprintf(out, sizeof(out) - 1, fmt, arglist);
+	va_end (arglist);
+
+	/* Add <LF> at end of record*/
+	out[olen++] = '\n';
+
+	/* Write to file and flush buffer depending on severity level */
+	if( p_cb_log_f )
+		p_cb_log_f(out, olen);
+	else	write (g_logoutput, out, olen);
+
+	return	STS$K_SUCCESS;
+}
+
+
+
+
+
+
+
+
+
+
+/*
+ * stc_msg_vformat
+ *
+ * The core formatting routine.
+ * Do NOT use sprintf-style formatting codes in
+ * message strings! Use the formatting directives
+ * below:
+ * !A{D, Z, C}
+ * !U{Q, L, W, B} = unsigned quad\int64, int32, short, byte
+ * !S{Q, L, W, B} = signed quad\int64, int32, short, byte
+ * !X{Q, L, W, B} = hexadecimal quad\int64, int32, short, byte
+ * !P = pointer
+ * !T = time (DD-MMM-YYYY HH:MM:SS)
+ * !D = date (DD-MMM-YYYY)
+ * !! = exclamation point
+ */
+#ifdef	WIN32
+#define	snprintf(buf, len, format,...)	_snprintf_s(buf, len, len, format, __VA_ARGS__)
+#endif
+
+/*
+ * Format a single directive: !U{B,W,L,Q}, !S{B,W,L,Q}, !X{B,W,L,Q}, !P, !A{D,Z,C}, is shared
+ * by the __util$vfao() and the compiled FAO programs executor to get byte-identical output.
+ *
+ * Return:
+ *	-1	- formatting error, stop processing
+ *	0	- unrecognized directive, nothing has been consumed
+ *	>0	- a number of the control string characters has been consumed
+ */
+static int	s_fao_directive	(
+		char	a_d1,
+		char	a_d2,
+		char	**a_outp,
+		size_t	*a_bufsz,
+		va_list	*a_ap
+			)
+{
+int	l_len;
+char	*outp = *a_outp;
+size_t	a_bufsz_ = *a_bufsz;
+
+	/* !X{L, W, B}, U{L, W, B}, S{L, W, B}, Q{L, W, B} - formatted by the table-driven kernels
+	** into the local buffer, the result is the same as from the "0x%02X", "%3u", "%5u", "%6d",
+	** "%u", "%d", "0x%016llx" ... formats
+	*/
+	if (a_d1 == 'U' || a_d1 == 'X' || a_d1 == 'S' )
+		{
+		uint64_t l_val = 0;
+		char	l_buf[32], *l_cp = l_buf + sizeof(l_buf), *l_end = l_cp;
+		int	l_width, l_neg = 0;
+
+		if (a_d2 == 'B')
+			{
+			l_val = (unsigned char) va_arg(*a_ap, int);
+			l_width = (a_d1 == 'X') ? 2 : 3;
+			}
+		else if (a_d2 == 'W')
+			{
+			l_val = (uint16_t) va_arg(*a_ap, int);
+			l_width = (a_d1 == 'X') ? 4 : ( a_d1 == 'U') ? 5 : 6;
+			}
+		else if (a_d2 == 'L')
+			{
+			l_val = va_arg(*a_ap, uint32_t);
+			l_width = (a_d1 == 'X') ? 8 : 0;
+
+			if ( (a_d1 == 'S') && (l_neg = ((int32_t) l_val < 0)) )
+				l_val = 0ULL - (uint64_t) (int64_t) (int32_t) l_val;
+			}
+		else if (a_d2 == 'Q')
+			{
+			l_val = va_arg(*a_ap, uint64_t);
+			l_width = (a_d1 == 'X') ? 16 : 0;
+
+			if ( (a_d1 == 'S') && (l_neg = ((int64_t) l_val < 0)) )
+				l_val = 0ULL - l_val;
+			}
+		else	return	0;
+
+		if ( a_d1 == 'X' )
+			{
+			l_cp -= l_width;
+			__util$u64_2_hex(l_val, l_width, (a_d2 == 'Q') ? __util$hex2lut_lc : __util$hex2lut_uc, l_cp);
+			*(--l_cp) = 'x';
+			*(--l_cp) = '0';
+			}
+		else	{
+			l_cp -= __util$u64_2_decrev(l_val, l_end);
+
+			if ( l_neg )
+				*(--l_cp) = '-';
+
+			while ( (l_end - l_cp) < l_width )
+				*(--l_cp) = ' ';
+			}
+
+		if ( !a_bufsz_ )
+			return	-1;
+
+		l_len = (int) (l_end - l_cp);
+
+		if ( (size_t) l_len >= a_bufsz_ )			/* l_len is not negative here */
+			l_len = (int) (a_bufsz_ - 1);
+
+		memcpy(outp, l_cp, l_len);
+		outp[l_len] = '\0';
+
+		*a_outp	+= l_len;
+		*a_bufsz -= l_len;
+
+		return	2;
+		}
+
+	/* !P
+	*/
+	if (a_d1 == 'P')
+		{
+		if ( 0 > (l_len = snprintf(outp, a_bufsz_, "@%p", va_arg(*a_ap, void *))) )
+			return	-1;
+
+		if ( (size_t) l_len >= a_bufsz_ )			/* l_len is not negative here */
+			l_len = (int) (a_bufsz_ - 1);
+
+		*a_outp	+= l_len;
+		*a_bufsz -= l_len;
+
+		return	1;
+		}
+
+	/* !AD, !AC, !AZ ...	*/
+	if (a_d1 == 'A')
+		{
+		unsigned int l_slen = 0;
+		char *l_ptr;
+
+		if (a_d2 == 'D')
+			{
+			l_slen	= va_arg(*a_ap, unsigned int);
+			l_ptr	= va_arg(*a_ap, char *);
+
+			}
+		else if (a_d2 == 'Z')
+			{
+			l_ptr	= va_arg(*a_ap, char *);
+			l_slen	= (unsigned int) strnlen(l_ptr, a_bufsz_);
+			}
+		else if (a_d2 == 'C')
+			{
+			l_ptr	= va_arg(*a_ap, char *);
+			l_slen	= *(l_ptr++);
+			}
+		else	return	0;
+
+		if (l_slen >= (unsigned int) a_bufsz_)
+			l_slen = (unsigned int)a_bufsz_ - 1;
+
+		memcpy(outp, l_ptr, l_slen);
+
+		*a_outp	+= l_slen;
+		*a_bufsz -= l_slen;
+
+		return	2;
+		}
+
+	// Unrecognized directive
+	return	0;
+}
+
+/* A number of characters of the recognized directive, see s_fao_directive() */
+static int	s_fao_dirlen	(
+		char	a_d1,
+		char	a_d2
+			)
+{
+	if ( (a_d1 == 'U' || a_d1 == 'X' || a_d1 == 'S') && (a_d2 == 'B' || a_d2 == 'W' || a_d2 == 'L' || a_d2 == 'Q') )
+		return	2;
+
+	if ( a_d1 == 'P' )
+		return	1;
+
+	if ( (a_d1 == 'A') && (a_d2 == 'D' || a_d2 == 'Z' || a_d2 == 'C') )
+		return	2;
+
+	return	0;
+}
+
+
+static int	__util$vfao (char *a_fmt, char *a_buf, size_t a_bufsz, va_list a_ap)
+{
+int	l_rc;
+char	*outp = a_buf;
+va_list	l_ap;
+
+	va_copy(l_ap, a_ap);
+
+	for ( ; (a_bufsz && *a_fmt); )
+		{
+		if (*a_fmt != '!')
+			{
+			*outp++ = *a_fmt++;
+			a_bufsz--;
+
+			continue;
+			}
+
+		if ( !(*(++a_fmt)) )
+			break;
+
+		/* !!
+		*/
+		if (*a_fmt == '!')
+			{
+			*outp++ = *a_fmt++;
+			a_bufsz--;
+
+			continue;
+			}
+
+		if ( 0 > (l_rc = s_fao_directive(a_fmt[0], a_fmt[1], &outp, &a_bufsz, &l_ap)) )
+			break;
+
+		// Unrecognized directive here (l_rc == 0), just loop back up to the top
+		a_fmt += l_rc;
+		} /* while bufsz > 0 && *fmt != null char */
+
+	va_end(l_ap);
+
+	*outp = '\0';
+
+	return (outp - a_buf);
+}
+
+
+
+int	__util$fao (void *a_fmt, void *a_buf, size_t a_bufsz, ...)
+{
+va_list l_ap;
+int l_result;
+
+	va_start(l_ap, a_bufsz);
+	l_result = __util$vfao((char *) a_fmt, (char*) a_buf, a_bufsz, l_ap);
+	va_end(l_ap);
+
+	return l_result;
+}
+
+
+/*
+ * Compiled FAO control string: a sequence of instructions - literals (a reference to the
+ * text in the control string) and directives, so the control string is parsed only once.
+ */
+#define	UTIL$K_FAO_LIT		0			/* Literal: <len> octets at <off> of the control string	*/
+#define	UTIL$K_FAO_DIR		1			/* Directive: <d1><d2>					*/
+#define	UTIL$K_FAOC_CACHESZ	512			/* A size of the compiled programs cache, power of 2	*/
+
+typedef	struct __util_faoins__ {
+	unsigned char	op,				/* UTIL$K_FAO_* */
+			d1, d2;				/* Directive's characters */
+	unsigned short	len;				/* Length of the literal */
+	unsigned	off;				/* Offset of the literal in the control string */
+} UTIL_FAOINS;
+
+struct	__util_faopgm__ {
+	const char	*fmt;				/* Control string, is used as a key in the cache */
+	unsigned	insnr;				/* A number of instructions */
+	UTIL_FAOINS	ins[];
+};
+
+static UTIL_FAOPGM	*s_faoc_cache[UTIL$K_FAOC_CACHESZ];	/* Compiled programs, key is an address of control string */
+static int		s_faoc_lock;
+
+/*
+ *   DESCRIPTION: Compile FAO control string into the program for __util$fao_exec().
+ *	The program refers to the control string, so it must not be changed or released
+ *	while the program is used.
+ *
+ *   INPUTS:
+ *	fmt:	A FAO control string, ASCIZ
+ *
+ *   RETURNS:
+ *	An address of the program, must be released by free(), NULL - insufficient memory
+ */
+UTIL_FAOPGM	*__util$fao_compile	(
+	const char	*a_fmt
+			)
+{
+UTIL_FAOPGM	*l_pgm;
+UTIL_FAOINS	*l_ins = NULL;
+const char	*l_cp;
+int	l_len;
+
+	/* A number of instructions cannot be more than a length of the control string */
+	if ( !(l_pgm = malloc(sizeof(UTIL_FAOPGM) + (strlen(a_fmt) + 1) * sizeof(UTIL_FAOINS))) )
+		return	NULL;
+
+	l_pgm->fmt = a_fmt;
+	l_pgm->insnr = 0;
+
+	for ( l_cp = a_fmt; *l_cp; )
+		{
+		if ( *l_cp == '!' )
+			{
+			if ( !*(++l_cp) )
+				break;						/* Trailing '!' stops processing */
+
+			if ( (*l_cp != '!') && (l_len = s_fao_dirlen(l_cp[0], l_cp[1])) )
+				{
+				l_ins = &l_pgm->ins[l_pgm->insnr++];
+				l_ins->op = UTIL$K_FAO_DIR;
+				l_ins->d1 = l_cp[0];
+				l_ins->d2 = l_cp[1];
+				l_cp += l_len;
+
+				continue;
+				}
+			}
+
+		/* Literal character: a regular one, a second '!' of the "!!" or a character after unrecognized "!" */
+		if ( l_ins && (l_ins->op == UTIL$K_FAO_LIT) && ((l_ins->off + l_ins->len) == (unsigned) (l_cp - a_fmt)) && (l_ins->len < 0xffff) )
+			l_ins->len++;
+		else	{
+			l_ins = &l_pgm->ins[l_pgm->insnr++];
+			l_ins->op = UTIL$K_FAO_LIT;
+			l_ins->len = 1;
+			l_ins->off = (unsigned) (l_cp - a_fmt);
+			}
+
+		l_cp++;
+		}
+
+	return	l_pgm;
+}
+
+/*
+ *   DESCRIPTION: Format output buffer by the compiled FAO program, output is the same
+ *	as the __util$fao() produces with the same control string.
+ *
+ *   INPUTS:
+ *	pgm:	A program has been compiled by the __util$fao_compile()
+ *	buf:	An output buffer
+ *	bufsz:	A size of the output buffer
+ *	ap:	Arguments
+ *
+ *   RETURNS:
+ *	A length of the formatted string
+ */
+int	__util$vfao_exec	(
+	const UTIL_FAOPGM *a_pgm,
+		char	*a_buf,
+		size_t	a_bufsz,
+		va_list	a_ap
+			)
+{
+const UTIL_FAOINS *l_ins, *l_end = a_pgm->ins + a_pgm->insnr;
+char	*outp = a_buf;
+size_t	l_len;
+va_list	l_ap;
+
+	va_copy(l_ap, a_ap);
+
+	for ( l_ins = a_pgm->ins; a_bufsz && (l_ins < l_end); l_ins++ )
+		{
+		if ( l_ins->op == UTIL$K_FAO_LIT )
+			{
+			l_len = (l_ins->len < a_bufsz) ? l_ins->len : a_bufsz;
+			memcpy(outp, a_pgm->fmt + l_ins->off, l_len);
+
+			outp	+= l_len;
+			a_bufsz	-= l_len;
+
+			continue;
+			}
+
+		if ( 0 > s_fao_directive(l_ins->d1, l_ins->d2, &outp, &a_bufsz, &l_ap) )
+			break;
+		}
+
+	va_end(l_ap);
+
+	*outp = '\0';
+
+	return (outp - a_buf);
+}
+
+int	__util$fao_exec	(const UTIL_FAOPGM *a_pgm, char *a_buf, size_t a_bufsz, ...)
+{
+va_list l_ap;
+int l_result;
+
+	va_start(l_ap, a_bufsz);
+	l_result = __util$vfao_exec(a_pgm, a_buf, a_bufsz, l_ap);
+	va_end(l_ap);
+
+	return l_result;
+}
+
+/* Lookup the cache for compiled program by address of the control string, compile and add new one */
+static const UTIL_FAOPGM	*s_faoc_lookup	(
+	const char	*a_fmt
+			)
+{
+UTIL_FAOPGM	*l_pgm, *l_new;
+unsigned	h, i;
+
+	h = (unsigned) ((((size_t) a_fmt) * 0x9E3779B97F4A7C15ULL) >> 40) & (UTIL$K_FAOC_CACHESZ - 1);
+
+	for ( i = 0; i < UTIL$K_FAOC_CACHESZ; i++, h = (h + 1) & (UTIL$K_FAOC_CACHESZ - 1) )
+		{
+		if ( !(l_pgm = __atomic_load_n(&s_faoc_cache[h], __ATOMIC_ACQUIRE)) )
+			break;
+
+		if ( l_pgm->fmt == a_fmt )
+			return	l_pgm;
+		}
+
+	if ( (i == UTIL$K_FAOC_CACHESZ) || !(l_new = __util$fao_compile(a_fmt)) )
+		return	NULL;
+
+	$LOCK_LONG(&s_faoc_lock);
+
+	/* Recheck the slot and probe for free slot, the program can be added by other thread */
+	for ( ; i < UTIL$K_FAOC_CACHESZ; i++, h = (h + 1) & (UTIL$K_FAOC_CACHESZ - 1) )
+		{
+		if ( !(l_pgm = s_faoc_cache[h]) )
+			{
+			__atomic_store_n(&s_faoc_cache[h], l_new, __ATOMIC_RELEASE);
+			l_pgm = l_new;
+			l_new = NULL;
+			break;
+			}
+
+		if ( l_pgm->fmt == a_fmt )
+			break;
+
+		l_pgm = NULL;
+		}
+
+	$UNLOCK_LONG(&s_faoc_lock);
 
+	free(l_new);
 
-unsigned	__util$out
-			(
-		char *	fmt,
-			...
-			)
+	return	l_pgm;
+}
 
+/*
+ *   DESCRIPTION: Format output buffer by the control string is compiled at first call and
+ *	cached by the address, so the control string must be a constant. The __util$fao() is used
+ *	if the cache is full.
+ *
+ *   INPUTS:
+ *	fmt:	A FAO control string, ASCIZ, constant
+ *	buf:	An output buffer
+ *	bufsz:	A size of the output buffer
+ *	...:	Arguments
+ *
+ *   RETURNS:
+ *	A length of the formatted string
+ */
+int	__util$faoc	(const char *a_fmt, char *a_buf, size_t a_bufsz, ...)
 {
-va_list arglist;
-char	out[1024] = {0};
-int	olen = 0;
+va_list l_ap;
+int l_result;
+const UTIL_FAOPGM *l_pgm;
 
-	va_start (arglist, fmt);
-	olen += vsnprintf(out, sizeof(out) - 1, fmt, arglist);
-	va_end (arglist);
+	va_start(l_ap, a_bufsz);
 
-	/* Add <LF> at end of record*/
-	out[olen++] = '\n';
+	if ( (l_pgm = s_faoc_lookup(a_fmt)) )
+		l_result = __util$vfao_exec(l_pgm, a_buf, a_bufsz, l_ap);
+	else	l_result = __util$vfao((char *) a_fmt, a_buf, a_bufsz, l_ap);
 
-	/* Write to file and flush buffer depending on severity level */
-	if( p_cb_log_f )
-		p_cb_log_f(out, olen);
-	else	write (g_logoutput, out, olen);
+	va_end(l_ap);
 
-	return	STS$K_SUCCESS;
+	return l_result;
 }
 
 
+#ifndef	WIN32
+/* Add a segment into the I/O vector, the segment is merged with the previous one if they are adjacent */
+inline static int	s_faov_add	(
+	struct iovec	*a_iov,
+		int	*a_nr,
+		int	a_iovnr,
+	const void	*a_base,
+		size_t	a_len
+			)
+{
+struct iovec	*l_last;
 
+	if ( !a_len )
+		return	0;
 
+	if ( *a_nr )
+		{
+		l_last = &a_iov[*a_nr - 1];
 
+		if ( (char *) l_last->iov_base + l_last->iov_len == (char *) a_base )
+			{
+			l_last->iov_len += a_len;
+			return	0;
+			}
+		}
 
+	if ( *a_nr >= a_iovnr )
+		return	-1;
 
+	a_iov[*a_nr].iov_base = (void *) a_base;
+	a_iov[(*a_nr)++].iov_len = a_len;
 
-
+	return	0;
+}
 
 /*
- * stc_msg_vformat
+ *   DESCRIPTION: Format by the FAO control string into the I/O vector instead of the plain buffer,
+ *	the result can be passed to the writev()/sendmsg() as is. The !AD, !AC, !AZ arguments and
+ *	the literal parts of the control string are referenced in place without copying, the numbers
+ *	are formatted into the scratch buffer. So the control string, the arguments and the scratch
+ *	buffer must not be changed or released while the I/O vector is used.
  *
- * The core formatting routine.
- * Do NOT use sprintf-style formatting codes in
- * message strings! Use the formatting directives
- * below:
- * !A{D, Z, C}
- * !U{Q, L, W, B} = unsigned quad\int64, int32, short, byte
- * !S{Q, L, W, B} = signed quad\int64, int32, short, byte
- * !X{Q, L, W, B} = hexadecimal quad\int64, int32, short, byte
- * !P = pointer
- * !T = time (DD-MMM-YYYY HH:MM:SS)
- * !D = date (DD-MMM-YYYY)
- * !! = exclamation point
+ *   INPUTS:
+ *	fmt:	A FAO control string, ASCIZ
+ *	iov:	An I/O vector to be filled
+ *	iovnr:	A number of elements in the I/O vector
+ *	scratch: A buffer for the formatted numbers, UTIL$K_FAOV_NUMSZ octets per !U, !S, !X, !P directive
+ *	scratchsz: A size of the scratch buffer
+ *	ap:	Arguments
+ *
+ *   OUTPUTS:
+ *	[outlen]: A total length of the formatted string, optional
+ *
+ *   RETURNS:
+ *	A number of the used I/O vector elements, -1 - the I/O vector or the scratch buffer is exhausted
  */
-#ifdef	WIN32
-#define	snprintf(buf, len, format,...)	_snprintf_s(buf, len, len, format, __VA_ARGS__)
-#endif
-
-static int	__util$vfao (char *a_fmt, char *a_buf, size_t a_bufsz, va_list a_ap)
+int	__util$vfaov	(
+	const char	*a_fmt,
+	struct iovec	*a_iov,
+		int	a_iovnr,
+		char	*a_scratch,
+		size_t	a_scratchsz,
+		size_t	*a_outlen,
+		va_list	a_ap
+			)
 {
-int	l_len;
-char	l_tmpbuf[256], *outp = a_buf;
+int	l_nr = 0, l_rc = 0, l_len;
+size_t	l_slen;
+char	*outp, *l_ptr;
+va_list	l_ap;
 
-	for ( ; (a_bufsz && *a_fmt); )
+	va_copy(l_ap, a_ap);
+
+	for ( ; (l_rc >= 0) && *a_fmt; )
 		{
-		if (*a_fmt != '!')
+		if ( *a_fmt != '!' )
 			{
-			*outp++ = *a_fmt++;
-			a_bufsz--;
+			l_slen = strcspn(a_fmt, "!");				/* Literal part of the control string is referenced in place */
+			l_rc = s_faov_add(a_iov, &l_nr, a_iovnr, a_fmt, l_slen);
+			a_fmt += l_slen;
 
 			continue;
 			}
@@ -1920,138 +8026,207 @@ char	l_tmpbuf[256], *outp = a_buf;
 
 		/* !!
 		*/
-		if (*a_fmt == '!')
+		if ( *a_fmt == '!' )
 			{
-			*outp++ = *a_fmt++;
-			a_bufsz--;
+			l_rc = s_faov_add(a_iov, &l_nr, a_iovnr, a_fmt++, 1);
 
 			continue;
 			}
 
-		/* !X{L, W, B}, U{L, W, B}, S{L, W, B}, Q{L, W, B}
+		/* !AD, !AC, !AZ - reference argument in place
 		*/
-		if (*a_fmt == 'U' || *a_fmt == 'X' || *a_fmt == 'S' )
+		if ( (a_fmt[0] == 'A') && (a_fmt[1] == 'D' || a_fmt[1] == 'Z' || a_fmt[1] == 'C') )
 			{
-			uint64_t l_val = 0;
-
-			if (*(a_fmt+1) == 'B')
+			if ( a_fmt[1] == 'D' )
 				{
-				l_val = va_arg(a_ap, int);
-				l_len = snprintf(outp, a_bufsz,  ((*a_fmt == 'X') ?  "0x%02X" : (*a_fmt == 'U') ? "%3u" : "%3d"),
-					(unsigned char) l_val);
+				l_slen	= va_arg(l_ap, unsigned int);
+				l_ptr	= va_arg(l_ap, char *);
 				}
-			else if (*(a_fmt + 1) == 'W')
+			else if ( a_fmt[1] == 'Z' )
 				{
-				l_val = va_arg(a_ap, int);
-				l_len = snprintf(outp, a_bufsz,  ((*a_fmt == 'X') ?  "0x%04X" : ( *a_fmt == 'U') ? "%5u" : "%6d"),
-					(uint16_t) l_val);
+				l_ptr	= va_arg(l_ap, char *);
+				l_slen	= strlen(l_ptr);
 				}
-			else if (*(a_fmt + 1) == 'L')
-				{
-				l_val = va_arg(a_ap, uint32_t);
-				l_len = snprintf(outp, a_bufsz,  ((*a_fmt == 'X') ?  "0x%08X": ( *a_fmt == 'U') ? "%u" : "%d"),
-					( *a_fmt == 'U') ? (uint32_t) l_val : (int32_t) l_val);
-
+			else	{
+				l_ptr	= va_arg(l_ap, char *);
+				l_slen	= *((unsigned char *) l_ptr++);
 				}
-			else if (*(a_fmt + 1) == 'Q')
-				{
-				l_val = va_arg(a_ap, uint64_t);
-				l_len = snprintf(outp, a_bufsz,  ((*a_fmt == 'X') ?  "0x%016llx": ( *a_fmt == 'U') ? "%llu" : "%lld"),
-					( *a_fmt == 'U') ? (unsigned long long) l_val : (int64_t) l_val);
 
-				}
-			else	continue;
+			l_rc = s_faov_add(a_iov, &l_nr, a_iovnr, l_ptr, l_slen);
+			a_fmt += 2;
+
+			continue;
+			}
 
-			if ( l_len < 0 )
+		/* !U, !S, !X, !P - format into the scratch buffer
+		*/
+		if ( (l_len = s_fao_dirlen(a_fmt[0], a_fmt[1])) )
+			{
+			if ( a_scratchsz < UTIL$K_FAOV_NUMSZ )
+				{
+				l_rc = -1;
 				break;
+				}
 
-			if (l_len >= a_bufsz)
-				l_len = a_bufsz - 1;
+			outp = a_scratch;
 
-			outp	+= l_len;
-			a_bufsz	-= l_len;
-			a_fmt	+= 2;
+			if ( 0 > (l_rc = s_fao_directive(a_fmt[0], a_fmt[1], &outp, &a_scratchsz, &l_ap)) )
+				break;
 
-			continue;
+			l_rc = s_faov_add(a_iov, &l_nr, a_iovnr, a_scratch, outp - a_scratch);
+			a_scratch = outp;
+			a_fmt += l_len;
 			}
 
+		// Unrecognized directive here, a character after the '!' is processed as a literal
+		}
+
+	va_end(l_ap);
 
+	if ( l_rc < 0 )
+		return	-1;
 
+	if ( a_outlen )
+		for ( *a_outlen = 0, l_len = 0; l_len < l_nr; l_len++ )
+			*a_outlen += a_iov[l_len].iov_len;
 
-		/* !P
-		*/
-		if (*a_fmt == 'P')
-			{
-			if ( 0 > (l_len = snprintf(outp, a_bufsz, "@%p", va_arg(a_ap, void *))) )
-				break;
+	return	l_nr;
+}
 
-			if (l_len >= a_bufsz)
-				l_len = a_bufsz - 1;
+int	__util$faov	(const char *a_fmt, struct iovec *a_iov, int a_iovnr, char *a_scratch, size_t a_scratchsz, size_t *a_outlen, ...)
+{
+va_list l_ap;
+int l_result;
 
-			outp	+= l_len;
-			a_bufsz	-= l_len;
-			a_fmt	+= 1;
+	va_start(l_ap, a_outlen);
+	l_result = __util$vfaov(a_fmt, a_iov, a_iovnr, a_scratch, a_scratchsz, a_outlen, l_ap);
+	va_end(l_ap);
 
-			continue;
-			}
+	return l_result;
+}
 
-		/* !AD, !AC, !AZ ...	*/
-		if (*a_fmt == 'A')
-			{
-			unsigned int l_slen = 0;
-			char *l_ptr;
+/* Gather the I/O vector into the plain buffer, return a length of the data in the buffer */
+static size_t	s_iov_gather	(
+	const struct iovec *a_iov,
+		int	a_iovnr,
+		char	*a_buf,
+		size_t	a_bufsz
+			)
+{
+size_t	l_len, l_olen = 0;
 
-			if (*(a_fmt+1) == 'D')
-				{
-				l_slen	= va_arg(a_ap, unsigned int);
-				l_ptr	= va_arg(a_ap, char *);
+	for ( ; a_iovnr && (l_olen < a_bufsz); a_iov++, a_iovnr-- )
+		{
+		l_len = (a_iov->iov_len < (a_bufsz - l_olen)) ? a_iov->iov_len : a_bufsz - l_olen;
+		memcpy(a_buf + l_olen, a_iov->iov_base, l_len);
+		l_olen += l_len;
+		}
 
-				}
-			else if (*(a_fmt+1) == 'Z')
-				{
-				l_ptr	= va_arg(a_ap, char *);
-				l_slen	= (unsigned int) strnlen(l_ptr, a_bufsz);
-				}
-			else if (*(a_fmt+1) == 'C')
-				{
-				l_ptr	= va_arg(a_ap, char *);
-				l_slen	= *(l_ptr++);
-				}
-			else	continue;
+	return	l_olen;
+}
+
+/*
+ *   DESCRIPTION: Format a log record by the FAO control string and write it by the single writev()
+ *	without copying of the !AD, !AC, !AZ arguments into the output buffer, is supposed to be used
+ *	to log large payloads. The JSON mode and too many segments are processed by formatting into
+ *	the plain buffer like the __util$log() does.
+ *
+ *   INPUTS:
+ *	fac:	A facility name, ASCIZ
+ *	sev:	A severity level, STS$K_*, can be OR-ed with STS$M_SYSLOG
+ *	fmt:	A FAO control string, ASCIZ
+ *	...:	Arguments
+ *
+ *   RETURNS:
+ *	sev
+ */
+unsigned	__util$logfao	(
+	const char	*fac,
+		unsigned sev,
+	const char	*fmt,
+			...
+			)
+{
+va_list arglist;
+struct iovec l_iov[UTIL$K_LOGFAO_IOVNR];
+char	l_scratch[UTIL$SZ_OUTBUF / 2], out[UTIL$SZ_OUTBUF + 8], *cp;
+unsigned olen, l_prefix, _sev = $SEV(sev), opcom = sev & STS$M_SYSLOG;
+int	l_nr = -1;
+struct tm _tm;
+struct timespec now;
 
-			if (l_slen >= (unsigned int) a_bufsz)
-				l_slen = (unsigned int)a_bufsz - 1;
+	if ( !($ISINRANGE(sev, STS$K_WARN, STS$K_ERROR)) )
+		sev = STS$K_UNDEF;
 
-			memcpy(outp, l_ptr, l_slen);
+	s___time(&now);
+	localtime_r((time_t *)&now, &_tm);
 
-			outp	+= l_slen;
-			a_bufsz	-= l_slen;
-			a_fmt	+= 2;
+	/*
+	** Out to scratch buffer "DD-MM-YYYY HH:MM:SS.msec <tid> %<FAC>-<S>: " prefix
+	*/
+	cp = s_util_tsprefix(l_scratch, &_tm, &now);
+	*(cp++) = '%';
+	cp = s_put_str(cp, l_scratch + 64, fac);
+	*(cp++) = '-';
+	*(cp++) = severity[_sev];
+	*(cp++) = ':';
+	*(cp++) = ' ';
+
+	l_iov[0].iov_base = l_scratch;
+	l_iov[0].iov_len = cp - l_scratch;
+
+	if ( s_logmode != UTIL$K_LOGMODE_JSON )
+		{
+		va_start (arglist, fmt);
+		l_nr = __util$vfaov(fmt, l_iov + 1, $ARRSZ(l_iov) - 2, cp, sizeof(l_scratch) - (cp - l_scratch), NULL, arglist);
+		va_end (arglist);
+		}
 
-			continue;
+	if ( l_nr >= 0 )
+		{
+		/* Add <LF> at end of record and write all segments at once */
+		l_nr += 1;
+		l_iov[l_nr].iov_base = "\n";
+		l_iov[l_nr].iov_len = 1;
+		l_nr += 1;
+
+		writev(g_logoutput, l_iov, l_nr);
+
+		/* Keep a copy of the record in the flight recorder's ring */
+		olen = (unsigned) s_iov_gather(l_iov, l_nr, out, UTIL$K_FREC_RECSZ);
+		__util$frec_put(out, olen);
+
+		if ( opcom )
+			{
+			olen = (unsigned) s_iov_gather(l_iov + 1, l_nr - 2, out, UTIL$SZ_OUTBUF);
+			syslog( LOG_PID | ((sev & 1) ? LOG_INFO : LOG_ERR), "%.*s", olen, out);
 			}
 
-		// Unrecognized directive here, just loop back up to the top
-		} /* while bufsz > 0 && *fmt != null char */
+		return	sev;
+		}
 
-	*outp = '\0';
+	/* Fallback to the plain buffer */
+	olen = l_prefix = (s_logmode == UTIL$K_LOGMODE_JSON) ? 0 : (unsigned) l_iov[0].iov_len;
+	memcpy(out, l_scratch, olen);
 
-	return (outp - a_buf);
-}
+	va_start (arglist, fmt);
+	olen += __util$vfao((char *) fmt, out + olen, UTIL$SZ_OUTBUF - olen, arglist);
+	va_end (arglist);
 
+	if ( opcom )
+		syslog( LOG_PID | ((sev & 1) ? LOG_INFO : LOG_ERR), "%.*s", olen - l_prefix, out + l_prefix);
 
+	if ( s_logmode == UTIL$K_LOGMODE_JSON )				/* Convert the record to the JSON object */
+		olen = s_util_jsonrec(out, UTIL$SZ_OUTBUF, olen, &now, fac, _sev, 0, NULL, NULL, 0);
 
-int	__util$fao (void *a_fmt, void *a_buf, size_t a_bufsz, ...)
-{
-va_list l_ap;
-int l_result;
+	out[olen++] = '\n';
 
-	va_start(l_ap, a_bufsz);
-	l_result = __util$vfao((char *) a_fmt, (char*) a_buf, a_bufsz, l_ap);
-	va_end(l_ap);
+	__util$frec_put(out, olen);
+	write (g_logoutput, out, olen);
 
-	return l_result;
+	return	sev;
 }
+#endif	/* !WIN32 */
 
 
 
@@ -2064,14 +8239,16 @@ int l_result;
  * SYS_NUMTIM)
  *
  * The following FAO directives are supported:
- *     !Sx !Ux !Zx !Ox !%S !%D !%T !AS !AZ !AC !AD !AF !n*c
+ *     !Sx !Ux !Zx !Ox !Xx (x = B, W, L) !%S !%D !%T !AS !AZ !AC !AD !AF !n*c !/ !_ !^ !!
  *
- * Times are represented as pointers to time_t values rather than
- * pointers to VMS time structures.
+ * Times are represented as pointers to struct timespec values rather than
+ * pointers to VMS time structures, NULL - current time.
  *
  * Revised:	1-NOV-1995		Fix bug in !XL processing.
  * Revised:	3-JAN-1995		Fix bug in NUMTIM emulation (month #).
  * Revised:	15-FEB-2024	RRL	Reorganizing code to be more readable, removed SYS_NUMTIM.
+ * Revised:	19-OCT-2026	RRL	Completed !%D, !%T with per-second cache of the time text, added !UL, !XL ...,
+ *					bulk appends and memset() padding instead of character by character output.
  */
 
 
@@ -2085,15 +8262,10 @@ typedef struct tm tm_t;
 #define STS$K_SUCCESS 1
 #define SS$_BADPARAM 20
 
-#define MIN_INT 0x80000000
-#define MIN_INT_STR "-2147483648"
-#define MIN_INT_STR_L 11
-
 #define LONG unsigned long
 #define APPEND_C(c) if (j<ctx->outsize) ctx->out[j++]=c; else \
 	{ ctx->outused=j; return SS$_BUFFEROVF; }
 
-typedef struct { unsigned short l; char *a; } decsriptor_s;
 typedef struct ctl_buf_t {
     char *out;				/* Output buffer */
     LONG *prmlst;			/* Parameter list */
@@ -2105,52 +8277,127 @@ typedef struct ctl_buf_t {
     int value;				/* last value formatted for !%s */
 } CTL$_BUF;
 
+/* A text of the time is formatted once per second, is reused by the next !%D, !%T in the same second */
+typedef struct faol_tcache_t {
+	time_t	sec;
+	char	text[24];		/* "DD-MMM-YYYY HH:MM:SS" */
+} FAOL_TCACHE;
+
+#define	FAOL$K_DATELEN	20		/* A length of the "DD-MMM-YYYY HH:MM:SS"	*/
+#define	FAOL$K_TIMELEN	8		/* A length of the "HH:MM:SS"			*/
+
+static const char s_faol_months [12][4] = {"JAN", "FEB", "MAR", "APR", "MAY", "JUN", "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
+
+#ifdef	WIN32
+static __declspec(thread) FAOL_TCACHE s_faol_tcache = {-1, {0}};
+#else
+static __thread FAOL_TCACHE s_faol_tcache = {-1, {0}};
+#endif
+
 static int s_output_directive ( int d1, int d2, CTL$_BUF *ctx );
 static int s_fmt_signed ( int value, CTL$_BUF *ctx );
 static int s_fmt_unsigned ( LONG value, int base, char fill, CTL$_BUF *ctx );
 static int s_fmt_pad ( char fill, int cur, CTL$_BUF *ctx );
 
 /************************************************************************/
+/* Append a bulk of characters at the given position, the output is truncated at end of buffer.
+ */
+inline static int s_faol_append ( CTL$_BUF *ctx, int *a_pos, const char *a_src, int a_len )
+{
+int	l_room = ctx->outsize - *a_pos;
+
+	if ( a_len > l_room )
+		{
+		memcpy(ctx->out + *a_pos, a_src, l_room);
+		ctx->outused = ctx->outsize;
+
+		return	SS$_BUFFEROVF;
+		}
+
+	memcpy(ctx->out + *a_pos, a_src, a_len);
+	*a_pos += a_len;
+
+	return	STS$K_SUCCESS;
+}
+
+/************************************************************************/
+/* !%D - "DD-MMM-YYYY HH:MM:SS.cc", !%T - "HH:MM:SS.cc"
+ */
 static int s_fmt_time (
 			int	date_flag,
 		struct timespec	*a_now,
-		CTL$_BUF	*ctx
+		CTL$_BUF	*ctx,
+			int	*a_pos
 			)
 {
-int	i, j;
-char	*out, buf[32];
-tm_t	*local_time;
+int	l_len;
+char	*cp, buf[32];
 struct tm l_tm;
 struct timespec l_now;
+FAOL_TCACHE *l_tc = &s_faol_tcache;
 
 	if ( !a_now )
 		s___time(&l_now);
 	else	l_now = *a_now;
 
+	if ( l_tc->sec != l_now.tv_sec )
+		{
 #ifdef	WIN32
-	localtime_s(&_tm, (time_t *)&now);
+		localtime_s(&l_tm, (time_t *)&l_now);
 #else
-	localtime_r((time_t *)&l_now, &l_tm);
+		localtime_r((time_t *)&l_now, &l_tm);
 #endif
+		cp = s_put_udec(l_tc->text, l_tm.tm_mday, 2, '0');
+		*(cp++) = '-';
+		memcpy(cp, s_faol_months[l_tm.tm_mon % 12], 3);
+		cp += 3;
+		*(cp++) = '-';
+		cp = s_put_udec(cp, 1900 + l_tm.tm_year, 4, '0');
+		*(cp++) = ' ';
+		cp = s_put_udec(cp, l_tm.tm_hour, 2, '0');
+		*(cp++) = ':';
+		cp = s_put_udec(cp, l_tm.tm_min, 2, '0');
+		*(cp++) = ':';
+		s_put_udec(cp, l_tm.tm_sec, 2, '0');
+
+		l_tc->sec = l_now.tv_sec;
+		}
 
+	l_len = date_flag ? FAOL$K_DATELEN : FAOL$K_TIMELEN;
+	memcpy(buf, l_tc->text + FAOL$K_DATELEN - l_len, l_len);
 
+	buf[l_len++] = '.';
+	memcpy(buf + l_len, __util$dec2lut + ((l_now.tv_nsec / 10000000) % 100) * 2, 2);
+	l_len += 2;
 
-
-
-	return	ctx->outused = j, STS$K_SUCCESS;
+	return	s_faol_append(ctx, a_pos, buf, l_len);
 }
 
 
 
 
+/*
+ *   DESCRIPTION: Format output buffer by the VMS SYS$FAOL-like control string and list of parameters.
+ *
+ *   INPUTS:
+ *	ctlstr:	A descriptor of the control string
+ *	outbuf:	A descriptor of the output buffer
+ *	prmlst:	An array of parameters, every one is an unsigned long: value, address of the string ...
+ *
+ *   OUTPUTS:
+ *	outlen:	A length of the formatted string
+ *
+ *   RETURNS:
+ *	STS$K_SUCCESS, SS$_BUFFEROVF - output is truncated, SS$_BADPARAM + <n> - malformed control string
+ */
 int	__util$faol (
-	const decsriptor_s	*a_ctlstr,
+	const UTIL_DSC	*a_ctlstr,
 			int	*a_outlen,
-		decsriptor_s	*a_outbuf,
+		UTIL_DSC	*a_outbuf,
 			LONG	*a_prmlst
 		)
 {
-char	*l_ctl, *l_out;
+char	*l_ctl, *l_out, *l_cp;
 CTL$_BUF l_ctx;
 int	i, j, k, l_len, l_outsize, l_repcnt, l_rc;
 char	l_d1, l_d2;
@@ -2173,16 +8420,23 @@ char	l_d1, l_d2;
 		/*
 		 * Copy characters until a directive encountered.
 		 */
-		while ( l_ctl[i] != '!' )
+		if ( l_ctl[i] != '!' )
 			{
-			if ( j < l_outsize )
-				{
-				l_out[j++] = l_ctl[i++];
+			l_cp = memchr(l_ctl + i, '!', l_len - i);
+			k = l_cp ? (int) (l_cp - (l_ctl + i)) : l_len - i;
 
-				if ( i >= l_len )
-					return *a_outlen = j, STS$K_SUCCESS;		/* All done */
+			if ( k > (l_outsize - j) )
+				{
+				memcpy(l_out + j, l_ctl + i, l_outsize - j);
+				return	*a_outlen = l_outsize, SS$_BUFFEROVF;		/* Output buffer full */
 				}
-			else	return	*a_outlen = l_outsize, SS$_BUFFEROVF;		/* Output buffer full */
+
+			memcpy(l_out + j, l_ctl + i, k);
+			j += k;
+			i += k;
+
+			if ( i >= l_len )
+				return *a_outlen = j, STS$K_SUCCESS;			/* All done */
 			}
 
 
@@ -2274,7 +8528,6 @@ static int s_output_directive ( int d1, int d2, CTL$_BUF *ctx )
 {
 int	j, value, l_rc;
 LONG	uvalue;
-char	*out;
 
 	j = ctx->outused;
 	ctx->ctloffset = 1;
@@ -2289,10 +8542,8 @@ char	*out;
 
 			if ( d2 == 'Z' )
 				{
-				for ( src = (char *) *ctx->prmlst++; *src; src++ )
-					{APPEND_C ( *src );}
-				break;
-
+				src = (char *) *ctx->prmlst++;
+				srclen = (int) strnlen(src, ctx->outsize - j + 1);
 				}
 			else if ( d2 == 'D' )
 				{
@@ -2306,36 +8557,33 @@ char	*out;
 				}
 			else if ( d2 == 'S' )
 				{
-				decsriptor_s *desc = (decsriptor_s *) *ctx->prmlst++;
+				UTIL_DSC *desc = (UTIL_DSC *) *ctx->prmlst++;
 				srclen = desc->l; src = desc->a;
 				}
 			else if ( d2 == 'F' )
 				{
+				int	l_len;
+
 				srclen = *ctx->prmlst++;
+				src = (char *) *ctx->prmlst++;
 
-				for ( src = (char *) *ctx->prmlst++; srclen > 0; srclen-- )
-					{
-					if ( isprint(*src) )
-						{ APPEND_C(*src); }
-					else	{ APPEND_C('.'); }
+				/* Non-printable characters are replaced by '.' */
+				l_len = (srclen < (ctx->outsize - j)) ? srclen : ctx->outsize - j;
 
-					src++;
-					}
+				for ( l_rc = 0; l_rc < l_len; l_rc++ )
+					ctx->out[j + l_rc] = isprint((unsigned char) src[l_rc]) ? src[l_rc] : '.';
 
-				break;
+				j += l_len;
 
+				if ( l_len < srclen )
+					return	ctx->outused = j, SS$_BUFFEROVF;
+
+				break;
 				}
 			else	return SS$_BADPARAM + 8;
 
-			if ( srclen > (ctx->outsize-j) )
-				{
-				for ( ; srclen > 0; srclen-- )
-					{ APPEND_C(*src); (void) *src++; }
-				}
-			else	{
-				for ( out = ctx->out; srclen > 0; srclen-- )
-					out[j++] = *src++;
-				}
+			if ( 1 != (l_rc = s_faol_append(ctx, &j, src, srclen)) )
+				return	l_rc;
 			}
 
 			break;
@@ -2386,6 +8634,8 @@ char	*out;
 				uvalue = (uvalue & 255);
 			else if ( d2 == 'W' )
 				uvalue = (uvalue & 0x0ffff);
+			else if ( d2 == 'L' )
+				uvalue = (uvalue & 0xffffffffUL);
 			else	return SS$_BADPARAM + 12;
 
 			ctx->value = (uvalue == 1) ? 1 : 0;
@@ -2416,7 +8666,10 @@ char	*out;
 		case '%':	/* system call, date-time */
 			{
 			if ( d2 == 'D' || d2 == 'T' )
-				return	l_rc = s_fmt_time ( (d2=='D') ? 1 : 0, (struct timespec *) *ctx->prmlst++, ctx );
+				{
+				if ( 1 != (l_rc = s_fmt_time ( (d2=='D') ? 1 : 0, (struct timespec *) *ctx->prmlst++, ctx, &j )) )
+					return	l_rc;
+				}
 			else if ( d2 == 'S' )
 				{
 				if ( (j > 0) && (ctx->value != 1) )
@@ -2447,8 +8700,7 @@ char	*out;
 /************************************************************************/
 static int s_fmt_pad ( char fill, int cur, CTL$_BUF *ctx )
 {
-char * out;
-int j, limit;
+int limit;
 
 	if ( cur >= 0 )
 		{
@@ -2469,11 +8721,10 @@ int j, limit;
 
 	if ( limit <= ctx->outsize )
 		{
-		out = ctx->out;
 		ctx->outused = limit;
 
-		for ( j = cur; j < limit; )
-			out[j++] = fill;
+		if ( limit > cur )
+			memset(ctx->out + cur, fill, limit - cur);
 
 		return STS$K_SUCCESS;
 		}
@@ -2481,169 +8732,74 @@ int j, limit;
 
 	ctx->outused = ctx->outsize;
 
-	for ( j = cur; j < ctx->outused; )
-		out[j++] = fill;
-
-	return SS$_BUFFEROVF;
-
-}
-
-/************************************************************************/
-static int s_fmt_signed ( int value, CTL$_BUF *ctx )
-{
-int	j, length, status, negative, digit_stack[12];
-
-	/*
-	* Test for zero case (algorithm below results in null string on zero).
-	* If not zero, normalize negative number (should test for MIN_INT).
-	*/
-	j = ctx->outused;
-
-	if ( !value )
-		{
-		if ( ctx->width_type )
-			{
-			status = s_fmt_pad ( ' ', -1, ctx );
-
-			if ( status != 1 )
-				return status;
-
-			j = ctx->outused;
-
-			if ( ctx->width_type == -1 )
-				return STS$K_SUCCESS;
-			}
-
-		APPEND_C ( '0' );
-		return	ctx->outused = j, STS$K_SUCCESS;
-		}
-	else if ( value < 0 )
-		{
-		/* In 2's complement format, the negative of the min. integer can
-		* not be represented in the same number of bits, check for that case.
-		*/
-		if ( value == MIN_INT )
-			{
-			char *str;
-
-			if ( ctx->width_type )
-				{
-				if ( 1 != (status = s_fmt_pad ( ' ', -MIN_INT_STR_L, ctx )) )
-					return status;
-
-				if ( ctx->width_type == -1 )
-					return STS$K_SUCCESS;
-
-				j = ctx->outused;
-				}
-
-			for ( str = MIN_INT_STR; *str; str++ )
-				{APPEND_C ( *str );}
-
-			return	ctx->outused = j, STS$K_SUCCESS;
-			}
+	if ( ctx->outsize > cur )
+		memset(ctx->out + cur, fill, ctx->outsize - cur);
 
-		negative = 1;
-		value = -value;
-		}
-	else	negative = 0;
+	return SS$_BUFFEROVF;
 
+}
 
-	/*
-	*  Build stack of successively higher order digits.
-	*/
-	for (length = 0; value > 0; value = value / 10)
-		digit_stack[length++] = value;
+/************************************************************************/
+/* Output digits, right justified in the field if the width has been specified.
+ */
+static int s_fmt_digits ( const char *src, int len, char fill, CTL$_BUF *ctx )
+{
+int j, status;
 
 	if ( ctx->width_type )
 		{
-		if ( 1 != (status = s_fmt_pad ( ' ', -(length+negative), ctx )) )
+		if ( 1 != (status = s_fmt_pad ( fill, -len, ctx )) )
 			return status;
 
 		if ( ctx->width_type == -1 )
 			return STS$K_SUCCESS;
-
-		j = ctx->outused;
 		}
 
-	/*
-	* pop stack and make lowest digit an ascii char in output buffer.
-	*/
-	if ( negative )
-		{APPEND_C('-');}
+	j = ctx->outused;
 
-	for ( digit_stack[length] = 0; length > 0; length-- )
-		{APPEND_C( (char) ((digit_stack[length - 1] - (digit_stack[length] * 10)) + 48) );}
+	if ( 1 != (status = s_faol_append(ctx, &j, src, len)) )
+		return status;
 
 	return	ctx->outused = j, STS$K_SUCCESS;
 }
+
 /************************************************************************/
-static int s_fmt_unsigned ( LONG value, int base, char fill, CTL$_BUF *ctx )
+static int s_fmt_signed ( int value, CTL$_BUF *ctx )
 {
-int j, status, digit_stack[12], length;
-const char *ascdigit = "0123456789ABCDEF";
+char	buf[16], *end = buf + sizeof(buf);
+int	length;
 
 	/*
-	* Test for zero case (algorithm below results in null string on zero).
+	* Negation in the unsigned is correct for the minimal integer too
 	*/
-	j = ctx->outused;
-
-	if ( !value )
-		{
-		if ( ctx->width_type )
-			{
-			if ( 1 != (status = s_fmt_pad ( fill, -1, ctx )) )
-				return status;
-
-			if ( ctx->width_type == -1 )
-				return STS$K_SUCCESS;
-
-			j = ctx->outused;
-			}
-
-		APPEND_C ( '0' );
-		ctx->outused = j;
-		return 1;
-		}
-
-	/*
-	*  Build stack of successively higher order digits.
-	*/
-	for (length=0; value > 0; value = value/base)
-		digit_stack[length++] = value;
-
-	if ( ctx->width_type )
-		{
-		if ( 1 != (status = s_fmt_pad ( fill, -(length), ctx )) )
-			return status;
+	length = __util$u64_2_decrev((value < 0) ? 0U - (unsigned) value : (unsigned) value, end);
 
-		if ( ctx->width_type == -1 )
-			return STS$K_SUCCESS;
-
-		j = ctx->outused;
-		}
+	if ( value < 0 )
+		*(end - (++length)) = '-';
 
+	return	s_fmt_digits(end - length, length, ' ', ctx);
+}
+/************************************************************************/
+static int s_fmt_unsigned ( LONG value, int base, char fill, CTL$_BUF *ctx )
+{
+char	buf[32], *end = buf + sizeof(buf), *cp = end;
+const char *ascdigit = "0123456789ABCDEF";
 
-	/*
-	* pop stack and make lowest digit an ascii char in output buffer.
-	*/
-	for ( digit_stack[length] = 0; length > 0; length-- )
-		{
-		int l_num = digit_stack[length - 1] -(digit_stack[length] * base);
-
-		APPEND_C ( ascdigit[l_num] );
-		/* APPEND_C( (char)
-		((digit_stack[length-1]-(digit_stack[length]*base)) + 48) ); */
+	if ( base == 10 )
+		cp -= __util$u64_2_decrev(value, end);
+	else	{
+		do	{
+			*(--cp) = ascdigit[value % base];
+			} while ( value /= base );
 		}
 
-	return	ctx->outused = j, STS$K_SUCCESS;
+	return	s_fmt_digits(cp, (int) (end - cp), fill, ctx);
 }
 
 
 
 
 
-
 #if __util_DEBUG__
 
 int	main (int argc, char *argv[])
@@ -2851,10 +9007,797 @@ char	buf[1024];
 
 #ifdef	__MAIN_FOR_DEBUG__
 
+/* Elapsed time in nanoseconds since the given moment */
+static unsigned long long	s_bench_elapsed	(
+		struct timespec	*a_start
+			)
+{
+struct timespec	l_now;
+
+	clock_gettime(CLOCK_MONOTONIC, &l_now);
+
+	return	(l_now.tv_sec - a_start->tv_sec) * 1000000000ULL + l_now.tv_nsec - a_start->tv_nsec;
+}
+
+/* Compare the table-driven integer formatting kernels against the snprintf() */
+static void	s_bench_fmt	(
+		int	a_count
+			)
+{
+char	l_buf[64];
+struct timespec	l_start;
+unsigned long long l_val = 0x9E3779B97F4A7C15ULL, l_sum = 0, l_ns;
+int	i;
+
+	a_count = a_count ? a_count : 10000000;
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( i = 0; i < a_count; i++, l_val = l_val * 6364136223846793005ULL + 1442695040888963407ULL)
+		l_sum += snprintf(l_buf, sizeof(l_buf), "%llu", l_val >> (i & 63));
+	l_ns = s_bench_elapsed(&l_start);
+	printf("snprintf(\"%%llu\")       : %d calls, %llu ns/call (%llu)\n", a_count, l_ns / a_count, l_sum);
+
+	l_sum = 0;
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( i = 0; i < a_count; i++, l_val = l_val * 6364136223846793005ULL + 1442695040888963407ULL)
+		l_sum += __util$uint64_2_dec(l_val >> (i & 63), l_buf, sizeof(l_buf), NULL);
+	l_ns = s_bench_elapsed(&l_start);
+	printf("__util$uint64_2_dec()    : %d calls, %llu ns/call (%llu)\n", a_count, l_ns / a_count, l_sum);
+
+	l_sum = 0;
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( i = 0; i < a_count; i++, l_val = l_val * 6364136223846793005ULL + 1442695040888963407ULL)
+		l_sum += snprintf(l_buf, sizeof(l_buf), "%u 0x%08X %6d", (unsigned) l_val, (unsigned) (l_val >> 32), (uint16_t) l_val);
+	l_ns = s_bench_elapsed(&l_start);
+	printf("snprintf(\"%%u 0x%%08X %%6d\") : %d calls, %llu ns/call (%llu)\n", a_count, l_ns / a_count, l_sum);
+
+	l_sum = 0;
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( i = 0; i < a_count; i++, l_val = l_val * 6364136223846793005ULL + 1442695040888963407ULL)
+		l_sum += __util$fao("!UL !XL !SW", l_buf, sizeof(l_buf), (unsigned) l_val, (unsigned) (l_val >> 32), (int) (uint16_t) l_val);
+	l_ns = s_bench_elapsed(&l_start);
+	printf("__util$fao(\"!UL !XL !SW\") : %d calls, %llu ns/call (%llu)\n", a_count, l_ns / a_count, l_sum);
+}
+
+/* Check the __util$faol() output against the snprintf()/strftime() and compare a performance */
+static void	s_bench_faol	(
+		int	a_count
+			)
+{
+char	l_buf[128], l_ref[128], l_mon[8];
+UTIL_DSC l_ctl, l_out = {sizeof(l_buf), l_buf};
+struct timespec	l_start, l_ts;
+struct tm l_tm;
+unsigned long l_prm[10];
+unsigned long long l_val = 0x9E3779B97F4A7C15ULL, l_ns;
+int	i, j, l_len, l_rlen, l_bad = 0;
+
+	a_count = a_count ? a_count : 10000000;
+
+	/* Numeric directives */
+	l_ctl.a = "!UL|!SL|!XL|!ZL|!12UL|!12SL|!8XL|!4ZW|!5*-|!10AZ|";
+	l_ctl.l = (unsigned short) strlen(l_ctl.a);
+
+	for ( i = 0; i < 100000; i++, l_val = l_val * 6364136223846793005ULL + 1442695040888963407ULL)
+		{
+		unsigned l_u = (unsigned) (l_val >> (i & 31));
+
+		for ( j = 0; j < 7; j++ )
+			l_prm[j] = l_u;
+		l_prm[7] = l_u % 10000;
+		l_prm[8] = (unsigned long) "faol";
+
+		__util$faol(&l_ctl, &l_len, &l_out, l_prm);
+		l_rlen = snprintf(l_ref, sizeof(l_ref), "%u|%d|%X|%u|%12u|%12d|%08X|%04u|-----|%-10s|",
+			l_u, (int) l_u, l_u, l_u, l_u, (int) l_u, l_u, l_u % 10000, "faol");
+
+		if ( (l_len != l_rlen) || memcmp(l_buf, l_ref, l_len) )
+			{
+			if ( !l_bad++ )
+				printf("__util$faol() : '%.*s'\nsnprintf()    : '%.*s'\n", l_len, l_buf, l_rlen, l_ref);
+			}
+		}
+
+	/* Time directive */
+	l_ctl.a = "!%D";
+	l_ctl.l = 3;
+
+	for ( i = 0, l_ts.tv_sec = 1700000000; i < 100000; i++, l_ts.tv_sec += 7919 )
+		{
+		l_ts.tv_nsec = (i * 10000000L) % 1000000000L;
+		l_prm[0] = (unsigned long) &l_ts;
+
+		__util$faol(&l_ctl, &l_len, &l_out, l_prm);
+
+		localtime_r(&l_ts.tv_sec, &l_tm);
+		strftime(l_mon, sizeof(l_mon), "%b", &l_tm);
+		for ( j = 0; l_mon[j]; j++ )
+			l_mon[j] = toupper(l_mon[j]);
+
+		l_rlen = snprintf(l_ref, sizeof(l_ref), "%02d-%s-%04d %02d:%02d:%02d.%02ld", l_tm.tm_mday, l_mon, 1900 + l_tm.tm_year,
+			l_tm.tm_hour, l_tm.tm_min, l_tm.tm_sec, l_ts.tv_nsec / 10000000);
+
+		if ( (l_len != l_rlen) || memcmp(l_buf, l_ref, l_len) )
+			{
+			if ( !l_bad++ )
+				printf("__util$faol() : '%.*s'\nreference     : '%.*s'\n", l_len, l_buf, l_rlen, l_ref);
+			}
+		}
+
+	printf("__util$faol() check      : %d mismatches\n", l_bad);
+
+	l_prm[0] = 0;
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( i = 0; i < a_count; i++ )
+		{
+		s___time(&l_ts);
+		localtime_r(&l_ts.tv_sec, &l_tm);
+		strftime(l_mon, sizeof(l_mon), "%b", &l_tm);
+		snprintf(l_ref, sizeof(l_ref), "%02d-%s-%04d %02d:%02d:%02d.%02ld", l_tm.tm_mday, l_mon, 1900 + l_tm.tm_year,
+			l_tm.tm_hour, l_tm.tm_min, l_tm.tm_sec, l_ts.tv_nsec / 10000000);
+		}
+	l_ns = s_bench_elapsed(&l_start);
+	printf("localtime_r()+snprintf() : %d calls, %llu ns/call\n", a_count, l_ns / a_count);
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( i = 0; i < a_count; i++ )
+		__util$faol(&l_ctl, &l_len, &l_out, l_prm);
+	l_ns = s_bench_elapsed(&l_start);
+	printf("__util$faol(\"!%%D\")      : %d calls, %llu ns/call\n", a_count, l_ns / a_count);
+
+	l_ctl.a = "Session !AZ: tx=!UL rx=!UL err=!UW !20*=";
+	l_ctl.l = (unsigned short) strlen(l_ctl.a);
+	l_prm[0] = (unsigned long) "sess";
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( i = 0; i < a_count; i++ )
+		snprintf(l_ref, sizeof(l_ref), "Session %s: tx=%u rx=%u err=%u %s", "sess", i, i * 3, i & 0xffff, "====================");
+	l_ns = s_bench_elapsed(&l_start);
+	printf("snprintf() message       : %d calls, %llu ns/call\n", a_count, l_ns / a_count);
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( i = 0; i < a_count; i++ )
+		{
+		l_prm[1] = i;
+		l_prm[2] = i * 3;
+		l_prm[3] = i & 0xffff;
+		__util$faol(&l_ctl, &l_len, &l_out, l_prm);
+		}
+	l_ns = s_bench_elapsed(&l_start);
+	printf("__util$faol() message    : %d calls, %llu ns/call\n", a_count, l_ns / a_count);
+}
+
+/* Compare the versions of the __util$strstr() on the corpus of HTTP headers and log lines */
+static void	s_bench_strstr	(
+		int	a_count
+			)
+{
+static const char *l_lines [] = {
+	"GET /api/v1/sessions?limit=100 HTTP/1.1\r\n", "Host: gateway.example.com\r\n",
+	"Accept: application/json, text/plain, */*\r\n", "Accept-Encoding: gzip, deflate, br\r\n",
+	"Connection: keep-alive\r\n", "User-Agent: Mozilla/5.0 (X11; Linux x86_64)\r\n",
+	"19-10-2026 05:31:16.700   8438 [UTIL$\\__util$showparams:1462] %UTILS-I:  trace = OFF\n",
+	"19-10-2026 05:31:16.701   8438 [AVPROTO\\avproto_encode:212] %AVPROTO-W:  attribute is too long\n",
+	};
+static const char *l_needles [] = {		/* Rare and frequent first characters, the "<CR><LF><CR><LF>" */
+	"X-Request-Id: 7f3a", " trace = ON", "e: gzip, zstd", "\r\n\r\n", "%UTILS-E:", ": ", "e"};
+static const struct {
+	const char	*name;
+	UTIL_STRSTR_FN	fn;
+	} l_impls [] = {
+	{"scalar", s_strstr_scalar},
+#ifdef	__SSE2__
+	{"sse2", s_strstr_sse2},
+#endif
+#if	defined(__GNUC__) && defined(__x86_64__)
+	{"avx2", s_strstr_avx2},
+#endif
+	{"__util$strstr", __util$strstr},
+	};
+char	*l_corpus, *l_res = NULL;
+size_t	l_len = 0, l_corpusz = 64 * 1024;
+struct timespec	l_start;
+unsigned long long l_ns;
+int	i, j, k;
+
+	if ( !(l_corpus = malloc(l_corpusz)) )
+		return;
+
+	for ( i = 0; (l_len + 128) < l_corpusz; i++ )
+		{
+		j = (int) strlen(l_lines[i % $ARRSZ(l_lines)]);
+		memcpy(l_corpus + l_len, l_lines[i % $ARRSZ(l_lines)], j);
+		l_len += j;
+		}
+
+	memcpy(l_corpus + l_len, "X-Request-Id: 7f3a\r\n\r\n", 22);
+	l_len += 22;
+
+	a_count = a_count ? (a_count / 10000) + 1 : 1000;
+
+	for ( k = 0; k < (int) $ARRSZ(l_needles); k++ )
+		for ( j = 0; j < (int) $ARRSZ(l_impls); j++ )
+			{
+			if ( !(__builtin_cpu_supports("avx2")) && !strcmp(l_impls[j].name, "avx2") )
+				continue;
+
+			clock_gettime(CLOCK_MONOTONIC, &l_start);
+
+			for ( i = 0; i < a_count; i++ )
+				l_res = l_impls[j].fn(l_corpus, l_len, (char *) l_needles[k], strlen(l_needles[k]));
+
+			l_ns = s_bench_elapsed(&l_start);
+
+			printf("strstr(#%d) %-14s: %zu octets, %llu ns/call, %llu MB/s, found at %lld\n", k, l_impls[j].name, l_len,
+				l_ns / a_count, l_ns ? (1000ULL * l_len * a_count) / l_ns : 0, l_res ? (long long) (l_res - l_corpus) : -1LL);
+			}
+
+	/* A set of the keywords: __util$strstr() for every one against the single pass by the __util$mpm_scan() */
+	{
+	static const char *l_kwds [] = {"Host:", "Accept", "Cookie:", "Authorization:", "X-Forwarded-For:", "Content-Length:",
+		"Content-Type:", "keep-alive", "gzip", "%UTILS-E", "%UTILS-F", "%AVPROTO-E", "too long", "Mozilla", "curl/",
+		"Transfer-Encoding:", "chunked", "Upgrade:", "websocket", "Referer:", "Origin:", "DELETE ", "PUT ", "POST ",
+		"PATCH ", "OPTIONS ", "/admin", "/etc/passwd", "../", "<script", "SELECT ", "UNION ", "DROP TABLE", "password",
+		"token=", "session=", "X-Api-Key:", "Range:", "If-None-Match:", "Cache-Control:", "Pragma:", "ETag:", "Server:",
+		"Set-Cookie:", "Location:", "Expect:", "100-continue", "Via:", "Forwarded:", "X-Request-Id:"};
+	ASC	l_pats[$ARRSZ(l_kwds)];
+	UTIL_MPM *l_mpm;
+	int	l_nr = 0;
+
+	for ( k = 0; k < (int) $ARRSZ(l_kwds); k++ )
+		__util$str2asc(l_kwds[k], &l_pats[k]);
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( i = 0; i < a_count; i++ )
+		for ( l_nr = k = 0; k < (int) $ARRSZ(l_kwds); k++ )
+			for ( l_res = l_corpus; (l_res = __util$strstr(l_res, l_len - (l_res - l_corpus), l_pats[k].sts, l_pats[k].len)); l_res++ )
+				l_nr++;
+	l_ns = s_bench_elapsed(&l_start);
+	printf("%d keywords by __util$strstr() : %llu ns/call, %d matches\n", (int) $ARRSZ(l_kwds), l_ns / a_count, l_nr);
+
+	if ( (l_mpm = __util$mpm_compile(l_pats, $ARRSZ(l_pats), 0)) )
+		{
+		clock_gettime(CLOCK_MONOTONIC, &l_start);
+		for ( i = 0; i < a_count; i++ )
+			l_nr = __util$mpm_scan(l_mpm, l_corpus, l_len, NULL, NULL);
+		l_ns = s_bench_elapsed(&l_start);
+		printf("%d keywords by __util$mpm_scan() : %llu ns/call, %d matches\n", (int) $ARRSZ(l_kwds), l_ns / a_count, l_nr);
+
+		__util$mpm_free(l_mpm);
+		}
+	}
+
+	free(l_corpus);
+}
+
+/* Wildcard matching: __util$pattern_match() against compiled patterns, the pathological patterns */
+static void	s_bench_wild	(
+		int	a_count
+			)
+{
+static const struct {
+	const char	*str, *pattern;
+	} l_cases [] = {
+	{"ch33---0010904935.torrent", "*.torrent"},
+	{"AVPROTO\\avproto_encode", "AVPROTO\\*encode"},
+	{"UTIL$\\__util$showparams", "*$\\__util$%%%%params"},
+	{"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", "*a*a*a*a*a*a*a*a*b"},
+	};
+struct timespec	l_start;
+unsigned long long l_ns;
+UTIL_WILD *l_wild;
+int	i, k, l_rc = 0;
+size_t	l_len;
+
+	a_count = a_count ? a_count : 1000000;
+
+	for ( k = 0; k < (int) $ARRSZ(l_cases); k++ )
+		{
+		clock_gettime(CLOCK_MONOTONIC, &l_start);
+		for ( i = 0; i < a_count; i++ )
+			l_rc = __util$pattern_match((char *) l_cases[k].str, (char *) l_cases[k].pattern);
+		l_ns = s_bench_elapsed(&l_start);
+		printf("__util$pattern_match(\"%s\") : %llu ns/call, %s\n", l_cases[k].pattern, l_ns / a_count, l_rc ? "match" : "no match");
+
+		if ( !(l_wild = __util$wild_compile(l_cases[k].pattern)) )
+			continue;
+
+		l_len = strlen(l_cases[k].str);
+
+		clock_gettime(CLOCK_MONOTONIC, &l_start);
+		for ( i = 0; i < a_count; i++ )
+			l_rc = __util$wild_match(l_wild, l_cases[k].str, l_len);
+		l_ns = s_bench_elapsed(&l_start);
+		printf("__util$wild_match(\"%s\")    : %llu ns/call, %s\n", l_cases[k].pattern, l_ns / a_count, l_rc ? "match" : "no match");
+
+		__util$wild_free(l_wild);
+		}
+}
+
+/* ACL-like list of the wildcard patterns: __util$pattern_match() for every pattern against the set */
+static void	s_bench_wildset	(
+		int	a_count
+			)
+{
+static const char *l_tmpls [] = {"*.%s.example.com", "host-%s-*", "*/%s/*.log", "%s*", "*%s", "svc_%s_%%%%"};
+char	**l_pats, l_word[32];
+ASC	*l_strs;
+int	*l_ids, i, k, l_patnr = 2000, l_strnr, l_found = 0, l_id;
+UTIL_WILDSET *l_set;
+struct timespec	l_start;
+unsigned long long l_ns, l_seed = 1;
+
+	l_strnr = a_count ? (a_count / 100) + 1 : 10000;
+
+	l_pats = calloc(l_patnr, sizeof(char *));
+	l_strs = calloc(l_strnr, sizeof(ASC));
+	l_ids = calloc(l_strnr, sizeof(int));
+
+	for ( i = 0; l_pats && (i < l_patnr); i++ )
+		{
+		l_seed = l_seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		snprintf(l_word, sizeof(l_word), "w%05u", (unsigned) (l_seed >> 33) % 50000);
+
+		if ( (l_pats[i] = malloc(64)) )
+			snprintf(l_pats[i], 64, l_tmpls[i % $ARRSZ(l_tmpls)], l_word);
+		}
+
+	for ( i = 0; l_strs && (i < l_strnr); i++ )
+		{
+		l_seed = l_seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		l_strs[i].len = (unsigned char) snprintf(l_strs[i].sts, ASC$K_SZ, "host-w%05u-%u.example.com", (unsigned) (l_seed >> 33) % 50000, i);
+		}
+
+	if ( !l_pats || !l_strs || !l_ids || !(l_set = __util$wildset_compile((const char **) l_pats, l_patnr)) )
+		goto	bench_exit;
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( l_found = i = 0; i < l_strnr; i++ )
+		for ( k = 0; k < l_patnr; k++ )
+			if ( __util$pattern_match(l_strs[i].sts, l_pats[k]) )
+				{
+				l_found++;
+				break;
+				}
+	l_ns = s_bench_elapsed(&l_start);
+	printf("%d patterns by __util$pattern_match() : %llu ns/string, %d matched\n", l_patnr, l_ns / l_strnr, l_found);
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( l_found = i = 0; i < l_strnr; i++ )
+		{
+		l_id = __util$wildset_match(l_set, l_strs[i].sts, l_strs[i].len, NULL, NULL);
+		l_found += (l_id >= 0);
+		}
+	l_ns = s_bench_elapsed(&l_start);
+	printf("%d patterns by __util$wildset_match() : %llu ns/string, %d matched\n", l_patnr, l_ns / l_strnr, l_found);
+
+	for ( k = 1; k <= 4; k *= 2 )
+		{
+		clock_gettime(CLOCK_MONOTONIC, &l_start);
+		__util$wildset_batch(l_set, l_strs, l_strnr, l_ids, k);
+		l_ns = s_bench_elapsed(&l_start);
+
+		for ( l_found = i = 0; i < l_strnr; i++ )
+			l_found += (l_ids[i] >= 0);
+
+		printf("%d patterns by __util$wildset_batch(%d threads) : %llu ns/string, %d matched\n", l_patnr, k, l_ns / l_strnr, l_found);
+		}
+
+	__util$wildset_free(l_set);
+
+bench_exit:
+	for ( i = 0; l_pats && (i < l_patnr); i++ )
+		free(l_pats[i]);
+
+	free(l_pats);
+	free(l_strs);
+	free(l_ids);
+}
+
+/* Hex encoding and decoding of the large buffer, the check of round trip */
+static void	s_bench_hex	(
+		int	a_count
+			)
+{
+size_t	l_sz = 16 * 1024 * 1024, l_len, i;
+unsigned char	*l_bin, *l_bin2;
+char	*l_hex;
+int	l_rep = a_count ? (a_count / 200000) + 1 : 4, k;
+struct timespec	l_start;
+unsigned long long l_ns;
+
+	l_bin = malloc(l_sz);
+	l_bin2 = malloc(l_sz);
+	l_hex = malloc(l_sz * 2 + 1);
+
+	if ( !l_bin || !l_bin2 || !l_hex )
+		goto	bench_exit;
+
+	for ( i = 0; i < l_sz; i++ )
+		l_bin[i] = (unsigned char) (i * 131 + (i >> 8));
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( k = 0; k < l_rep; k++ )
+		__util$bin2hex(l_bin, l_hex, l_sz);
+	l_ns = s_bench_elapsed(&l_start);
+	printf("__util$bin2hex() : %llu MB/s\n", (1000ULL * l_sz * l_rep) / (l_ns ? l_ns : 1));
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( k = 0; k < l_rep; k++ )
+		l_len = __util$hex2bin(l_hex, l_bin2, l_sz * 2);
+	l_ns = s_bench_elapsed(&l_start);
+	printf("__util$hex2bin() : %llu MB/s (of the hex-string), round trip is %s\n", (2000ULL * l_sz * l_rep) / (l_ns ? l_ns : 1),
+		((l_len == l_sz) && !memcmp(l_bin, l_bin2, l_sz)) ? "OK" : "FAILED");
+
+bench_exit:
+	free(l_bin);
+	free(l_bin2);
+	free(l_hex);
+}
+
+/* Base64 encoding and decoding by the scalar code and by the selected kernels */
+static void	s_bench_b64	(
+		int	a_count
+			)
+{
+size_t	l_sz = 1024 * 1024, l_len = 0, l_len2 = 0, i;
+unsigned char	*l_bin, *l_bin2;
+char	*l_b64;
+int	l_rep = a_count ? (a_count / 10000) + 1 : 64, k;
+struct timespec	l_start;
+unsigned long long l_ns;
+
+	l_bin = malloc(l_sz);
+	l_bin2 = malloc(l_sz);
+	l_b64 = malloc($B64ENCLEN(l_sz) + 1);
+
+	if ( !l_bin || !l_bin2 || !l_b64 )
+		goto	bench_exit;
+
+	for ( i = 0; i < l_sz; i++ )
+		l_bin[i] = (unsigned char) (i * 131 + (i >> 8));
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( k = 0; k < l_rep; k++ )
+		s_b64enc_scalar(l_bin, l_sz - l_sz % 3, l_b64, 0);
+	l_ns = s_bench_elapsed(&l_start);
+	printf("Base64 encoding by the scalar code : %llu MB/s\n", (1000ULL * l_sz * l_rep) / (l_ns ? l_ns : 1));
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( k = 0; k < l_rep; k++ )
+		l_len = __util$b64enc(l_bin, l_b64, l_sz, 0);
+	l_ns = s_bench_elapsed(&l_start);
+	printf("__util$b64enc() : %llu MB/s\n", (1000ULL * l_sz * l_rep) / (l_ns ? l_ns : 1));
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( k = 0; k < l_rep; k++ )
+		s_b64dec_scalar((unsigned char *) l_b64, l_len - 4, l_bin2, 0);
+	l_ns = s_bench_elapsed(&l_start);
+	printf("Base64 decoding by the scalar code : %llu MB/s (of the string)\n", (1000ULL * l_len * l_rep) / (l_ns ? l_ns : 1));
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( k = 0; k < l_rep; k++ )
+		l_len2 = __util$b64dec(l_b64, l_bin2, l_len, 0);
+	l_ns = s_bench_elapsed(&l_start);
+	printf("__util$b64dec() : %llu MB/s (of the string), round trip is %s\n", (1000ULL * l_len * l_rep) / (l_ns ? l_ns : 1),
+		((l_len2 == l_sz) && !memcmp(l_bin, l_bin2, l_sz)) ? "OK" : "FAILED");
+
+bench_exit:
+	free(l_bin);
+	free(l_bin2);
+	free(l_b64);
+}
+
+/* Zero checking and zeroing of the small (cached) and large blocks against memset() */
+static void	s_bench_zero	(
+		int	a_count
+			)
+{
+static const size_t l_sizes [] = {256 * 1024, 64 * 1024 * 1024};
+unsigned char	*l_buf;
+int	l_rep, k, i, l_sts = STS$K_SUCCESS;
+struct timespec	l_start;
+unsigned long long l_ns, l_ns2;
+
+	if ( !(l_buf = calloc(1, l_sizes[1])) )
+		return;
+
+	memset(l_buf, 0, l_sizes[1]);				/* Map pages of the buffer before measurement */
+
+	for ( i = 0; i < (int) $ARRSZ(l_sizes); i++ )
+		{
+		l_rep = (int) ((a_count ? a_count : 1000000) * 64ULL / l_sizes[i]) + 1;
+
+		clock_gettime(CLOCK_MONOTONIC, &l_start);
+		for ( k = 0; k < l_rep; k++ )
+			l_sts &= __util$iszero(l_buf, l_sizes[i]);
+		l_ns = s_bench_elapsed(&l_start);
+		printf("__util$iszero(%zu) : %llu MB/s, %s\n", l_sizes[i], (1000ULL * l_sizes[i] * l_rep) / (l_ns ? l_ns : 1),
+			(l_sts & 1) ? "zero" : "FAILED");
+
+		clock_gettime(CLOCK_MONOTONIC, &l_start);
+		for ( k = 0; k < l_rep; k++ )
+			__util$bzero(l_buf, l_sizes[i]);
+		l_ns = s_bench_elapsed(&l_start);
+
+		clock_gettime(CLOCK_MONOTONIC, &l_start);
+		for ( k = 0; k < l_rep; k++ )
+			memset(l_buf, 0, l_sizes[i]);
+		l_ns2 = s_bench_elapsed(&l_start);
+
+		printf("__util$bzero(%zu) : %llu MB/s, memset() : %llu MB/s\n", l_sizes[i], (1000ULL * l_sizes[i] * l_rep) / (l_ns ? l_ns : 1),
+			(1000ULL * l_sizes[i] * l_rep) / (l_ns2 ? l_ns2 : 1));
+		}
+
+	free(l_buf);
+}
+
+/* XOR-ing of the large buffer by the short key, by the one and several threads */
+static void	s_bench_xor	(
+		int	a_count
+			)
+{
+const int	l_sz = 16 * 1024 * 1024;
+unsigned char	*l_buf, l_key[] = "0123456789ABC";
+int	l_rep = a_count ? 2 * (a_count / 400000) + 2 : 4, k, l_ctx;	/* Even number to get zeros back */
+struct timespec	l_start;
+unsigned long long l_ns;
+
+	if ( !(l_buf = calloc(1, l_sz)) )
+		return;
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( k = 0; k < l_rep; k++ )
+		{
+		l_ctx = -1;
+		__util$strxor(l_key, sizeof(l_key) - 1, l_buf, l_sz, l_buf, l_sz, &l_ctx);
+		}
+	l_ns = s_bench_elapsed(&l_start);
+	printf("__util$strxor(%d octets key) : %llu MB/s\n", (int) sizeof(l_key) - 1, (1000ULL * l_sz * l_rep) / (l_ns ? l_ns : 1));
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( k = 0; k < l_rep; k++ )
+		{
+		l_ctx = -1;
+		__util$strxor_mt(l_key, sizeof(l_key) - 1, l_buf, l_sz, l_buf, l_sz, &l_ctx, 4);
+		}
+	l_ns = s_bench_elapsed(&l_start);
+	printf("__util$strxor_mt(4 threads) : %llu MB/s, %s\n", (1000ULL * l_sz * l_rep) / (l_ns ? l_ns : 1),
+		(1 & __util$iszero(l_buf, l_sz)) ? "round trip is OK" : "round trip is FAILED");
+
+	free(l_buf);
+}
+
+/* Abbreviated keywords lookup by the linear scan of the table and by the compiled index */
+static void	s_bench_kwd	(
+		int	a_count
+			)
+{
+static const char *l_names [] = {"ALLOCATE", "ANALYZE", "APPEND", "ASSIGN", "BACKUP", "CALL", "CANCEL", "CLOSE", "CONNECT",
+	"CONTINUE", "CONVERT", "COPY", "CREATE", "DEALLOCATE", "DEASSIGN", "DEBUG", "DECK", "DEFINE", "DELETE", "DEPOSIT",
+	"DIFFERENCES", "DIRECTORY", "DISCONNECT", "DISMOUNT", "DUMP", "EDIT", "EXAMINE", "EXIT", "HELP", "INITIALIZE",
+	"INQUIRE", "INSTALL", "LIBRARY", "LINK", "LOGOUT", "MOUNT", "OPEN", "PRINT", "PURGE", "READ", "RECALL", "RENAME",
+	"RUN", "SEARCH", "SET", "SHOW", "SORT", "SPAWN", "START", "STOP", "SUBMIT", "TYPE", "WAIT", "WRITE"};
+static const char *l_toks [] = {"SHO", "dir", "SET", "search", "STO", "del", "TYP", "dif", "purge", "write", "cop", "spa"};
+KWDENT	l_ktbl[$ARRSZ(l_names)], *l_kwd;
+UTIL_KWDIDX	*l_idx;
+int	i, k, l_nr, l_lens[$ARRSZ(l_toks)];
+struct timespec	l_start;
+unsigned long long l_ns;
+
+	a_count = a_count ? a_count : 1000000;
+
+	for ( i = 0; i < (int) $ARRSZ(l_names); i++ )
+		{
+		__util$str2asc(l_names[i], &l_ktbl[i].kwd);
+		l_ktbl[i].val = i;
+		}
+
+	for ( k = 0; k < (int) $ARRSZ(l_toks); k++ )
+		l_lens[k] = (int) strlen(l_toks[k]);
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( l_nr = i = 0; i < a_count; i++ )
+		for ( k = 0; k < (int) $ARRSZ(l_toks); k++ )
+			l_nr += 1 & __util$lookup_key(l_toks[k], l_lens[k], l_ktbl, $ARRSZ(l_ktbl), &l_kwd, UTIL$K_LOOKUP_NCASE | UTIL$K_LOOKUP_ABBREV);
+	l_ns = s_bench_elapsed(&l_start);
+	printf("%d keywords by __util$lookup_key() : %llu ns/token, %d found\n", (int) $ARRSZ(l_names), l_ns / a_count / $ARRSZ(l_toks), l_nr);
+
+	if ( !(l_idx = __util$kwdidx_compile(l_ktbl, $ARRSZ(l_ktbl), UTIL$K_LOOKUP_NCASE)) )
+		return;
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( l_nr = i = 0; i < a_count; i++ )
+		for ( k = 0; k < (int) $ARRSZ(l_toks); k++ )
+			l_nr += 1 & __util$kwdidx_lookup(l_idx, l_toks[k], l_lens[k], &l_kwd, UTIL$K_LOOKUP_ABBREV);
+	l_ns = s_bench_elapsed(&l_start);
+	printf("%d keywords by __util$kwdidx_lookup() : %llu ns/token, %d found\n", (int) $ARRSZ(l_names), l_ns / a_count / $ARRSZ(l_toks), l_nr);
+
+	__util$kwdidx_free(l_idx);
+}
+
+/* Case-insensitive matching of the options names and the long strings: strncasecmp() against __util$memcmp_blind() */
+static void	s_bench_blind	(
+		int	a_count
+			)
+{
+static const char *l_names [] = {"config", "trace", "logfile", "logsize", "settings", "bench", "timeout", "interface", "address", "netmask"};
+static const char *l_args [] = {"TRACE", "LogFile", "bench", "INTERFACE", "netmask", "CONFIG"};
+char	l_long1[256], l_long2[256];
+int	i, j, k, l_nr, l_lens[$ARRSZ(l_names)], l_alens[$ARRSZ(l_args)];
+struct timespec	l_start;
+unsigned long long l_ns;
+
+	a_count = a_count ? a_count : 1000000;
+
+	for ( j = 0; j < (int) $ARRSZ(l_names); j++ )
+		l_lens[j] = (int) strlen(l_names[j]);
+
+	for ( k = 0; k < (int) $ARRSZ(l_args); k++ )
+		l_alens[k] = (int) strlen(l_args[k]);
+
+	for ( i = 0; i < (int) sizeof(l_long1); i++ )
+		{
+		l_long1[i] = 'A' + (i % 26);
+		l_long2[i] = 'a' + (i % 26);
+		}
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( l_nr = i = 0; i < a_count; i++ )
+		for ( k = 0; k < (int) $ARRSZ(l_args); k++ )
+			for ( j = 0; j < (int) $ARRSZ(l_names); j++ )
+				l_nr += !strncasecmp(l_args[k], l_names[j], $MIN(l_alens[k], l_lens[j]));
+	l_ns = s_bench_elapsed(&l_start);
+	printf("Options matching by strncasecmp() : %llu ns/argument, %d matched\n", l_ns / a_count / $ARRSZ(l_args), l_nr);
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( l_nr = i = 0; i < a_count; i++ )
+		for ( k = 0; k < (int) $ARRSZ(l_args); k++ )
+			for ( j = 0; j < (int) $ARRSZ(l_names); j++ )
+				l_nr += !__util$memcmp_blind(l_args[k], l_names[j], $MIN(l_alens[k], l_lens[j]));
+	l_ns = s_bench_elapsed(&l_start);
+	printf("Options matching by __util$memcmp_blind() : %llu ns/argument, %d matched\n", l_ns / a_count / $ARRSZ(l_args), l_nr);
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( l_nr = i = 0; i < a_count; i++ )
+		{
+		l_long1[i & 0x7F] ^= 0x20;
+		l_nr += !strncasecmp(l_long1, l_long2, sizeof(l_long1));
+		}
+	l_ns = s_bench_elapsed(&l_start);
+	printf("%d octets by strncasecmp() : %llu ns/string, %d equal\n", (int) sizeof(l_long1), l_ns / a_count, l_nr);
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( l_nr = i = 0; i < a_count; i++ )
+		{
+		l_long1[i & 0x7F] ^= 0x20;
+		l_nr += !__util$memcmp_blind(l_long1, l_long2, sizeof(l_long1));
+		}
+	l_ns = s_bench_elapsed(&l_start);
+	printf("%d octets by __util$memcmp_blind() : %llu ns/string, %d equal\n", (int) sizeof(l_long1), l_ns / a_count, l_nr);
+}
+
+static void	s_bench_line	(
+		int	a_count
+			)
+{
+static const char *l_lines [] = {
+	"   -logfile = /var/log/starlet/starlet.log	! Log file specification\n",
+	"\t-trace\n",
+	"! -------------------------------------------------------------------------------------------\n",
+	"		-interface  =  eth0   ,  eth1 ,   eth2      ! A list of the network interfaces to be used \n",
+	"+  10.0.0.0 / 8  \t\t\t\t\t\t\t! Private network \n"};
+char	l_buf[256];
+int	i, j, l_len;
+struct timespec	l_start;
+unsigned long long l_ns, l_total = 0;
+
+	a_count = a_count ? a_count : 1000000;
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( i = 0; i < a_count; i++ )
+		for ( j = 0; j < (int) $ARRSZ(l_lines); j++ )
+			{
+			strcpy(l_buf, l_lines[j]);
+
+			if ( !(l_len = __util$uncomment(l_buf, (int) strlen(l_buf), '!')) )
+				continue;
+
+			if ( !(l_len = __util$trim(l_buf, (int) strlen(l_buf))) )
+				continue;
+
+			l_total += __util$collapse(l_buf, l_len);
+			}
+	l_ns = s_bench_elapsed(&l_start);
+	printf("__util$uncomment() + __util$trim() + __util$collapse() : %llu ns/line, %llu octets\n", l_ns / a_count / $ARRSZ(l_lines), l_total);
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( l_total = i = 0; i < a_count; i++ )
+		for ( j = 0; j < (int) $ARRSZ(l_lines); j++ )
+			{
+			strcpy(l_buf, l_lines[j]);
+			l_total += __util$sv_normalize(l_buf, strlen(l_buf), '!', UTIL$M_LINE_COLLAPSE, l_buf, sizeof(l_buf)).len;
+			}
+	l_ns = s_bench_elapsed(&l_start);
+	printf("__util$sv_normalize(UTIL$M_LINE_COLLAPSE) : %llu ns/line, %llu octets\n", l_ns / a_count / $ARRSZ(l_lines), l_total);
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( l_total = i = 0; i < a_count; i++ )
+		for ( j = 0; j < (int) $ARRSZ(l_lines); j++ )
+			l_total += __util$sv_normalize(l_lines[j], strlen(l_lines[j]), '!', 0, NULL, 0).len;
+	l_ns = s_bench_elapsed(&l_start);
+	printf("__util$sv_normalize() - a view : %llu ns/line, %llu octets\n", l_ns / a_count / $ARRSZ(l_lines), l_total);
+}
+
+static void	s_bench_uuid	(
+		int	a_count
+			)
+{
+UTIL_UUID	l_uuid, l_prev = {0};
+char	l_str[UTIL$K_UUIDSTRLEN + 1];
+unsigned l_fld[6];
+int	i, l_nr;
+struct timespec	l_start;
+unsigned long long l_ns, l_hash = 0;
+
+	a_count = a_count ? a_count : 1000000;
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( i = 0; i < a_count; i++ )
+		__util$uuid_v4(l_uuid);
+	l_ns = s_bench_elapsed(&l_start);
+	printf("__util$uuid_v4() : %llu ns/UUID\n", l_ns / a_count);
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( l_nr = i = 0; i < a_count; i++ )
+		{
+		__util$uuid_v7(l_uuid);
+		l_nr += (0 < __util$uuid_cmp(l_uuid, l_prev));
+		memcpy(l_prev, l_uuid, sizeof(l_uuid));
+		}
+	l_ns = s_bench_elapsed(&l_start);
+	printf("__util$uuid_v7() : %llu ns/UUID, %d of %d are ordered\n", l_ns / a_count, l_nr, a_count);
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( i = 0; i < a_count; i++ )
+		{
+		l_uuid[15] = (unsigned char) i;
+		snprintf(l_str, sizeof(l_str), "%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+			l_uuid[0], l_uuid[1], l_uuid[2], l_uuid[3], l_uuid[4], l_uuid[5], l_uuid[6], l_uuid[7],
+			l_uuid[8], l_uuid[9], l_uuid[10], l_uuid[11], l_uuid[12], l_uuid[13], l_uuid[14], l_uuid[15]);
+		}
+	l_ns = s_bench_elapsed(&l_start);
+	printf("UUID by snprintf() : %llu ns/UUID\n", l_ns / a_count);
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( i = 0; i < a_count; i++ )
+		{
+		l_uuid[15] = (unsigned char) i;
+		__util$uuid2str(l_uuid, l_str, sizeof(l_str));
+		}
+	l_ns = s_bench_elapsed(&l_start);
+	printf("UUID by __util$uuid2str() : %llu ns/UUID\n", l_ns / a_count);
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( l_nr = i = 0; i < a_count; i++ )
+		l_nr += (5 == sscanf(l_str, "%08x-%04x-%04x-%04x-%012x", &l_fld[0], &l_fld[1], &l_fld[2], &l_fld[3], &l_fld[4]));
+	l_ns = s_bench_elapsed(&l_start);
+	printf("UUID by sscanf() : %llu ns/UUID, %d parsed\n", l_ns / a_count, l_nr);
+
+	clock_gettime(CLOCK_MONOTONIC, &l_start);
+	for ( l_nr = i = 0; i < a_count; i++ )
+		{
+		l_nr += 1 & __util$uuid_parse(l_str, UTIL$K_UUIDSTRLEN, l_uuid);
+		l_hash += __util$uuid_hash(l_uuid);
+		}
+	l_ns = s_bench_elapsed(&l_start);
+	printf("UUID by __util$uuid_parse() + __util$uuid_hash() : %llu ns/UUID, %d parsed (%llx)\n", l_ns / a_count, l_nr, l_hash);
+}
+
 int	main (int argc, char *argv[])
 {
 ASC	l_logfspec = {0}, l_confspec = {0}, l_settings = {0};
-int	l_trace, l_logsize;
+int	l_trace = 0, l_logsize, l_bench = 0;
 
 
 const OPTS l_optstbl [] =					/* General CLI options		*/
@@ -2864,6 +9807,7 @@ const OPTS l_optstbl [] =					/* General CLI options		*/
 		{$ASCINI("logfile"),	&l_logfspec, ASC$K_SZ,		OPTS$K_STR},
 		{$ASCINI("logsize"),	&l_logsize, 0,			OPTS$K_INT},
 		{$ASCINI("settings"),	&l_settings,  ASC$K_SZ,		OPTS$K_STR},
+		{$ASCINI("bench"),	&l_bench, 0,			OPTS$K_INT},	/* /BENCH=<count> - run formatting benchmark */
 
 		OPTS_NULL
 	};
@@ -2872,6 +9816,23 @@ const OPTS l_optstbl [] =					/* General CLI options		*/
 
 	__util$getparams(argc, argv, l_optstbl);
 	__util$showparams(l_optstbl);
+
+	if ( l_bench )
+		{
+		s_bench_fmt(l_bench);
+		s_bench_faol(l_bench);
+		s_bench_strstr(l_bench);
+		s_bench_wild(l_bench);
+		s_bench_wildset(l_bench);
+		s_bench_hex(l_bench);
+		s_bench_b64(l_bench);
+		s_bench_zero(l_bench);
+		s_bench_xor(l_bench);
+		s_bench_kwd(l_bench);
+		s_bench_blind(l_bench);
+		s_bench_uuid(l_bench);
+		s_bench_line(l_bench);
+		}
 }
 #endif	/* __MAIN_FOR_DEBUG__ */
 
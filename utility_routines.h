@@ -50,6 +50,44 @@
 **
 **	10-OCT-2024	RRL	Fix $IFTRACE() in Release compilation
 **
+**	19-OCT-2026	RRL	Added __util$frec_*() - flight recorder API declarations.
+**
+**	19-OCT-2026	RRL	Added run-time toggled trace points: $TPNT, $IFTPNT, __util$tpnt_*();
+**				$TRACE/$IFTRACE are mapped to the trace points if __TRACE_POINTS__ is defined.
+**
+**	19-OCT-2026	RRL	Added __util$dumphexl(), __util$faohexl() - hex dump of the size_t length buffers,
+**				$DUMPHEX is redirected to the __util$dumphexl().
+**
+**	19-OCT-2026	RRL	Added __util$logmode() - select text or JSON output of the log records.
+**
+**	19-OCT-2026	RRL	Added $LOGRL - rate limited $LOG, __util$logrl_flush().
+**
+**	19-OCT-2026	RRL	Added EMSG_FILE_* - binary message catalog file, __util$inimsgf().
+**
+**	19-OCT-2026	RRL	Added declaration of the __util$fao(); compiled FAO programs API.
+**
+**	19-OCT-2026	RRL	Added two-digit lookup table integer formatting kernels, __util$uint64_2_dec();
+**				fixed __util$uint32_2_dec() for zero and buffer overrun.
+**
+**	19-OCT-2026	RRL	Added __util$faov(), __util$vfaov() - FAO output into the I/O vector, __util$logfao().
+**
+**	19-OCT-2026	RRL	Added UTIL_DSC, declaration of the __util$faol().
+**
+**	19-OCT-2026	RRL	Added UTIL_MPM, __util$mpm_*() - multi-pattern search.
+**
+**	19-OCT-2026	RRL	Added UTIL_WILD, __util$wild_*() - compiled wildcard patterns.
+**
+**	19-OCT-2026	RRL	Added UTIL_WILDSET, __util$wildset_*() - a set of the wildcard patterns.
+**
+**	19-OCT-2026	RRL	Added UTIL_UUID, __util$uuid_*(); __util$uuid2str() is not inline anymore.
+**
+**	19-OCT-2026	RRL	Added UTIL_B64CTX, __util$b64*() - Base64/Base64url encoding and decoding.
+**
+**	19-OCT-2026	RRL	Added __util$*_blind() - ASCII-only case-insensitive routines, __util$cmpasc_blind(),
+**				__util$sv_cmp_blind(), __util$lookup_key() are use them instead of strncasecmp().
+**
+**	19-OCT-2026	RRL	Added __util$sv_normalize() - uncomment, trim and collapse a line in the single pass.
+**
 */
 
 #if _WIN32
@@ -85,6 +123,7 @@ extern "C" {
 #ifndef	WIN32
 	#include	<pthread.h>
 	#include	<unistd.h>
+	#include	<sys/uio.h>
 #endif
 
 #define	CRLFCRLF_LW	0x0a0d0a0d
@@ -440,7 +479,50 @@ typedef struct __emsg_record_desc__ {
 } EMSG_RECORD_DESC;
 
 
+
+/*
+ * A binary message catalog file is produced by the message compiler (msgcomp) from
+ * the .MSG file, see msg_compiler.c. The file is mapped into memory by the __util$inimsgf()
+ * and registered without sorting and indexing:
+ *
+ *	+------------+--------------+-----------------------+-----------------+-- ... --+
+ *	| File header| Facility [0] | .. Facility [facnr-1] | EMSG_RECORD [ ] | Index[] |
+ *	+------------+--------------+-----------------------+-----------------+-- ... --+
+ *
+ * records of the every facility are sorted by the <sts>, the index is a dense table
+ * "message number - msgmin -> record index + 1".
+ */
+#define	EMSG$T_FILE_MAGIC	"EMSGF001"
+#define	EMSG$K_FILE_BOM		0x01020304		/* Byte order marker in the host byte order	*/
+#define	EMSG$K_FILE_ALIGN	8			/* Alignment of the sections in the file	*/
+
+#pragma pack(push)
+#pragma pack(8)
+
+typedef struct __emsg_file_fac__ {
+	unsigned		facno,			/* A facility number				*/
+				msgnr,			/* A number of message records			*/
+				recoff,			/* An offset of the first message record	*/
+				msgmin,			/* A minimal message number			*/
+				idxnr,			/* A number of entries in the index		*/
+				idxoff;			/* An offset of the index			*/
+	char			name[32];		/* A facility name, ASCIZ			*/
+} EMSG_FILE_FAC;
+
+typedef struct __emsg_file_hdr__ {
+	char			magic[8];		/* EMSG$T_FILE_MAGIC				*/
+	unsigned		bom,			/* EMSG$K_FILE_BOM				*/
+				recsz,			/* sizeof(EMSG_RECORD)				*/
+				facnr,			/* A number of facilities			*/
+				size;			/* A total size of the file			*/
+	EMSG_FILE_FAC		fac[0];			/* Facilities descriptors			*/
+} EMSG_FILE_HDR;
+
+#pragma pack(pop)
+
+
 unsigned	__util$inimsg	(EMSG_RECORD_DESC *msgdsc);
+unsigned	__util$inimsgf	(const char *fspec);
 unsigned	__util$getmsg	(unsigned sts, EMSG_RECORD **outmsg);
 unsigned	__util$putmsg	(unsigned sts, ...);
 unsigned	__util$putmsgd	(unsigned sts, const char *__mod, const char *__fi, unsigned __li, ...);
@@ -449,6 +531,13 @@ unsigned	__util$putmsgd	(unsigned sts, const char *__mod, const char *__fi, unsi
 unsigned	__util$log	(const char *fac, unsigned severity, const char *fmt, ...);
 unsigned	__util$logd	(const char *fac, unsigned severity, const char *fmt, const char *mod, const char *__func, unsigned __line, ...);
 unsigned	__util$log2buf	(void *out, int outsz, int * outlen, const char *fac, unsigned severity, const char *fmt, ...);
+
+enum	{
+	UTIL$K_LOGMODE_TEXT = 0,		/* "DD-MM-YYYY HH:MM:SS.msec <tid> [<mod>\<func>:<line>] %FAC-S: text"	*/
+	UTIL$K_LOGMODE_JSON			/* {"ts":<epoch ns>,"tid":<tid>,"facility":"FAC","severity":"S", ...}	*/
+};
+
+int	__util$logmode	(int mode);
 unsigned	__util$syslog	(int fac, int sev, const char *tag, const char *msg, int  msglen);
 unsigned	__util$out	(char *fmt, ...);
 
@@ -464,6 +553,57 @@ unsigned	__util$out	(char *fmt, ...);
 #endif
 
 
+/*
+ * Per call site rate limiting: $LOGRL passes no more than <rate> messages per second with
+ * bursts up to <burst> messages, suppressed messages are reported as "Last message repeated N times".
+ * Unlike the $LOG, the $LOGRL is a statement and has no value.
+ */
+#pragma	pack(push)
+#pragma	pack(8)
+
+typedef	struct __util_logrl__ {
+	unsigned	rate,			/* A number of messages per second			*/
+			burst;			/* A maximum burst of messages				*/
+
+	volatile unsigned long long tat;	/* GCRA's theoretical arrival time, nanoseconds		*/
+	volatile unsigned suppressed;		/* A number of suppressed messages			*/
+	volatile int	state;			/* 0 - new, 1 - registering, 2 - registered		*/
+
+	const char	*fac,			/* Call site's attributes for summary record		*/
+			*mod,
+			*func;
+	unsigned	line;
+
+	struct __util_logrl__ *link;		/* Next call site in the list				*/
+} UTIL_LOGRL;
+
+#pragma	pack(pop)
+
+unsigned	__util$logrl	(UTIL_LOGRL *site, const char *fac, unsigned severity, const char *fmt, const char *mod, const char *__func, unsigned __line, ...);
+int	__util$logrl_flush	(void);
+
+#define	$LOGRL(rate, burst, severity, fmt, ...)	do {	static UTIL_LOGRL __logrl__ = {rate, burst};\
+					__util$logrl(&__logrl__, __FAC__, severity, fmt, __MODULE__, __FUNCTION__ , __LINE__ , ## __VA_ARGS__);\
+					} while (0)
+
+
+/*
+ * Flight recorder - an always-on per-thread ring buffer keeping last UTIL$K_FREC_RECNR
+ * records has been formatted by the $LOG/$TRACE/$PUTMSG routines. The rings are dumped
+ * into the file by the fatal signals handler (see __util$frec_init()) or on demand.
+ */
+#define	UTIL$K_FREC_RECNR	64			/* A number of records in the per-thread ring	*/
+#define	UTIL$K_FREC_RECSZ	248			/* A maximum length of the single record	*/
+#define	UTIL$K_FREC_MAXTHR	256			/* A maximum number of the rings/threads	*/
+#define	UTIL$K_FREC_ALTSTKSZ	(64 * 1024)		/* An alternate signal stack of the thread	*/
+
+int	__util$frec_init	(const char *dumpfile);
+int	__util$frec_thrinit	(void);
+void	__util$frec_put		(const char *rec, unsigned reclen);
+int	__util$frec_dump	(int fd);
+int	__util$frec_snapshot	(char *buf, size_t bufsz, size_t *buflen);
+
+
 
 /*
  * Description: Implement spinlock logic by using GCC builtin, set the lock value to 1.
@@ -1195,137 +1335,65 @@ int	left = $MIN(__min__, __max__) , right = $MAX(__min__, __max__);
 
 
 
-/*
- *
- *  Description: check buffer for consecutive zero octets
- *
- *  Input:
- *
- *	bufp:	buffer to check, address
- *	bufsz:	a length of data in the buffer
- *
- *
- *  Return:
- *	SS$_NORMAL	- the buffer is zero filled
- *	STS$K_WARN	- the buffer is not zero filled
- */
-/**
- * @brief __util$iszero	- check buffer for consecutive zero octets
- * @param bufp	:	buffer to check, address
- * @param bufsz	:	a length of data in the buffer
- * @return -
- * *	SS$_NORMAL	- the buffer is zero filled
- *	STS$K_WARN	- the buffer is not zero filled
- */
-inline static int __util$iszero	(
-		void *	bufp,
-		int	bufsz
-			)
-{
-int	i;
-unsigned char *__bufp = (unsigned char *) bufp;
-
-#if ( (defined ULLONG_MAX && (ULLONG_MAX > UINT_MAX)) || (defined ULONG_LONG_MAX && (ULONG_LONG_MAX > UINT_MAX)) )
-
-//#pragma message	("%CC-I-ULLONG64, unsigned long long - 64 bits")
-
-	/* Step by 8 octets ... */
-	for (i = bufsz/sizeof(unsigned long long); i; i--, __bufp += sizeof(unsigned long long) )
-		{
-		if ( *((unsigned long long *) __bufp ) )
-			return	STS$K_WARN;
-		}
-#endif // (sizeof(unsigned long long)) > sizeof(unsigned int long) )
-
-	/* Compute remainder octets in the buffer */
-	bufsz %= sizeof(unsigned int long);
+int	__util$iszero	(const void *bufp, size_t bufsz);	/* STS$K_SUCCESS - the buffer is zero filled, STS$K_WARN - is not */
+int	__util$bzero	(void *bufp, size_t bufsz);
 
-	/* Step by 4 octets ... */
-	for (i = bufsz/sizeof(unsigned int); i; i--, __bufp += sizeof(unsigned int) )
-		{
-		if ( *((unsigned int *) __bufp ) )
-			return	STS$K_WARN;
-		}
 
-	/* Compute remainder octets in the buffer */
-	bufsz %= sizeof(unsigned int);
-
-	/* Step by 2 octets ... */
-	for (i = bufsz/sizeof(unsigned short); i; i--, __bufp += sizeof(unsigned short) )
-		{
-		if ( *((unsigned short *) __bufp ) )
-			return	STS$K_WARN;
-		}
 
-	/* Compute remainder octets in the buffer */
-	bufsz %= sizeof(unsigned short);
 
-	if ( bufsz && *__bufp )
-		return	STS$K_WARN;
-
-	return	STS$K_SUCCESS;
-}
+/* Tracing facility	*/
+void	__util$trace	(int cond, const char *fmt, const char *mod, const char *func, unsigned line, ...);
 
 
-/**
- * @brief __util$bzero	- zeroing memory block
- * @param bufp	:	buffer to check, address
- * @param bufsz	:	a length of data in the buffer
- * @return -
- * 	SS$_NORMAL	- the buffer is zero filled
- *
+/*
+ * Run-time toggled trace points: every $TPNT/$IFTPNT call site owns a static descriptor,
+ * the descriptor is linked into the registry at first passing of the point. A disabled
+ * point costs a single load and a predicted branch. Points are named as "<module>\<function>:<line>"
+ * and switched ON/OFF by the wildcard patterns through the API, a control file or a signal.
  */
-inline static int __util$bzero	(
-		void *	bufp,
-		size_t	bufsz
-			)
-{
-size_t	i;
-unsigned char *__bufp = (unsigned char *) bufp;
-
-	/*
-	 * There is a place for optimization : align a memory address at head
-	 * of the memory block
-	 */
-
-#if ( (defined ULLONG_MAX && (ULLONG_MAX > UINT_MAX)) || (defined ULONG_LONG_MAX && (ULONG_LONG_MAX > UINT_MAX)) )
-
-//#pragma message	("%CC-I-ULLONG64, unsigned long long - 64 bits")
-
-	/* Step by 8 octets ... */
-	for (i = bufsz/sizeof(unsigned long long); i; i--, __bufp += sizeof(unsigned long long) )
-		*((unsigned long long *) __bufp ) = 0;
-#endif // (sizeof(unsigned long long)) > sizeof(unsigned int) )
-
-	/* Compute remainder octets in the buffer */
-	bufsz %= sizeof(unsigned long long);
-
-	/* Step by 4 octets ... */
-	for (i = bufsz/sizeof(unsigned int); i; i--, __bufp += sizeof(unsigned int) )
-		*((unsigned int *) __bufp ) = 0;
-
-	/* Compute remainder octets in the buffer */
-	bufsz %= sizeof(unsigned int);
+#pragma	pack	(push)
+#pragma	pack	(8)
 
-	/* Step by 2 octets ... */
-	for (i = bufsz/sizeof(unsigned short); i; i--, __bufp += sizeof(unsigned short) )
-		if ( *((unsigned short *) __bufp ) )
+enum	{
+	UTIL$K_TPNT_OFF	= 0,			/* Trace point is disabled				*/
+	UTIL$K_TPNT_ON	= 1,			/* Trace point is enabled				*/
+	UTIL$K_TPNT_NEW	= 2			/* Trace point has not been registered yet		*/
+};
 
-	/* Compute remainder octets in the buffer */
-	bufsz %= sizeof(unsigned short);
+typedef	struct __util_tpnt__ {
+	volatile int	state;			/* See UTIL$K_TPNT_* constants				*/
+	unsigned	line;			/* Source line number					*/
+	const char	*mod,			/* Module name, can be NULL				*/
+			*func;			/* Function name					*/
+	struct __util_tpnt__ *link;		/* Next trace point in the registry			*/
+} UTIL_TPNT;
 
-	if ( bufsz )
-		__bufp = (unsigned char *)'\0';
+#pragma	pack	(pop)
 
-	return	STS$K_SUCCESS;
-}
+void	__util$tpnt_trace	(UTIL_TPNT *tpnt, int cond, const char *fmt, ...);
+int	__util$tpnt_set		(const char *pattern, int state);
+int	__util$tpnt_load	(const char *fspec);
+int	__util$tpnt_sigini	(int signo, const char *fspec);
+int	__util$tpnt_poll	(void);
+int	__util$tpnt_show	(void);
 
+#define	$IFTPNT(cond, fmt, ...)	do {	static UTIL_TPNT __tpnt__ = {UTIL$K_TPNT_NEW, __LINE__, __MODULE__, __FUNCTION__, NULL};\
+					if ( unlikely(__tpnt__.state) ) __util$tpnt_trace(&__tpnt__, (cond), fmt, ## __VA_ARGS__);\
+				} while (0)
 
+#define	$TPNT(fmt, ...)		$IFTPNT(1, fmt, ## __VA_ARGS__)
 
+/* Build with -D__TRACE_POINTS__ to turn all $TRACE/$IFTRACE into the run-time toggled trace points */
+#ifdef	__TRACE_POINTS__
+	#ifndef	$TRACE
+		#define $TRACE(fmt, ...)	$TPNT(fmt, ## __VA_ARGS__)
+	#endif
 
+	#ifndef	$IFTRACE
+		#define $IFTRACE(cond, fmt, ...) $IFTPNT(cond, fmt, ## __VA_ARGS__)
+	#endif
+#endif
 
-/* Tracing facility	*/
-void	__util$trace	(int cond, const char *fmt, const char *mod, const char *func, unsigned line, ...);
 
 #ifndef	NDEBUG
 	#ifndef	$TRACE
@@ -1343,8 +1411,13 @@ static inline void __util$nope (void) {}
 
 
 
-	#define $TRACE(fmt, ...)		__util$nope()
-	#define $IFTRACE(cond, fmt, ...)	__util$nope()
+	#ifndef	$TRACE
+		#define $TRACE(fmt, ...)		__util$nope()
+	#endif
+
+	#ifndef	$IFTRACE
+		#define $IFTRACE(cond, fmt, ...)	__util$nope()
+	#endif
 
 #endif
 
@@ -1374,47 +1447,135 @@ typedef	struct _asc
 
 
 /*
- *   DESCRIPTION: Convert 32-x bits unsigned interegr ot the decimal text string.
+ * Two-digit lookup tables are used by the integer formatting kernels: "00" "01" ... "99",
+ * "00" "01" ... "FF" and "00" "01" ... "ff"
+ */
+extern const char __util$dec2lut[200], __util$hex2lut_uc[512], __util$hex2lut_lc[512];
+
+/*
+ *   DESCRIPTION: Convert 64-x bits unsigned integer to the decimal digits, the digits are put
+ *	backward from the given end of buffer. The buffer must have room for 20 digits.
  *
  *   INPUT:
- *	a_src:		Source value to be converted, unsigned int
+ *	a_src:		Source value to be converted
+ *	a_end:		An address of the end of the destination buffer
+ *
+ *   RETURNS:
+ *	A number of digits
+ */
+inline	static int __util$u64_2_decrev
+		(
+	unsigned long long a_src,
+		char	*a_end
+		)
+{
+char	*l_cp = a_end;
+
+	while ( a_src >= 100 )
+		{
+		l_cp -= 2;
+		memcpy(l_cp, __util$dec2lut + (a_src % 100) * 2, 2);
+		a_src /= 100;
+		}
+
+	if ( a_src >= 10 )
+		{
+		l_cp -= 2;
+		memcpy(l_cp, __util$dec2lut + a_src * 2, 2);
+		}
+	else	*(--l_cp) = (char) ('0' + a_src);
+
+	return	(int) (a_end - l_cp);
+}
+
+/*
+ *   DESCRIPTION: Convert 64-x bits unsigned integer to the fixed width hexadecimal digits.
+ *
+ *   INPUT:
+ *	a_src:		Source value to be converted
+ *	a_digits:	A number of digits to put: 2, 4, 8, 16
+ *	a_lut:		__util$hex2lut_uc or __util$hex2lut_lc
+ *	a_dst:		An address of the destination buffer
+ *
+ *   RETURNS:
+ *	A number of digits
+ */
+inline	static int __util$u64_2_hex
+		(
+	unsigned long long a_src,
+		int	a_digits,
+	const char	*a_lut,
+		char	*a_dst
+		)
+{
+int	i;
+
+	for ( i = a_digits - 2; i >= 0; i -= 2, a_src >>= 8 )
+		memcpy(a_dst + i, a_lut + (a_src & 0xff) * 2, 2);
+
+	return	a_digits;
+}
+
+/*
+ *   DESCRIPTION: Convert 64-x bits unsigned integer to the decimal text string, the result
+ *	is truncated to the size of the buffer like by snprintf().
+ *
+ *   INPUT:
+ *	a_src:		Source value to be converted
  *	a_dst:		An address of the destination buffer
  *	a_dstsz:	A size of the destination buffer
  *
  *   OUTPUT:
  *	[a_retlen]:	A length of the result decimal string, optional
+ *
+ *   RETURNS:
+ *	A length of the result decimal string
  */
-inline	static int __util$uint32_2_dec
+inline	static int __util$uint64_2_dec
 		(
-	unsigned int	a_src,
+	unsigned long long a_src,
 		char	*a_dst,
 		size_t	a_dstsz,
 		size_t	*a_retlen
 		)
 {
-size_t	l_retlen;
-char	*l_dstp;
+char	l_buf[24];
+size_t	l_retlen, l_ndig;
 
 	assert(a_dstsz);								/* Check for non-zero buffer */
-	l_retlen = 0;									/* Preset length of result string to zero */
-	l_dstp = a_dst + a_dstsz;							/* Set <l_dstp> to end of the output buffer */
 
-	for (; a_src && a_dstsz;
-		l_dstp--, a_dstsz--, l_retlen++)					/* Adjust counters and pointers .... */
-		{
-		*l_dstp = '0' + a_src % 10;						/* Put reminder of deivision to the currect output buffer */
-		a_src /= 10;								/* <a_src> keep a result of devision */
-		}
+	l_ndig = __util$u64_2_decrev(a_src, l_buf + sizeof(l_buf));
+	l_retlen = (l_ndig < a_dstsz) ? l_ndig : a_dstsz - 1;
+
+	memcpy(a_dst, l_buf + sizeof(l_buf) - l_ndig, l_retlen);
+	a_dst[l_retlen] = '\0';
 
 	if ( a_retlen )									/* Do we need to return a length of the decimal string ? */
 		*a_retlen = l_retlen;
 
-	if ( l_dstp != a_dst )
-		memmove(a_dst, l_dstp, l_retlen);					/* Move result string to begin of the <a_dst> buffer */
-
-	a_dst[l_retlen] = '\0';								/* Esspesialy for snaike oil mothefukkerzzzz */
+	return	(int) l_retlen;
+}
 
-	return	l_retlen;
+/*
+ *   DESCRIPTION: Convert 32-x bits unsigned interegr ot the decimal text string.
+ *
+ *   INPUT:
+ *	a_src:		Source value to be converted, unsigned int
+ *	a_dst:		An address of the destination buffer
+ *	a_dstsz:	A size of the destination buffer
+ *
+ *   OUTPUT:
+ *	[a_retlen]:	A length of the result decimal string, optional
+ */
+inline	static int __util$uint32_2_dec
+		(
+	unsigned int	a_src,
+		char	*a_dst,
+		size_t	a_dstsz,
+		size_t	*a_retlen
+		)
+{
+	return	__util$uint64_2_dec(a_src, a_dst, a_dstsz, a_retlen);
 }
 
 
@@ -1515,6 +1676,26 @@ int	status;
 
 
 
+/*
+ * ASCII-only case-insensitive routines: 'A'-'Z' are equal to 'a'-'z', the locale is not used,
+ * NIL is not a terminator. See utility_routines.c for details.
+ */
+int	__util$memcmp_blind	(const void *s1, const void *s2, size_t len);
+void	__util$fold_blind	(void *dst, const void *src, size_t len);
+unsigned long long __util$hash_blind	(const void *src, size_t len);
+
+/* Return 1 if the string is started with the prefix (case insensitive) */
+inline static int	__util$prefix_blind	(
+		const void *	str,
+		size_t		strsz,
+		const void *	prefix,
+		size_t		prefixlen
+			)
+{
+	return	(prefixlen <= strsz) && !__util$memcmp_blind(str, prefix, prefixlen);
+}
+
+
 /**
  * @brief: Comparing two ASCIC
 */
@@ -1528,12 +1709,8 @@ int	status;
 
 	if ( (status = ($ASCLEN(s1) - $ASCLEN(s2))) )
 		return	status;
-#ifdef WIN32
-	return	_stricmp($ASCPTR(s1), $ASCPTR(s2));
-#else
-	return	strncasecmp($ASCPTR(s1), $ASCPTR(s2), $ASCLEN(s1) );
-#endif // WIN32
 
+	return	__util$memcmp_blind($ASCPTR(s1), $ASCPTR(s2), $ASCLEN(s1) );
 }
 
 
@@ -1560,8 +1737,295 @@ inline static int	__util$cpyasc
 
 
 
-#define	$DUMPHEX(s,l)	__util$dumphex(__FUNCTION__, __LINE__ , s, l)
+/*
+ * String view: an address and a length of the string is not owned by the view, so the string is not copied
+ * and is not truncated like in the ASC, it's not null-terminated in general - use "%.*s" with the $SV().
+ */
+#pragma pack(push)
+#pragma pack(8)
+
+typedef	struct __util_strview__
+{
+	const char	*ptr;
+	size_t		len;
+
+	#define	__STRVIEW_TYPE__	1
+} STRVIEW;
+
+#pragma pack(pop)
+
+#define	$SVINI(sts)	{(sts), sizeof(sts) - 1}
+#define	$SVLEN(a)	(((STRVIEW *) a)->len)
+#define	$SVPTR(a)	(((STRVIEW *) a)->ptr)
+#define	$SV(a)		((int) ((STRVIEW *) a)->len),(((STRVIEW *) a)->ptr)
+
+
+/* Make a view of the ASCIIZ string */
+inline static STRVIEW	__util$sv_str	(
+		const char *	a_src
+			)
+{
+STRVIEW	l_sv = {a_src, a_src ? strlen(a_src) : 0};
+
+	return	l_sv;
+}
+
+/* Make a view of the ASCIC string */
+inline static STRVIEW	__util$sv_asc	(
+		const ASC *	a_src
+			)
+{
+STRVIEW	l_sv = {$ASCPTR(a_src), $ASCLEN(a_src)};
+
+	return	l_sv;
+}
+
+/* Copying the viewed string to ASCIC container, a long string is truncated */
+inline static int	__util$sv2asc	(
+		const STRVIEW *	a_src,
+		ASC *	a_dst
+			)
+{
+	$ASCLEN(a_dst) = (unsigned char) ((a_src->len < (ASC$K_SZ - 1)) ? a_src->len : (ASC$K_SZ - 1));
+	if ( $ASCLEN(a_dst) )
+		memcpy($ASCPTR(a_dst), a_src->ptr, $ASCLEN(a_dst));
+
+	$ASCPTR(a_dst)[$ASCLEN(a_dst)] = '\0';
+
+	return	$ASCLEN(a_dst);
+}
+
+/*
+ *  DESCRIPTION: Extract a next token from the viewed string, the separators are not
+ *	collapsed: "a,,b" - is "a", "", "b".
+ *
+ *  INPUTS:
+ *	rest:	A view of the string to be split
+ *	sep:	A separator character
+ *
+ *  OUTPUTS:
+ *	rest:	A view of the rest of the string
+ *	tok:	A view of the token
+ *
+ *  RETURNS:
+ *	STS$K_SUCCESS	- a token has been extracted
+ *	STS$K_ERROR	- no more tokens
+ */
+inline static int	__util$sv_token	(
+		STRVIEW *	a_rest,
+		int		a_sep,
+		STRVIEW *	a_tok
+			)
+{
+const char	*l_cp;
+
+	if ( !a_rest->ptr )
+		return	STS$K_ERROR;
+
+	*a_tok = *a_rest;
+
+	if ( (l_cp = (const char *) memchr(a_rest->ptr, a_sep, a_rest->len)) )
+		{
+		a_tok->len = l_cp - a_rest->ptr;
+
+		a_rest->len -= a_tok->len + 1;
+		a_rest->ptr = l_cp + 1;
+		}
+	else	{
+		a_rest->ptr = NULL;				/* The last token has been extracted */
+		a_rest->len = 0;
+		}
+
+	return	STS$K_SUCCESS;
+}
+
+/* Retrieve a view of the substring with a given index, see __util$strelem() */
+inline static int	__util$sv_elem	(
+		STRVIEW		a_src,
+		int		a_sep,
+		int		a_idx,
+		STRVIEW *	a_dst
+			)
+{
+	for ( ; 1 & __util$sv_token(&a_src, a_sep, a_dst); a_idx-- )
+		if ( !a_idx )
+			return	STS$K_SUCCESS;
+
+	return	STS$K_ERROR;
+}
+
+/* Return a view without leading and trailing spaces or tabs (HT and VT, CR, LF), see __util$trim() */
+inline static STRVIEW	__util$sv_trim	(
+		STRVIEW		a_src
+			)
+{
+	for ( ; a_src.len && isspace((unsigned char) *a_src.ptr); a_src.ptr++, a_src.len-- );
+	for ( ; a_src.len && isspace((unsigned char) a_src.ptr[a_src.len - 1]); a_src.len-- );
+
+	return	a_src;
+}
+
+/* Return a view of the string up to the comment marker, see __util$uncomment() */
+inline static STRVIEW	__util$sv_uncomment	(
+		STRVIEW		a_src,
+		char		a_marker
+			)
+{
+const char	*l_cp;
+
+	if ( a_src.len && (l_cp = (const char *) memchr(a_src.ptr, a_marker, a_src.len)) )
+		a_src.len = l_cp - a_src.ptr;
+
+	return	a_src;
+}
+
+/*
+ *  DESCRIPTION: Copy the viewed string without all spaces or tabs (HT and VT, CR, LF),
+ *	see __util$collapse(), the output is null-terminated.
+ *
+ *  RETURNS:
+ *	a length of the data in the output buffer
+ */
+inline static int	__util$sv_collapse	(
+		STRVIEW		a_src,
+		char *		a_dst,
+		size_t		a_dstsz
+			)
+{
+char	*l_cp = a_dst;
+
+	if ( !a_dstsz )
+		return	0;
+
+	for ( ; a_src.len && ((size_t) (l_cp - a_dst) < (a_dstsz - 1)); a_src.ptr++, a_src.len-- )
+		if ( !isspace((unsigned char) *a_src.ptr) )
+			*(l_cp++) = *a_src.ptr;
+
+	*l_cp = '\0';
+
+	return	(int) (l_cp - a_dst);
+}
+
+/*
+ * Normalize a line in the single pass: cut at the comment marker (0 - no comments), trim, and optionally
+ * remove (COLLAPSE) or replace by the single space (SQUEEZE) inner spaces or tabs. The source is not need
+ * to be null-terminated; without the output buffer a view of the source is returned.
+ */
+#define	UTIL$M_LINE_COLLAPSE	0x01		/* Remove all spaces or tabs, see __util$collapse() */
+#define	UTIL$M_LINE_SQUEEZE	0x02		/* Replace runs of spaces or tabs by the single space */
+
+STRVIEW	__util$sv_normalize	(const char *src, size_t srclen, char marker, int flags, char *dst, size_t dstsz);
+
+/* Comparing two views: by length at first, see __util$cmpasc() */
+inline static int	__util$sv_cmp	(
+		const STRVIEW *	s1,
+		const STRVIEW *	s2
+			)
+{
+	if ( s1->len != s2->len )
+		return	(s1->len < s2->len) ? -1 : 1;
+
+	return	s1->len ? memcmp(s1->ptr, s2->ptr, s1->len) : 0;
+}
+
+/* Case insensitive comparing of two views, see __util$cmpasc_blind() */
+inline static int	__util$sv_cmp_blind	(
+		const STRVIEW *	s1,
+		const STRVIEW *	s2
+			)
+{
+	if ( s1->len != s2->len )
+		return	(s1->len < s2->len) ? -1 : 1;
+
+	return	__util$memcmp_blind(s1->ptr, s2->ptr, s1->len);
+}
+
+
+
+
+/*
+ * Arena: the strings and other small objects are allocated by bumping a pointer in the chained blocks,
+ * all of them are released at once by the __util$arena_reset() in O(1) (the blocks are kept to be reused)
+ * or by the __util$arena_free(). A counted string in the arena takes <1 + length + 1> octets instead of
+ * sizeof(ASC), it's read by the $ASC*() macros, but must not be copied or changed as the whole ASC.
+ */
+#define	UTIL$K_ARENA_BLKSZ	(16 * 1024)		/* A default size of the arena's block			*/
+#define	UTIL$K_ARENA_ALIGN	8			/* Alignment of the allocated areas			*/
+
+typedef	struct __util_arena_blk__	UTIL_ARENA_BLK;
+
+#pragma pack(push)
+#pragma pack(8)
+
+typedef	struct __util_arena__
+{
+	UTIL_ARENA_BLK	*head,				/* Chain of the blocks				*/
+			*cur;				/* A block is used by the allocation now	*/
+	char		*ptr,				/* Free space in the current block		*/
+			*end;
+	size_t		blksz;				/* A size of the new block, 0 - default		*/
+} UTIL_ARENA;
+
+#pragma pack(pop)
+
+#define	UTIL_ARENA_INIT	{NULL, NULL, NULL, NULL, 0}
+
+int	__util$arena_init	(UTIL_ARENA *arena, size_t blksz);
+void	*__util$arena_alloc	(UTIL_ARENA *arena, size_t sz);
+const ASC *__util$arena_asc	(UTIL_ARENA *arena, const char *src, size_t srclen);
+STRVIEW	__util$arena_sv		(UTIL_ARENA *arena, const char *src, size_t srclen);
+void	__util$arena_reset	(UTIL_ARENA *arena);
+void	__util$arena_free	(UTIL_ARENA *arena);
+
+
+
+#define	UTIL$K_DUMPHEX_BUFSZ	8192			/* A stack buffer for the small dumps			*/
+#define	UTIL$K_DUMPHEX_MAXBATCH	(4*1024*1024)		/* A maximum size of the single write() of the dump	*/
+
+/*
+ * FAO - Formatted ASCII Output: !U{B,W,L,Q}, !S{B,W,L,Q}, !X{B,W,L,Q}, !P, !A{D,Z,C}, !!
+ * A constant control string can be compiled once into the program to skip parsing
+ * at every call, __util$faoc() keeps the compiled programs in the cache by the control string address.
+ */
+typedef	struct __util_faopgm__	UTIL_FAOPGM;
+
+int	__util$fao		(void *fmt, void *buf, size_t bufsz, ...);
+int	__util$faoc		(const char *fmt, char *buf, size_t bufsz, ...);
+UTIL_FAOPGM *__util$fao_compile	(const char *fmt);
+int	__util$fao_exec		(const UTIL_FAOPGM *pgm, char *buf, size_t bufsz, ...);
+int	__util$vfao_exec	(const UTIL_FAOPGM *pgm, char *buf, size_t bufsz, va_list ap);
+
+/*
+ * VMS SYS$FAOL-like formatting: !Sx !Ux !Zx !Ox !Xx (x = B, W, L) !%S !%D !%T !AS !AZ !AC !AD !AF !n*c !/ !_ !^ !!,
+ * parameters are passed by the array of unsigned long, !%D, !%T take an address of struct timespec or NULL.
+ */
+#pragma pack(push)
+#pragma pack(8)
+typedef struct __util_dsc__ {
+	unsigned short	l;				/* A length of the string		*/
+	char		*a;				/* An address of the string		*/
+} UTIL_DSC;
+#pragma pack(pop)
+
+int	__util$faol		(const UTIL_DSC *ctlstr, int *outlen, UTIL_DSC *outbuf, unsigned long *prmlst);
+
+#ifndef	WIN32
+/*
+ * Scatter-gather FAO: the !AD, !AC, !AZ arguments and literals are referenced in place by the I/O vector,
+ * the numbers are formatted into the scratch buffer, UTIL$K_FAOV_NUMSZ octets is reserved for every one.
+ */
+#define	UTIL$K_FAOV_NUMSZ	32
+#define	UTIL$K_LOGFAO_IOVNR	64			/* A maximum number of segments of the __util$logfao() record	*/
+
+int	__util$faov		(const char *fmt, struct iovec *iov, int iovnr, char *scratch, size_t scratchsz, size_t *outlen, ...);
+int	__util$vfaov		(const char *fmt, struct iovec *iov, int iovnr, char *scratch, size_t scratchsz, size_t *outlen, va_list ap);
+unsigned __util$logfao		(const char *fac, unsigned sev, const char *fmt, ...);
+#endif
+
+#define	$DUMPHEX(s,l)	__util$dumphexl(__FUNCTION__, __LINE__ , s, l)
 void	__util$dumphex	(const char *__fi, unsigned __li, const void *src, unsigned short srclen);
+void	__util$dumphexl	(const char *__fi, unsigned __li, const void *src, size_t srclen);
+size_t	__util$faohexl	(const void *src, size_t srclen, size_t offset, char *out, size_t outsz, size_t *outlen);
 
 /*
 ** @RRL: Perform an addittion of two times with overflow control and handling.
@@ -1654,7 +2118,7 @@ typedef struct _opts	{
 		int	type;		/* Value type, see OPTS$K_* constants	*/
 	} OPTS;
 
-#define	OPTS_NULL { {0, 0}, NULL, 0, 0}
+#define	OPTS_NULL { {0, {0}}, NULL, 0, 0}
 
 int	__util$getparams	(int, char *[], const OPTS *);
 int	__util$readparams	(int, char *[], OPTS *);
@@ -1665,102 +2129,52 @@ int	__util$deflog		(const char *, const char *);
 int	__util$rewindlogfile	(size_t);
 int	__util$pattern_match	(char * str$, char * pattern$);
 
-char *	__util$strstr		(char *s1, size_t s1len, char *s2, size_t s2len);
-
-unsigned	__util$crc32c	(unsigned int crc, const void *buf, size_t buflen);
-
-/**
- * @brief __util$hex2bin - convert a hexdecimal string in binary representative.
- *		It's expected that output buffer have enough space to accept
- *		 <(source_length + 1) / 2> octets.
- *
- * @param a_srchex	-	An address of source data buffer to convert from
- * @param a_\dstbin	-	An address of the output buffer to accept converted octets
- * @param a_srchexlen	-	A length of the source data
- *
- * @return	-	A length of the data in the output buffer
- *
- */
-inline	static int __util$hex2bin
-		(
-	const void *	a_srchex,
-		void *	a_dstbin,
-	unsigned short  a_srchexlen
-		)
-{
-unsigned char	c, l = 0, h = 0, *__srchex = (unsigned char *) a_srchex, *__dstbin = (unsigned char *) a_dstbin;
-int	retlen = (a_srchexlen + 1) / 2, i;
-
-	/* We will converting from tail to head */
-	__srchex += (a_srchexlen - 1);
-	__dstbin += (retlen - 1);
-
-	for( i = (a_srchexlen / 2); i; i--, __dstbin--, __srchex--)
-		{
-		c = tolower(*__srchex);
-		l = ((c) <= '9') ? (c) - '0' : (c) - 'a' + 10;
-
-		__srchex--;
-
-		c = tolower(*__srchex);
-		h = ((c) <= '9') ? (c) - '0' : (c) - 'a' + 10;
+/* Compiled wildcard pattern: '*' - zero or more characters, '%' - any single character */
+typedef	struct __util_wild__	UTIL_WILD;
 
+UTIL_WILD *__util$wild_compile	(const char *pattern);
+int	__util$wild_match	(const UTIL_WILD *wild, const char *str, size_t strlen);
+void	__util$wild_free	(UTIL_WILD *wild);
 
-		*__dstbin    = c = l | (h << 4);
-		}
+char *	__util$strstr		(char *s1, size_t s1len, char *s2, size_t s2len);
 
-	if ( a_srchexlen % 2)
-		{
-		c = tolower(*__srchex);
-		l = ((c) <= '9') ? (c) - '0' : (c) - 'a' + 10;
+unsigned	__util$crc32c	(unsigned int crc, const void *buf, size_t buflen);
 
-		*__dstbin    = c = l;
-		}
+size_t	__util$bin2hex		(const void *srcbin, void *dsthex, size_t srcbinlen);
+size_t	__util$hex2bin		(const void *srchex, void *dstbin, size_t srchexlen);
+int	__util$hex2bin_ex	(const void *srchex, size_t srchexlen, void *dstbin, size_t *dstbinlen, size_t *errpos);
 
+/* Base64 and Base64url (RFC 4648) encoding and decoding, see __util$b64_init() for the chunked data */
+#define	UTIL$M_B64_URL		0x01			/* Base64url alphabet: '-' and '_' instead of '+' and '/'	*/
+#define	UTIL$M_B64_NOPAD	0x02			/* Don't put '=' at end, the decoder doesn't accept it		*/
 
+#define	$B64ENCLEN(n)	((((size_t) (n) + 2) / 3) * 4)	/* A length of the encoded string (without NIL)		*/
+#define	$B64DECLEN(n)	((((size_t) (n) + 3) / 4) * 3)	/* A maximum size of the decoded data			*/
 
-	return	retlen;
-}
+#pragma pack(push)
+#pragma pack(8)
 
-/**
- * @brief __util$bin2hex - convert a sequence of bytes from binary from
- *		to a hexadecimal string. It's expected that output buffer have
- *		enough space to accept <source_length * 2> characters.
- *
- * @param a_srcbin	-	An address of source data buffer to convert from
- * @param a_dsthex	-	An address of the output buffer to accept hex-string
- * @param a_srcbinlen	-	A length of the source data
- *
- * @return	-	A length of the data in the output buffer
- *
- */
-inline	static int __util$bin2hex
-		(
-	const void *	a_srcbin,
-		void *	a_dsthex,
-	unsigned short  a_srcbinlen
-		)
+typedef	struct __util_b64ctx__
 {
-unsigned char    l = 0, h = 0, *__srcbin = (unsigned char *) a_srcbin, *__dsthex = (unsigned char *) a_dsthex; ;
-int	retlen = a_srcbinlen * 2;
-
-	__dsthex[retlen] = '\0';
-
-	for( ; a_srcbinlen; a_srcbinlen--, __dsthex += 2, __srcbin++)
-		{
-		h       = (*__srcbin) >> 4;
-		h	&= 0x0F;
-		l       = (*__srcbin) & 0x0F;
-
-		*__dsthex    = (h < 10) ? h + '0' : h + 'a' - 10;
-		*(__dsthex+1)= (l < 10) ? l + '0' : l + 'a' - 10;
-		}
-
+	unsigned char	carry[4];			/* An incomplete group of the previous chunk	*/
+	unsigned	carrynr;
+	int		flags,				/* UTIL$M_B64_*					*/
+			done;				/* Decoder: the padding has been seen		*/
+	size_t		pos,				/* Decoder: a number of decoded characters	*/
+			errpos;				/* Decoder: an offset of the invalid character	*/
+} UTIL_B64CTX;
 
-	return	retlen;
-}
+#pragma pack(pop)
 
+size_t	__util$b64enc		(const void *srcbin, void *dstb64, size_t srcbinlen, int flags);
+size_t	__util$b64dec		(const void *srcb64, void *dstbin, size_t srcb64len, int flags);
+int	__util$b64dec_ex	(const void *srcb64, size_t srcb64len, void *dstbin, size_t *dstbinlen, size_t *errpos, int flags);
 
+void	__util$b64_init		(UTIL_B64CTX *ctx, int flags);
+size_t	__util$b64enc_update	(UTIL_B64CTX *ctx, const void *src, size_t srclen, void *dst);
+size_t	__util$b64enc_final	(UTIL_B64CTX *ctx, void *dst);
+int	__util$b64dec_update	(UTIL_B64CTX *ctx, const void *src, size_t srclen, void *dst, size_t *dstlen);
+int	__util$b64dec_final	(UTIL_B64CTX *ctx, void *dst, size_t *dstlen);
 
 /**
  * @brief __util$bin2dec - convert a sequence of bytes from binary from
@@ -1782,7 +2196,7 @@ int	retlen = a_srcbinlen * 2;
 
 
 
-#define	$BIN2HEX(s,d,l)	__util$bin2hex((char*) s, (char*) d, (unsigned short) l)
+#define	$BIN2HEX(s,d,l)	__util$bin2hex((char*) s, (char*) d, (size_t) l)
 
 /*
  *
@@ -1976,7 +2390,8 @@ int	srclen, status = STS$K_ERROR;
  *
  *  RETURNS:
  *	SS$-NORMAL	- keywords has been found, result in the <kwd>
- *	condition code
+ *	STS$K_ERROR	- no matching keyword
+ *	STS$K_FATAL	- ambiguous abbreviation
  *
  */
 #define	UTIL$K_LOOKUP_NCASE	(1 << 0)
@@ -1991,6 +2406,17 @@ typedef	struct _kwdent
 		};
 } KWDENT;
 
+/* Compare keywords according to the UTIL$K_LOOKUP_NCASE flag, see __util$lookup_key() */
+inline	static	int	__util$lookup_cmp	(
+		const	void	*s1,
+		const	void	*s2,
+			size_t	n,
+			int	flags
+			)
+{
+	return	(flags & UTIL$K_LOOKUP_NCASE) ? __util$memcmp_blind(s1, s2, n) : memcmp(s1, s2, n);
+}
+
 inline	static	int	__util$lookup_key	(
 		const	char	*a_src,
 			int	a_srclen,
@@ -2003,78 +2429,113 @@ inline	static	int	__util$lookup_key	(
 			int	a_flags
 			)
 {
-int	l_status = STS$K_ERROR, l_len;
-KWDENT *	l_ktbl = a_ktbl;
+KWDENT	*l_ktbl, *l_abbr = NULL;
+int	l_abbrnr = 0;
 
-	for ( l_ktbl = a_ktbl, l_len = 0; a_ktblsz; a_ktblsz--, l_ktbl++)
+	for ( l_ktbl = a_ktbl; a_ktblsz; a_ktblsz--, l_ktbl++)
 		{
 		/* Exact comparing or abbreviated ? */
-		if ( !(a_flags & UTIL$K_LOOKUP_ABBREV) )
-			if ( a_srclen != l_ktbl->kwd.len )
-				continue;
-
-		/*
-		* We performs a comparing only in case when a compare length is
-		* more then at previous step.
-		*/
-		if ( l_len <= $MIN(a_srclen, l_ktbl->kwd.len) )
-			l_len = $MIN(a_srclen, l_ktbl->kwd.len);
-		else	continue;
-
+		if ( (a_srclen != l_ktbl->kwd.len) && (!(a_flags & UTIL$K_LOOKUP_ABBREV) || (a_srclen > l_ktbl->kwd.len)) )
+			continue;
 
-		/* Comparing ... */
-		l_status = (a_flags & UTIL$K_LOOKUP_NCASE) ?
-#ifdef	WIN32
+		if ( __util$lookup_cmp(a_src, l_ktbl->kwd.sts, a_srclen, a_flags) )
+			continue;
 
-			_strnicmp
-#else
-			strncasecmp
-#endif
-			(a_src, l_ktbl->kwd.sts, l_len) : memcmp(a_src, l_ktbl->kwd.sts, l_len);
+		/* Exact matching is preferred over abbreviation */
+		if ( a_srclen == l_ktbl->kwd.len )
+			{
+			*a_kwd = l_ktbl;
+			return	STS$K_SUCCESS;
+			}
 
-		if ( !l_status &&  !(a_flags & UTIL$K_LOOKUP_ABBREV) )
-			break;
+		/* Count different keywords are matched to the abbreviation */
+		if ( !l_abbr )
+			l_abbr = l_ktbl, l_abbrnr = 1;
+		else if ( (l_abbr->kwd.len != l_ktbl->kwd.len) || __util$lookup_cmp(l_abbr->kwd.sts, l_ktbl->kwd.sts, l_ktbl->kwd.len, a_flags) )
+			l_abbrnr++;
 		}
 
 	/* No matching ... */
-	if ( l_status )
+	if ( !l_abbrnr )
 		return	STS$K_ERROR;
 
-	*a_kwd = l_ktbl;
+	/* Ambiguous abbreviation ... */
+	if ( l_abbrnr > 1 )
+		return	STS$K_FATAL;
+
+	*a_kwd = l_abbr;
 
 	return	STS$K_SUCCESS;
 }
 
+/* Translate a viewed keyword string, see __util$lookup_key() */
+inline	static	int	__util$sv_lookup_key	(
+		const STRVIEW	*a_src,
+		KWDENT *	a_ktbl,
+			int	a_ktblsz,
+		KWDENT	**	a_kwd,
+			int	a_flags
+			)
+{
+	return	(a_src->len > INT_MAX) ? STS$K_ERROR : __util$lookup_key(a_src->ptr, (int) a_src->len, a_ktbl, a_ktblsz, a_kwd, a_flags);
+}
 
+/*
+ * Compiled keywords table: exact and unique abbreviation lookup by the single walk over the token
+ * with the same results as the __util$lookup_key().
+ */
+typedef	struct __util_kwdidx__	UTIL_KWDIDX;
 
-/**
- * @brief __UTIL$UUID2STR - convert UUID from binary form to the human readable text string.
- *		implied zero byte (NIL, '\0') at end of the string.
- *
- * @param uuid: UUID to be converted
- * @param buf:	a buffer to accept text string
- * @param bufsz:a size of the output buffer
- *
- * @return -	length of the data in the output buffer.
+UTIL_KWDIDX *__util$kwdidx_compile	(KWDENT *ktbl, int ktblsz, int flags);
+int	__util$kwdidx_lookup	(const UTIL_KWDIDX *idx, const char *src, int srclen, KWDENT **kwd, int flags);
+void	__util$kwdidx_free	(UTIL_KWDIDX *idx);
+
+
+/*
+ * Multi-pattern search: a set of the patterns is compiled into the Aho-Corasick DFA,
+ * all matches are found by the single pass over the input. A pattern id is an index
+ * of the pattern in the array has been used to compile the matcher.
  */
-inline static int	__util$uuid2str	(
-		void *	uuid,
-		char *	buf,
-		int	bufsz
-			)
-{
-unsigned char	tmp [256], *puuid = (unsigned char *) uuid;
-int	len;
+#define	UTIL$M_MPM_NOCASE	(1 << 0)		/* Case insensitive matching			*/
 
-	len = snprintf( (char *) tmp, sizeof(tmp) - 1, "%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x",
-		puuid[0], puuid[1], puuid[2], puuid[3], puuid[4], puuid[5], puuid[6], puuid[7],
-		puuid[8], puuid[9], puuid[10], puuid[11], puuid[12], puuid[13], puuid[14], puuid[15]);
+typedef	struct __util_mpm__	UTIL_MPM;
+typedef	int	(*UTIL_MPM_CB)	(void *arg, int id, size_t off, size_t len);
 
-	memcpy(buf, tmp, len = $MIN(bufsz, len));
-	buf[len] = '\0';
+UTIL_MPM *__util$mpm_compile	(const ASC *pats, int patnr, int flags);
+UTIL_MPM *__util$mpm_compile_kwd(const KWDENT *kwds, int kwdnr, int flags);
+int	__util$mpm_scan		(const UTIL_MPM *mpm, const void *buf, size_t bufsz, UTIL_MPM_CB cb, void *arg);
+void	__util$mpm_free		(UTIL_MPM *mpm);
 
-	return	len;
-}
+/*
+ * A set of the wildcard patterns (see __util$pattern_match()) is matched by the single scan of the string,
+ * a pattern id is an index of the pattern in the array has been used to compile the set.
+ */
+#define	UTIL$K_WILDSET_MAXTHR	64			/* A maximum number of threads of the __util$wildset_batch()	*/
+
+typedef	struct __util_wildset__	UTIL_WILDSET;
+
+UTIL_WILDSET *__util$wildset_compile	(const char **patterns, int patnr);
+int	__util$wildset_match	(const UTIL_WILDSET *set, const char *str, size_t strlen, int *ids, int *idsnr);
+int	__util$wildset_batch	(const UTIL_WILDSET *set, const ASC *strs, int strnr, int *ids, int thrnr);
+void	__util$wildset_free	(UTIL_WILDSET *set);
+
+
+
+/*
+ * UUID: 16 octets in the network order, see RFC 9562. The version 4 and 7 generators use a per-thread
+ * generator (no locks), the text form is "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx".
+ */
+#define	UTIL$K_UUIDSZ		16			/* A size of the binary UUID				*/
+#define	UTIL$K_UUIDSTRLEN	36			/* A length of the text form (without NIL)		*/
+
+typedef	unsigned char	UTIL_UUID[UTIL$K_UUIDSZ];
+
+int	__util$uuid_v4		(void *uuid);
+int	__util$uuid_v7		(void *uuid);
+int	__util$uuid2str		(const void *uuid, char *buf, int bufsz);
+int	__util$uuid_parse	(const char *src, size_t srclen, void *uuid);
+int	__util$uuid_cmp		(const void *uuid1, const void *uuid2);
+unsigned long long __util$uuid_hash	(const void *uuid);
 
 
 
@@ -2127,39 +2588,11 @@ char *	_dst = (char *) dst;
  * @param ctx	- an internal context , can be NULL if it is not used
  * @return
  */
-static inline	int	__util$strxor	(
-		void	*	key,
-		int		keysz,
-		void	*	src,
-		int		srcsz,
-		void	*	dst,
-		int		dstsz,
-		int	*	ctx
-			)
-{
-unsigned char* kp, * sp, *dp, * ep;
-int	sz = (srcsz > dstsz) ? dstsz : srcsz;
-
-	if (ctx && (*ctx > 0) && (*ctx > keysz))		/* Check that <ctx> is in key's area */
-		return	STS$K_ERROR;
-
-	kp = (ctx && *ctx > 0) ? ((unsigned char *) key + (*ctx)) : (unsigned char *)key;	/* Set key's pointer to initial position */
-	ep = (unsigned char *) key + keysz;			/* Compute end of key address for future use */
-
-	for ( sp = (unsigned char *)src, dp = (unsigned char *)dst; sz; sz--, dp++, sp++, kp++ )
-		{
-		if ( kp >= ep  )				/* Check and reset a pointer to byte in the key buffer */
-			kp = (unsigned char *)key;
-
-		(*dp) = (*sp) ^ (*kp);				/* XOR single octet */
-		}
+int	__util$strxor	(void *key, int keysz, void *src, int srcsz, void *dst, int dstsz, int *ctx);
 
+#define	UTIL$K_STRXOR_MAXTHR	64			/* A maximum number of threads of the __util$strxor_mt()	*/
 
-	if ( ctx )						/* Do we need to keep context between calls */
-		*ctx = (int) (kp - ((unsigned char *) key));	/* Store a current key's position */
-
-	return	STS$K_SUCCESS;
-}
+int	__util$strxor_mt(void *key, int keysz, void *src, int srcsz, void *dst, int dstsz, int *ctx, int thrnr);
 
 
 